@@ -4,78 +4,12 @@
 #include <CQGLControl.h>
 #include <CGLTexture.h>
 #include <CQWinWidget.h>
-#include <CMathRand.h>
 #include <CMatrix2D.h>
-#include <CStrParse.h>
-#include <CUndo.h>
 #include <QPainter>
 #include <QKeyEvent>
+#include <QSlider>
 #include <QTimer>
-
-class CQRubikUndoMoveData : public CUndoData {
- public:
-  CQRubikUndoMoveData(CQRubik *rubik, uint side_num, char dir, uint pos) :
-   rubik_(rubik), side_num_(side_num), dir_(dir), pos_(pos) {
-  }
-
-  bool exec() override {
-    if (getState() == UNDO_STATE) {
-      if      (dir_ == 'U') rubik_->moveSideDown (side_num_, pos_);
-      else if (dir_ == 'D') rubik_->moveSideUp   (side_num_, pos_);
-      else if (dir_ == 'L') rubik_->moveSideRight(side_num_, pos_);
-      else if (dir_ == 'R') rubik_->moveSideLeft (side_num_, pos_);
-    }
-    else {
-      if      (dir_ == 'U') rubik_->moveSideUp   (side_num_, pos_);
-      else if (dir_ == 'D') rubik_->moveSideDown (side_num_, pos_);
-      else if (dir_ == 'L') rubik_->moveSideLeft (side_num_, pos_);
-      else if (dir_ == 'R') rubik_->moveSideRight(side_num_, pos_);
-    }
-
-    rubik_->waitAnimate();
-
-    return true;
-  }
-
- private:
-  CQRubik *rubik_    { nullptr };
-  uint     side_num_ { 0 };
-  char     dir_      { '\0' };
-  uint     pos_      { 0 };
-};
-
-//----
-
-class CQRubikUndoRotateData : public CUndoData {
- public:
-  CQRubikUndoRotateData(CQRubik *rubik, uint side_num, bool clockwise) :
-   rubik_(rubik), side_num_(side_num), clockwise_(clockwise) {
-  }
-
-  bool exec() override {
-    if (getState() == UNDO_STATE) rubik_->rotateSide(side_num_, ! clockwise_);
-    else                          rubik_->rotateSide(side_num_, clockwise_);
-
-    rubik_->waitAnimate();
-
-    return true;
-  }
-
-  void print() {
-    char c;
-
-    CQRubik::encodeSideChar(side_num_, c);
-
-    std::cerr << c << (clockwise_ ? " " : "' ") << std::endl;
-  }
-
- private:
-  CQRubik *rubik_     { nullptr };
-  uint     side_num_  { 0 };
-  bool     clockwise_ { false };
-};
-
-//---
+#include <cstring>
 
 int
 main(int argc, char **argv)
@@ -109,7 +43,31 @@ CQRubik(QWidget *parent) :
   w2_->setChild(twod_);
   w3_->setChild(threed_);
 
-  undo_ = new CUndo;
+  // undo history scrubber
+  history_ = new QSlider(Qt::Horizontal, this);
+
+  history_->setFocusPolicy(Qt::NoFocus);
+
+  connect(history_, SIGNAL(valueChanged(int)), this, SLOT(historySlot(int)));
+
+  // animation frames
+  animateTimer_ = new QTimer(this);
+
+  animateTimer_->setInterval(16);
+  animateTimer_->setTimerType(Qt::PreciseTimer);
+
+  animateTime_.start();
+
+  connect(animateTimer_, SIGNAL(timeout()), this, SLOT(animateTimerSlot()));
+
+  model_.setListener(this);
+
+  solveThread_ = new CQRubikSolveThread(this);
+
+  connect(solveThread_, SIGNAL(progressChanged(const QString &)),
+          this, SLOT(solveProgressSlot(const QString &)));
+  connect(solveThread_, SIGNAL(solveFinished(bool)),
+          this, SLOT(solveFinishedSlot(bool)));
 
   reset();
 
@@ -129,2178 +87,319 @@ CQRubik(QWidget *parent) :
   twod_->setFocus();
 }
 
-void
 CQRubik::
-reset()
+~CQRubik()
 {
-  for (uint i = 0; i < CUBE_SIDES; ++i) {
-    CRubikSide &side = sides_[i];
-
-    for (uint k = 0, id = 0; k < SIDE_COLS; ++k)
-      for (uint j = 0; j < SIDE_ROWS; ++j, ++id)
-        side.pieces[k][j] = CRubikPiece(i, id);
-  }
-
-  // Left Face
-  sides_[0].name = "L";
-
-  sides_[0].side_l = CRubikSideConnect(5,   0);
-  sides_[0].side_r = CRubikSideConnect(2,   0);
-  sides_[0].side_d = CRubikSideConnect(3,  90);
-  sides_[0].side_u = CRubikSideConnect(1, -90);
-
-  // Up Face
-  sides_[1].name = "U";
+  cancelSolve();
 
-  sides_[1].side_l = CRubikSideConnect(0,  90);
-  sides_[1].side_r = CRubikSideConnect(4, -90);
-  sides_[1].side_d = CRubikSideConnect(2,   0);
-  sides_[1].side_u = CRubikSideConnect(5, 180);
-
-  // Front Face
-  sides_[2].name = "F";
-
-  sides_[2].side_l = CRubikSideConnect(0,   0);
-  sides_[2].side_r = CRubikSideConnect(4,   0);
-  sides_[2].side_d = CRubikSideConnect(3,   0);
-  sides_[2].side_u = CRubikSideConnect(1,   0);
-
-  // Down Face
-  sides_[3].name = "D";
-
-  sides_[3].side_l = CRubikSideConnect(0, -90);
-  sides_[3].side_r = CRubikSideConnect(4,  90);
-  sides_[3].side_d = CRubikSideConnect(5, 180);
-  sides_[3].side_u = CRubikSideConnect(2,   0);
+  solveThread_->wait();
+}
 
-  // Right Face
-  sides_[4].name = "R";
+void
+CQRubik::
+reset()
+{
+  finishAnimation();
 
-  sides_[4].side_l = CRubikSideConnect(2,   0);
-  sides_[4].side_r = CRubikSideConnect(5,   0);
-  sides_[4].side_d = CRubikSideConnect(3, -90);
-  sides_[4].side_u = CRubikSideConnect(1,  90);
+  model_.reset();
 
-  // Back Face
-  sides_[5].name = "B";
+  clearUndo();
+}
 
-  sides_[5].side_l = CRubikSideConnect(4,   0);
-  sides_[5].side_r = CRubikSideConnect(0,   0);
-  sides_[5].side_d = CRubikSideConnect(3, 180);
-  sides_[5].side_u = CRubikSideConnect(1, 180);
+void
+CQRubik::
+randomize()
+{
+  finishAnimation();
 
-  //-----
+  model_.randomize();
 
-  undo_->clear();
+  clearUndo();
 }
 
 void
 CQRubik::
-randomize()
+setPieceColor(uint color)
 {
-  static const char *names[] =
-    { "Move Up", "Move Down", "Move Left", "Move Right",
-     "Rotate Clockwise", "Rotate Anti-Clockwise" };
-
-  bool animate;
-
-  std::swap(animate_, animate);
-
-  uint num = 30;
-
-  for (uint i = 0; i < num; ++i) {
-    int side_num = CMathRand::randInRange(0, 5);
-    int op       = CMathRand::randInRange(0, 5);
-    int pos      = CMathRand::randInRange(0, 2);
-
-    if      (op == 0) // move up
-      moveSideUp   (side_num, pos);
-    else if (op == 1) // move down
-      moveSideDown (side_num, pos);
-    else if (op == 2) // move left
-      moveSideLeft (side_num, pos);
-    else if (op == 3) // move right
-      moveSideRight(side_num, pos);
-    else if (op == 4)
-      rotateSide(side_num, true);
-    else
-      rotateSide(side_num, false);
-
-    if (! validate()) {
-      std::cerr << "Invalid: " << names[op] << ": " << side_num << ":" << pos << std::endl;
-      break;
-    }
-  }
+  if (isSolving())
+    return;
 
-  std::swap(animate_, animate);
+  finishAnimation();
 
-  undo_->clear();
+  // edit is not a move so can't be undone
+  if (model_.setPieceColor(ind_.side_num, ind_.side_col, ind_.side_row, color))
+    clearUndo();
 }
 
 bool
 CQRubik::
 solve()
 {
-  undo_->clear();
-
-  bool animate = false;
-
-  std::swap(animate_, animate);
-
-  bool rc = solve1();
+  if (isSolving())
+    return false;
 
-  undo_->undoAll();
+  finishAnimation();
 
-  animate = true;
+  // solve a copy of the state then play the moves from the current state
+  uint8_t facelets[CRubikMove::NUM_FACELETS];
 
-  std::swap(animate_, animate);
+  model_.getFacelets(facelets);
 
-  undo_->redoAll();
+  bool rc = solveThread_->solve(facelets, model_.getSolveMethod(),
+                                model_.getOptimalDepth(), solveMoves_);
 
-  std::swap(animate_, animate);
+  if (rc)
+    replayMoves(solveMoves_);
 
   return rc;
 }
 
-bool
+void
 CQRubik::
-solve1()
+startSolve()
 {
-  if (! solveTopInd4()) return false;
-
-  if (! solveTopInd1()) return false;
-  if (! solveTopInd3()) return false;
-  if (! solveTopInd5()) return false;
-  if (! solveTopInd7()) return false;
-
-  // Top Corners
-  if (! solveTopInd0()) return false;
-  if (! solveTopInd2()) return false;
-  if (! solveTopInd6()) return false;
-  if (! solveTopInd8()) return false;
-
-  // Middle Layer
-  if (! solveMidInd4()) return false;
-
-  if (! solveMidLeftInd3()) return false;
-  if (! solveMidLeftInd5()) return false;
-
-  if (! solveMidRightInd3()) return false;
-  if (! solveMidRightInd5()) return false;
+  if (isSolving()) return;
 
-  // Last Layer
-  moveSidesLeft(); moveSidesLeft();
+  // edited stickers may not make a solvable cube
+  const CRubikValidity &validity = model_.getValidity();
 
-  if (! solveBottomCross()) return false;
+  if (! validity.isValid()) {
+    setMessage(QString("Invalid (%1)").arg(validity.reason()));
+    return;
+  }
 
-  if (! solveBottomCornerOrder()) return false;
+  finishAnimation();
 
-  if (! solveBottomCornerOrient()) return false;
+  uint8_t facelets[CRubikMove::NUM_FACELETS];
 
-  if (! solveBottomMiddles()) return false;
+  model_.getFacelets(facelets);
 
-  // Restore Original Top
-  moveSidesLeft(); moveSidesLeft();
+  testing_ = false;
 
-  return true;
+  solveThread_->startSolve(facelets, model_.getSolveMethod(), model_.getOptimalDepth());
 }
 
-bool
+void
 CQRubik::
-solveTopInd4()
+startTest(uint n)
 {
-  // Green center to top
-  CRubikPieceInd ind = findPiece(2, 4);
-
-  uint side_num = ind.side_num;
-
-  if (side_num == 2) return true;
-
-  if (getUndoGroup()) undo_->startGroup();
+  if (isSolving()) return;
 
-  if      (side_num == 0) moveSideRight(side_num, 1); // execute("mFMR");
-  else if (side_num == 1) moveSideDown (side_num, 1);
-  else if (side_num == 3) moveSideUp   (side_num, 1);
-  else if (side_num == 4) moveSideLeft (side_num, 1);
-  else if (side_num == 5) moveSideLeft2(side_num, 1);
+  testing_ = true;
 
-  if (getUndoGroup()) undo_->endGroup();
-
-  ind = findPiece(2, 4);
-
-  if (! ind.assertInd("top 4", 2, 1, 1)) return false;
+  solveThread_->startTest(n, model_.getSolveMethod(), model_.getOptimalDepth());
+}
 
-  return true;
+void
+CQRubik::
+cancelSolve()
+{
+  if (isSolving())
+    solveThread_->cancel();
 }
 
 bool
 CQRubik::
-solveTopInd1()
+isSolving() const
 {
-  // Green Cross on top (piece numbers 1L 3T 5B 7R)
-  CRubikPieceInd ind = findPiece(2, 1);
-
-  uint side_num = ind.side_num;
-  uint side_col = ind.side_col;
-  uint side_row = ind.side_row;
+  return solveThread_->isRunning();
+}
 
-  if (side_num == 2 && side_col == 0 && side_row == 1) return true;
+void
+CQRubik::
+solveProgressSlot(const QString &msg)
+{
+  setMessage(msg);
+}
 
-  if (getUndoGroup()) undo_->startGroup();
+void
+CQRubik::
+solveFinishedSlot(bool rc)
+{
+  if (solveThread_->isCancelled()) {
+    setMessage("Cancelled");
+    return;
+  }
 
-  if (side_num != 2) {
-    if      (side_col == 0) { }
-    else if (side_col == 2) rotateSide2(side_num);
-    else if (side_row == 0) rotateSide (side_num, true );
-    else if (side_row == 2) rotateSide (side_num, false);
+  if (testing_) {
+    setMessage(rc ? "Test passed" : "Test failed");
+    return;
+  }
 
-    if      (side_num == 0) {
-      moveSideUp  (side_num, 0); moveSideLeft (2, 1);
-      moveSideDown(side_num, 0); moveSideRight(2, 1);
-    }
-    else if (side_num == 1) {
-      moveSideDown(side_num, 0);
-    }
-    else if (side_num == 3) {
-      moveSideUp  (side_num, 0);
-    }
-    else if (side_num == 4) {
-      rotateSide2(side_num);
-      moveSideUp (side_num, 2); moveSideLeft (2, 1);
-      moveSideUp (side_num, 2); moveSideRight(2, 1);
-    }
-    else if (side_num == 5) {
-      rotateSide2(side_num);
-      moveSideUp(side_num, 2);
-      moveSideUp(side_num, 2);
-    }
+  if (! rc) {
+    setMessage("No solution");
+    return;
   }
-  else {
-    if      (side_col == 0) { }
-    else if (side_col == 2) rotateSide2(side_num);
-    else if (side_row == 0) rotateSide (side_num, true );
-    else if (side_row == 2) rotateSide (side_num, false);
+
+  // discard if cube was moved while solving (compare state after queued moves)
+  if (memcmp(undo_.state(), solveThread_->facelets(), CRubikMove::NUM_FACELETS) != 0) {
+    setMessage("Cube changed while solving");
+    return;
   }
 
-  if (getUndoGroup()) undo_->endGroup();
+  solveMoves_ = solveThread_->moves();
 
-  ind = findPiece(2, 4); if (! ind.assertInd("top 4", 2, 1, 1)) return false;
-  ind = findPiece(2, 1); if (! ind.assertInd("top 1", 2, 0, 1)) return false;
+  setMessage(QString("Solved in %1 moves").arg(uint(solveMoves_.size())));
 
-  return true;
+  replayMoves(solveMoves_);
+
+  getTwoD()->update(); getThreeD()->update();
 }
 
-bool
+// queue moves to be animated from the current state (they are added to the undo log
+// now as a single group)
+void
 CQRubik::
-solveTopInd3()
+replayMoves(const std::vector<uint> &moves)
 {
-  CRubikPieceInd ind = findPiece(2, 3);
-
-  uint side_num = ind.side_num;
-  uint side_col = ind.side_col;
-  uint side_row = ind.side_row;
-
-  if (side_num == 2 && side_col == 1 && side_row == 0) return true;
+  if (getUndoGroup()) undo_.startGroup();
 
-  if (getUndoGroup()) undo_->startGroup();
-
-  if      (side_num != 2 && side_num != 0) {
-    if      (side_row == 0) { }
-    else if (side_row == 2) rotateSide2(side_num);
-    else if (side_col == 0) rotateSide (side_num, false);
-    else if (side_col == 2) rotateSide (side_num, true );
-
-    if      (side_num == 0)
-      moveSideRight(side_num, 0);
-    else if (side_num == 1) {
-      moveSideLeft (1, 0); moveSideUp  (2, 1);
-      moveSideRight(1, 0); moveSideDown(2, 1);
-    }
-    else if (side_num == 3) {
-      rotateSide(3, false); rotateSide(2, false);
-      moveSideUp(3, 2); rotateSide(2, true);
-    }
-    else if (side_num == 4)
-      moveSideLeft (side_num, 0);
-    else if (side_num == 5)
-      moveSideLeft2(side_num, 0);
-  }
-  else if (side_num == 0) {
-    if      (side_row == 0)
-      moveSideRight(0, 0);
-    else if (side_row == 2) {
-      rotateSide2(2); moveSideRight(0, 2); rotateSide2(2);
-    }
-    else if (side_col == 0) {
-      moveSideUp(2, 1); moveSideUp(0, 0); moveSideDown(2, 1);
-    }
-    else if (side_col == 2) { // not possible
-    }
-  }
-  else if (side_num == 2) {
-    if      (side_row == 0) { }
-    else if (side_row == 2) {
-      moveSideDown(2, 1); moveSideLeft (3, 2); moveSideUp(2, 1); rotateSide2(2);
-      moveSideDown(2, 1); moveSideRight(3, 2); moveSideUp(2, 1); rotateSide2(2);
-    }
-    else if (side_col == 0) { }
-    else if (side_col == 2) {
-      moveSideRight(2, 1); moveSideUp(2, 1);
-      moveSideUp(4, 2);
-      moveSideDown(2, 1); moveSideLeft(2, 1);
-    }
-  }
+  for (const auto &move : moves)
+    undo_.addMove(move);
 
-  if (getUndoGroup()) undo_->endGroup();
+  if (getUndoGroup()) undo_.endGroup();
 
-  ind = findPiece(2, 4); if (! ind.assertInd("top 4", 2, 1, 1)) return false;
-  ind = findPiece(2, 1); if (! ind.assertInd("top 1", 2, 0, 1)) return false;
-  ind = findPiece(2, 3); if (! ind.assertInd("top 3", 2, 1, 0)) return false;
+  updateHistory();
 
-  return true;
+  for (const auto &move : moves)
+    queueMove(move);
 }
 
 bool
 CQRubik::
-solveTopInd5()
+undo()
 {
-  CRubikPieceInd ind = findPiece(2, 5);
-
-  uint side_num = ind.side_num;
-  uint side_col = ind.side_col;
-  uint side_row = ind.side_row;
-
-  if (side_num == 2 && side_col == 1 && side_row == 2) return true;
-
-  if (getUndoGroup()) undo_->startGroup();
+  std::vector<uint> moves;
 
-  if (side_num != 2 && side_num != 0 && side_num != 1) {
-    if      (side_row == 2) { }
-    else if (side_row == 0) rotateSide2(side_num);
-    else if (side_col == 2) rotateSide (side_num, false);
-    else if (side_col == 0) rotateSide (side_num, true );
-
-    if      (side_num == 0)
-      moveSideRight(side_num, 2);
-    else if (side_num == 3) {
-      moveSideRight(3, 2); moveSideDown(3, 1);
-      moveSideLeft (3, 2); moveSideUp  (3, 1);
-    }
-    else if (side_num == 4)
-      moveSideLeft (side_num, 2);
-    else if (side_num == 5)
-      moveSideLeft2(side_num, 2);
-  }
-  else if (side_num == 2) {
-    if      (side_col == 0) { // not possible
-    }
-    else if (side_col == 2) {
-      moveSideDown(2, 2); rotateSide(2, true); moveSideUp(2, 2); rotateSide(2, false);
-    }
-    else if (side_row == 0) { // not possible
-    }
-    else if (side_row == 2) { // already done
-    }
-  }
-  else if (side_num == 0) {
-    if      (side_row == 0) {
-      rotateSide2(2); moveSideRight(0, 0); rotateSide2(2);
-    }
-    else if (side_row == 2)
-      moveSideRight(0, 2);
-    else if (side_col == 0) {
-      rotateSide(2, false); rotateSide(0, true); rotateSide(2, true); moveSideRight(0, 2);
-    }
-    else if (side_col == 2) {
-      rotateSide(2, true); moveSideRight(0, 0); rotateSide(2, false);
-    }
-  }
-  else if (side_num == 1) {
-    if      (side_row == 0) {
-      rotateSide(2, true);
-      moveSideRight(2, 1); moveSideRight(1, 0); moveSideLeft(2, 1);
-      rotateSide(2, false);
-    }
-    else if (side_row == 2) { // not possible
-    }
-    else if (side_col == 0) {
-      rotateSide(2, false); moveSideDown(1, 0); rotateSide(2, true);
-    }
-    else if (side_col == 2) {
-      rotateSide(2, true); moveSideDown(1, 2); rotateSide(2, false);
-    }
-  }
+  if (! undo_.undo(moves))
+    return false;
 
-  if (getUndoGroup()) undo_->endGroup();
+  applyUndoMoves(moves);
 
-  ind = findPiece(2, 4); if (! ind.assertInd("top 4", 2, 1, 1)) return false;
-  ind = findPiece(2, 1); if (! ind.assertInd("top 1", 2, 0, 1)) return false;
-  ind = findPiece(2, 3); if (! ind.assertInd("top 3", 2, 1, 0)) return false;
-  ind = findPiece(2, 5); if (! ind.assertInd("top 5", 2, 1, 2)) return false;
+  updateHistory();
 
   return true;
 }
 
 bool
 CQRubik::
-solveTopInd7()
+redo()
 {
-  CRubikPieceInd ind = findPiece(2, 7);
-
-  uint side_num = ind.side_num;
-  uint side_col = ind.side_col;
-  uint side_row = ind.side_row;
-
-  if (side_num == 2 && side_col == 2 && side_row == 1) return true;
+  std::vector<uint> moves;
 
-  if (getUndoGroup()) undo_->startGroup();
-
-  if (side_num != 2 && side_num != 0 && side_num != 1 && side_num != 3) {
-    if      (side_col == 2) { }
-    else if (side_col == 0) rotateSide2(side_num);
-    else if (side_row == 2) rotateSide (side_num, true );
-    else if (side_row == 0) rotateSide (side_num, false);
-
-    if      (side_num == 1)
-      moveSideDown(side_num, 2);
-    else if (side_num == 3)
-      moveSideUp  (side_num, 2);
-    else if (side_num == 4) {
-      moveSideUp  (4, 2); moveSideRight(2, 1);
-      moveSideDown(4, 2); moveSideLeft (2, 1);
-    }
-    else if (side_num == 5) {
-      rotateSide2(5);
-      moveSideRight(5, 1); moveSideUp(4, 2); moveSideUp(4, 2); moveSideLeft(5, 1);
-    }
-  }
-  else if (side_num == 2) {
-    // must be correct
-  }
-  else if (side_num == 0) {
-    if      (side_col == 2) { // not possible
-    }
-    else if (side_col == 0) {
-      moveSideUp  (0, 0); rotateSide2  (2   ); moveSideLeft(2, 1);
-      moveSideDown(0, 0); moveSideRight(2, 1); rotateSide2 (2   );
-    }
-    else if (side_row == 2) {
-      rotateSide(2, false); moveSideRight(0, 2); rotateSide(2, true);
-    }
-    else if (side_row == 0) {
-      rotateSide(2, true); moveSideRight(0, 0); rotateSide(2, false);
-    }
-  }
-  else if (side_num == 1) {
-    if      (side_col == 2) {
-      moveSideDown(1, 2);
-    }
-    else if (side_col == 0) {
-      rotateSide(2, true); rotateSide2(1); rotateSide(2, false); moveSideDown(2, 2);
-    }
-    else if (side_row == 2) { // not possible
-    }
-    else if (side_row == 0) {
-      moveSideRight(1, 0); rotateSide  (2, true); moveSideUp(2, 1);
-      moveSideLeft (1, 0); moveSideDown(2, 1   ); rotateSide(2, false);
-    }
-  }
-  else if (side_num == 3) {
-    if      (side_col == 2) {
-      moveSideUp(3, 2);
-    }
-    else if (side_col == 0) {
-      rotateSide2(2); moveSideUp(3, 0); rotateSide2(2);
-    }
-    else if (side_row == 2) {
-      rotateSide(2, false); rotateSide(3, true); rotateSide(2, true); moveSideUp(2, 2);
-    }
-    else if (side_row == 0) { // not possible
-    }
-  }
+  if (! undo_.redo(moves))
+    return false;
 
-  if (getUndoGroup()) undo_->endGroup();
+  applyUndoMoves(moves);
 
-  ind = findPiece(2, 4); if (! ind.assertInd("top 4", 2, 1, 1)) return false;
-  ind = findPiece(2, 1); if (! ind.assertInd("top 1", 2, 0, 1)) return false;
-  ind = findPiece(2, 3); if (! ind.assertInd("top 3", 2, 1, 0)) return false;
-  ind = findPiece(2, 5); if (! ind.assertInd("top 5", 2, 1, 2)) return false;
-  ind = findPiece(2, 7); if (! ind.assertInd("top 7", 2, 2, 1)) return false;
+  updateHistory();
 
   return true;
 }
 
 bool
 CQRubik::
-solveTopInd0()
+seekUndo(size_t pos)
 {
-  CRubikPieceInd ind = findPiece(2, 0);
-
-  uint side_num = ind.side_num;
-  uint side_col = ind.side_col;
-  uint side_row = ind.side_row;
-
-  if (side_num == 2 && side_col == 0 && side_row == 0) return true;
+  if (pos > undo_.size())
+    return false;
 
-  if (getUndoGroup()) undo_->startGroup();
+  // model must be at current undo position
+  finishAnimation();
 
-  if      (side_num == 0) {
-    if (side_col == 2) {
-      if      (side_row == 0) {
-        moveSideLeft(0, 0); moveSideUp  (0, 0); moveSideRight(0, 0);
-      }
-      else if (side_row == 2) {
-        moveSideLeft(0, 2); moveSideDown(0, 0); moveSideRight(0, 2);
-      }
+  size_t pos1 = undo_.pos();
 
-      side_col = 0;
-    }
+  // restore state from nearest checkpoint
+  undo_.seek(pos);
 
-    if (side_col == 0) {
-      if      (side_row == 0) {
-        moveSideDown(0, 0); moveSideLeft(0, 0); moveSideUp(0, 0); moveSideRight(2, 0);
-      }
-      else if (side_row == 2) {
-        moveSideLeft(1, 0); moveSideUp  (1, 0); moveSideRight2(1, 0); moveSideDown(1, 0);
-      }
-    }
-  }
-  else if (side_num == 1) {
-    if (side_row == 2) {
-      if      (side_col == 0) {
-        moveSideUp(1, 0); moveSideLeft(1, 0); moveSideDown(1, 0);
-      }
-      else if (side_col == 2) {
-        moveSideUp(1, 2); moveSideRight(1, 0); moveSideDown(1, 2);
-      }
+  if (! model_.setFacelets(undo_.state())) {
+    // cube with unknown stickers so apply the moves in between
+    std::vector<uint> moves;
 
-      side_row = 0;
-    }
+    for (size_t i = pos1; i > pos; --i)
+      moves.push_back(CRubikMove::inverse(undo_.move(i - 1)));
 
-    if (side_row == 0) {
-      if      (side_col == 0) {
-        moveSideRight(1, 0); moveSideUp(1, 0); moveSideLeft(1, 0); moveSideDown(1, 0);
-      }
-      else if (side_col == 2) {
-        moveSideUp(0, 0); moveSideLeft(0, 0);
-        moveSideUp(0, 0); moveSideUp(0, 0); moveSideRight(0, 0);
-      }
-    }
-  }
-  else if (side_num == 2) {
-    if      (side_col == 0 && side_row == 0) { // done
-    }
-    else if (side_col == 0 && side_row == 2) {
-      moveSideLeft (0, 2); moveSideDown(0, 0);
-      moveSideUp   (1, 0); moveSideRight(1, 0); moveSideRight(1, 0); moveSideDown(1, 0);
-      moveSideRight(0, 2);
-    }
-    else if (side_col == 2 && side_row == 0) {
-      moveSideUp(2, 2); rotateSide(2, true); moveSideDown(2, 0);
-      moveSideRight2(1, 0); moveSideUp(2, 0);
-      rotateSide(2, false); moveSideDown(2, 2);
-    }
-    else if (side_col == 2 && side_row == 2) {
-      moveSideUp(2, 0); moveSideDown(2, 2); moveSideRight2(1, 0);
-      moveSideDown(2, 0); moveSideUp(2, 2);
-    }
-  }
-  else if (side_num == 3) {
-    if (side_row == 0) {
-      if      (side_col == 0) {
-        moveSideDown(3, 0); moveSideLeft (3, 2); moveSideUp(3, 0);
-      }
-      else if (side_col == 2) {
-        moveSideDown(3, 2); moveSideRight(3, 2); moveSideUp(3, 2);
-      }
+    for (size_t i = pos1; i < pos; ++i)
+      moves.push_back(undo_.move(i));
 
-      side_row = 2;
-    }
+    bool animate = false;
 
-    if (side_row == 2) {
-      if      (side_col == 0) {
-        moveSideLeft(0, 0); moveSideUp(0, 0); moveSideRight(0, 0);
-      }
-      else if (side_col == 2) {
-        moveSideUp  (1, 0); moveSideLeft2(1, 0); moveSideDown(1, 0);
-      }
-    }
-  }
-  else if (side_num == 4) {
-    if (side_col == 0) {
-      if      (side_row == 0) {
-        moveSideRight(4, 0); moveSideUp  (4, 2); moveSideLeft(4, 0);
-      }
-      else if (side_row == 2) {
-        moveSideRight(4, 2); moveSideDown(4, 2); moveSideLeft(4, 2);
-      }
+    std::swap(animate_, animate);
 
-      side_col = 2;
-    }
+    applyUndoMoves(moves);
 
-    if (side_col == 2) {
-      if      (side_row == 0) {
-        moveSideUp  (2, 0); moveSideLeft  (1, 0); moveSideDown (2, 0);
-      }
-      else if (side_row == 2) {
-        moveSideLeft(2, 0); moveSideRight2(1, 0); moveSideRight(2, 0);
-      }
-    }
-  }
-  else if (side_num == 5) {
-    // move to 5,0,0
-    if      (side_col == 0 && side_row == 2) rotateSide(5, false);
-    else if (side_col == 2 && side_row == 0) rotateSide(5, true);
-    else if (side_col == 2 && side_row == 2) rotateSide2(5);
-
-    moveSideRight(2, 0); moveSideDown(0, 0); moveSideLeft (2, 0);
-    moveSideLeft (2, 0); moveSideUp  (0, 0); moveSideRight(2, 0);
+    std::swap(animate_, animate);
   }
 
-  if (getUndoGroup()) undo_->endGroup();
-
-  ind = findPiece(2, 4); if (! ind.assertInd("top 4", 2, 1, 1)) return false;
-  ind = findPiece(2, 1); if (! ind.assertInd("top 1", 2, 0, 1)) return false;
-  ind = findPiece(2, 3); if (! ind.assertInd("top 3", 2, 1, 0)) return false;
-  ind = findPiece(2, 5); if (! ind.assertInd("top 5", 2, 1, 2)) return false;
-  ind = findPiece(2, 7); if (! ind.assertInd("top 7", 2, 2, 1)) return false;
-  ind = findPiece(2, 0); if (! ind.assertInd("top 0", 2, 0, 0)) return false;
+  updateHistory();
 
   return true;
 }
 
-bool
+void
 CQRubik::
-solveTopInd2()
+historySlot(int pos)
 {
-  CRubikPieceInd ind = findPiece(2, 2);
+  if (! seekUndo(size_t(pos)))
+    updateHistory();
 
-  uint side_num = ind.side_num;
-  uint side_col = ind.side_col;
-  uint side_row = ind.side_row;
+  getTwoD()->update(); getThreeD()->update();
+}
 
-  if (side_num == 2 && side_col == 0 && side_row == 2) return true;
+// apply undo/redo moves (without adding them to the undo log)
+void
+CQRubik::
+applyUndoMoves(const std::vector<uint> &moves)
+{
+  if (getAnimate()) {
+    for (const auto &move : moves)
+      queueMove(move);
 
-  if (getUndoGroup()) undo_->startGroup();
+    return;
+  }
 
-  if      (side_num == 0) {
-    if (side_col == 2) {
-      if      (side_row == 0) { // not possible
-        moveSideLeft(0, 0); moveSideUp  (0, 0); moveSideRight(0, 0);
-      }
-      else if (side_row == 2) {
-        moveSideLeft(0, 2); moveSideDown(0, 0); moveSideRight(0, 2);
-      }
+  finishAnimation();
 
-      side_col = 0;
-    }
+  record_ = false;
 
-    if (side_col == 0) {
-      if      (side_row == 0) {
-        moveSideLeft(3, 2); moveSideDown(3, 0); moveSideRight2(3, 2); moveSideUp   (3, 0);
-      }
-      else if (side_row == 2) {
-        moveSideUp  (0, 0); moveSideLeft(0, 2); moveSideDown  (0, 0); moveSideRight(0, 2);
-      }
-    }
-  }
-  else if (side_num == 1) {
-    if (side_row == 2) {
-      if      (side_col == 0) { // not possible
-      }
-      else if (side_col == 2) {
-        moveSideUp(1, 2); moveSideRight(1, 0); moveSideDown(1, 2);
-      }
+  for (const auto &move : moves)
+    model_.applyMove(move);
 
-      side_row = 0;
-    }
+  record_ = true;
+}
 
-    if (side_row == 0) {
-      if      (side_col == 0) {
-        moveSideLeft(0, 2); moveSideDown(0, 0); moveSideRight(0, 2);
-      }
-      else if (side_col == 2) {
-        moveSideDown(3, 0); moveSideLeft2(3, 2); moveSideUp(3, 0);
-      }
-    }
-  }
-  else if (side_num == 2) {
-    if      (side_col == 0 && side_row == 0) { // not possible
-    }
-    else if (side_col == 0 && side_row == 2) { // done
-    }
-    else if (side_col == 2 && side_row == 0) {
-      moveSideRight(2, 0); moveSideLeft(2, 2);
-      moveSideUp2(0, 0);
-      moveSideRight(2, 2); moveSideLeft(2, 0);
-    }
-    else if (side_col == 2 && side_row == 2) {
-      moveSideDown(3, 2); moveSideRight(3, 2);
-      moveSideLeft(0, 2); moveSideDown2(0, 0); moveSideRight(0, 2); moveSideUp(3, 2);
-    }
-  }
-  else if (side_num == 3) {
-    if (side_row == 0) {
-      if      (side_col == 0) {
-        moveSideDown(3, 0); moveSideLeft (3, 2); moveSideUp(3, 0);
-      }
-      else if (side_col == 2) {
-        moveSideDown(3, 2); moveSideRight(3, 2); moveSideUp(3, 2);
-      }
+void
+CQRubik::
+clearUndo()
+{
+  uint8_t facelets[CRubikMove::NUM_FACELETS];
 
-      side_row = 2;
-    }
+  model_.getFacelets(facelets);
 
-    if (side_row == 2) {
-      if      (side_col == 0) {
-        moveSideRight(3, 2); moveSideDown(3, 0); moveSideLeft (3, 2); moveSideUp   (3, 0);
-      }
-      else if (side_col == 2) {
-        moveSideDown (0, 0); moveSideLeft(0, 2); moveSideDown2(0, 0); moveSideRight(0, 2);
-      }
-    }
-  }
-  else if (side_num == 4) {
-    if (side_col == 0) {
-      if      (side_row == 0) {
-        moveSideRight(4, 0); moveSideUp  (4, 2); moveSideLeft(4, 0);
-      }
-      else if (side_row == 2) {
-        moveSideRight(4, 2); moveSideDown(4, 2); moveSideLeft(4, 2);
-      }
+  undo_.clear(facelets);
 
-      side_col = 2;
-    }
-
-    if (side_col == 2) {
-      if      (side_row == 0) {
-        moveSideLeft(0, 2); moveSideDown2(0, 0); moveSideRight(0, 2);
-      }
-      else if (side_row == 2) {
-        moveSideDown(3, 0); moveSideLeft (3, 2); moveSideUp   (3, 0);
-      }
-    }
-  }
-  else if (side_num == 5) {
-    // move to 5,0,2
-    if      (side_col == 0 && side_row == 0) rotateSide(5, true);
-    else if (side_col == 2 && side_row == 0) rotateSide2(5);
-    else if (side_col == 2 && side_row == 2) rotateSide(5, false);
-
-    moveSideRight(2, 2); moveSideUp  (0, 0); moveSideLeft (2, 2);
-    moveSideLeft (2, 2); moveSideDown(0, 0); moveSideRight(2, 2);
-  }
-
-  if (getUndoGroup()) undo_->endGroup();
-
-  ind = findPiece(2, 4); if (! ind.assertInd("top 4", 2, 1, 1)) return false;
-  ind = findPiece(2, 1); if (! ind.assertInd("top 1", 2, 0, 1)) return false;
-  ind = findPiece(2, 3); if (! ind.assertInd("top 3", 2, 1, 0)) return false;
-  ind = findPiece(2, 5); if (! ind.assertInd("top 5", 2, 1, 2)) return false;
-  ind = findPiece(2, 7); if (! ind.assertInd("top 7", 2, 2, 1)) return false;
-  ind = findPiece(2, 0); if (! ind.assertInd("top 0", 2, 0, 0)) return false;
-  ind = findPiece(2, 2); if (! ind.assertInd("top 2", 2, 0, 2)) return false;
-
-  return true;
-}
-
-bool
-CQRubik::
-solveTopInd6()
-{
-  CRubikPieceInd ind = findPiece(2, 6);
-
-  uint side_num = ind.side_num;
-  uint side_col = ind.side_col;
-  uint side_row = ind.side_row;
-
-  if (side_num == 2 && side_col == 2 && side_row == 0) return true;
-
-  if (getUndoGroup()) undo_->startGroup();
-
-  if      (side_num == 0) {
-    if (side_col == 2) {
-      if      (side_row == 0) { // not possible
-      }
-      else if (side_row == 2) { // not possible
-      }
-
-      side_col = 0;
-    }
-
-    if (side_col == 0) {
-      if      (side_row == 0) {
-        moveSideUp(1, 2); moveSideRight(1, 0); moveSideDown(1, 2);
-      }
-      else if (side_row == 2) {
-        moveSideRight(4, 0); moveSideDown2(4, 2); moveSideLeft(4, 0);
-      }
-    }
-  }
-  else if (side_num == 1) {
-    if (side_row == 2) {
-      if      (side_col == 0) { // not possible
-      }
-      else if (side_col == 2) {
-        moveSideUp(1, 2); moveSideRight(1, 0); moveSideDown(1, 2);
-      }
-
-      side_row = 0;
-    }
-
-    if (side_row == 0) {
-      if      (side_col == 0) {
-        moveSideUp  (4, 2); moveSideRight(4, 0); moveSideDown2(4, 2); moveSideLeft(4, 0);
-      }
-      else if (side_col == 2) {
-        moveSideLeft(1, 0); moveSideUp   (1, 2); moveSideRight(1, 0); moveSideDown(1, 2);
-      }
-    }
-  }
-  else if (side_num == 2) {
-    if      (side_col == 0 && side_row == 0) { // not possible
-    }
-    else if (side_col == 0 && side_row == 2) { // done
-    }
-    else if (side_col == 2 && side_row == 0) { // not possible
-    }
-    else if (side_col == 2 && side_row == 2) {
-      moveSideRight(4, 2); moveSideDown  (4, 2);
-      moveSideUp   (1, 2); moveSideRight2(1, 0); moveSideDown(1, 2);
-      moveSideLeft (4, 2);
-    }
-  }
-  else if (side_num == 3) {
-    if (side_row == 0) {
-      if      (side_col == 0) { // not possible
-      }
-      else if (side_col == 2) {
-        moveSideDown(3, 2); moveSideRight(3, 2); moveSideUp(3, 2);
-      }
-
-      side_row = 2;
-    }
-
-    if (side_row == 2) {
-      if      (side_col == 0) {
-        moveSideUp(1, 2); moveSideRight2(1, 0); moveSideDown(1, 2);
-      }
-      else if (side_col == 2) {
-        moveSideRight(4, 0); moveSideUp(4, 2); moveSideLeft(4, 0);
-      }
-    }
-  }
-  else if (side_num == 4) {
-    if (side_col == 0) {
-      if      (side_row == 0) {
-        moveSideRight(4, 0); moveSideUp  (4, 2); moveSideLeft(4, 0);
-      }
-      else if (side_row == 2) {
-        moveSideRight(4, 2); moveSideDown(4, 2); moveSideLeft(4, 2);
-      }
-
-      side_col = 2;
-    }
-
-    if (side_col == 2) {
-      if      (side_row == 0) {
-        moveSideDown(4, 2); moveSideRight(4, 0); moveSideUp(4, 2); moveSideLeft(4, 0);
-      }
-      else if (side_row == 2) {
-        moveSideRight(1, 0); moveSideUp(1, 2); moveSideLeft2(1, 0); moveSideDown(1, 2);
-      }
-    }
-  }
-  else if (side_num == 5) {
-    // move to 5,0,0
-    if      (side_col == 0 && side_row == 2) rotateSide(5, false);
-    else if (side_col == 2 && side_row == 0) rotateSide(5, true);
-    else if (side_col == 2 && side_row == 2) rotateSide2(5);
-
-    moveSideRight(4, 0); moveSideUp    (4, 2); moveSideLeft(4, 0);
-    moveSideUp   (1, 2); moveSideRight2(1, 0); moveSideDown(1, 2);
-  }
-
-  if (getUndoGroup()) undo_->endGroup();
-
-  ind = findPiece(2, 4); if (! ind.assertInd("top 4", 2, 1, 1)) return false;
-  ind = findPiece(2, 1); if (! ind.assertInd("top 1", 2, 0, 1)) return false;
-  ind = findPiece(2, 3); if (! ind.assertInd("top 3", 2, 1, 0)) return false;
-  ind = findPiece(2, 5); if (! ind.assertInd("top 5", 2, 1, 2)) return false;
-  ind = findPiece(2, 7); if (! ind.assertInd("top 7", 2, 2, 1)) return false;
-  ind = findPiece(2, 0); if (! ind.assertInd("top 0", 2, 0, 0)) return false;
-  ind = findPiece(2, 2); if (! ind.assertInd("top 2", 2, 0, 2)) return false;
-  ind = findPiece(2, 6); if (! ind.assertInd("top 6", 2, 2, 0)) return false;
-
-  return true;
-}
-
-bool
-CQRubik::
-solveTopInd8()
-{
-  CRubikPieceInd ind = findPiece(2, 8);
-
-  uint side_num = ind.side_num;
-  uint side_col = ind.side_col;
-  uint side_row = ind.side_row;
-
-  if (side_num == 2 && side_col == 2 && side_row == 2) return true;
-
-  if (getUndoGroup()) undo_->startGroup();
-
-  if      (side_num == 0) {
-    if (side_col == 2) {
-      if      (side_row == 0) { // not possible
-      }
-      else if (side_row == 2) { // not possible
-      }
-
-      side_col = 0;
-    }
-
-    if (side_col == 0) {
-      if      (side_row == 0) {
-        moveSideRight(4, 2); moveSideDown2(4, 2); moveSideLeft(4, 2);
-      }
-      else if (side_row == 2) {
-        moveSideDown(3, 2); moveSideRight(3, 2); moveSideUp(3, 2);
-      }
-    }
-  }
-  else if (side_num == 1) {
-    if (side_row == 2) {
-      if      (side_col == 0) { // not possible
-      }
-      else if (side_col == 2) { // not possible
-      }
-
-      side_row = 0;
-    }
-
-    if (side_row == 0) {
-      if      (side_col == 0) {
-        moveSideDown(3, 2); moveSideLeft2(3, 2); moveSideUp(3, 2);
-      }
-      else if (side_col == 2) {
-        moveSideRight(4, 2); moveSideDown(4, 2); moveSideLeft(4, 2);
-      }
-    }
-  }
-  else if (side_num == 2) {
-    if      (side_col == 0 && side_row == 0) { // not possible
-    }
-    else if (side_col == 0 && side_row == 2) { // not possible
-    }
-    else if (side_col == 2 && side_row == 0) { // not possible
-    }
-    else if (side_col == 2 && side_row == 2) { // done
-    }
-  }
-  else if (side_num == 3) {
-    if (side_row == 0) {
-      if      (side_col == 0) { // not possible
-      }
-      else if (side_col == 2) {
-        moveSideDown(3, 2); moveSideRight(3, 2); moveSideUp(3, 2);
-      }
-
-      side_row = 2;
-    }
-
-    if (side_row == 2) {
-      if      (side_col == 0) {
-        moveSideDown(4, 2); moveSideRight(4, 2); moveSideUp2(4, 2); moveSideLeft(4, 2);
-      }
-      else if (side_col == 2) {
-        moveSideLeft(3, 2); moveSideDown(3, 2); moveSideRight(3, 2); moveSideUp(3, 2);
-      }
-    }
-  }
-  else if (side_num == 4) {
-    if (side_col == 0) {
-      if      (side_row == 0) { // not possible
-      }
-      else if (side_row == 2) {
-        moveSideRight(4, 2); moveSideDown(4, 2); moveSideLeft(4, 2);
-      }
-
-      side_col = 2;
-    }
-
-    if (side_col == 2) {
-      if      (side_row == 0) {
-        moveSideRight(3, 2); moveSideDown(3, 2); moveSideLeft2(3, 2); moveSideUp(3, 2);
-      }
-      else if (side_row == 2) {
-        moveSideUp(4, 2); moveSideRight(4, 2); moveSideDown(4, 2); moveSideLeft(4, 2);
-      }
-    }
-  }
-  else if (side_num == 5) {
-    // move to 5,0,2
-    if      (side_col == 0 && side_row == 0) rotateSide(5, true);
-    else if (side_col == 2 && side_row == 0) rotateSide2(5);
-    else if (side_col == 2 && side_row == 2) rotateSide(5, false);
-
-    moveSideRight(4, 2); moveSideDown  (4, 2); moveSideLeft(4, 2);
-    moveSideDown (3, 2); moveSideRight2(3, 2); moveSideUp  (3, 2);
-  }
-
-  if (getUndoGroup()) undo_->endGroup();
-
-  ind = findPiece(2, 4); if (! ind.assertInd("top 4", 2, 1, 1)) return false;
-  ind = findPiece(2, 1); if (! ind.assertInd("top 1", 2, 0, 1)) return false;
-  ind = findPiece(2, 3); if (! ind.assertInd("top 3", 2, 1, 0)) return false;
-  ind = findPiece(2, 5); if (! ind.assertInd("top 5", 2, 1, 2)) return false;
-  ind = findPiece(2, 7); if (! ind.assertInd("top 7", 2, 2, 1)) return false;
-  ind = findPiece(2, 0); if (! ind.assertInd("top 0", 2, 0, 0)) return false;
-  ind = findPiece(2, 2); if (! ind.assertInd("top 2", 2, 0, 2)) return false;
-  ind = findPiece(2, 6); if (! ind.assertInd("top 6", 2, 2, 0)) return false;
-  ind = findPiece(2, 8); if (! ind.assertInd("top 8", 2, 2, 2)) return false;
-
-  return true;
-}
-
-bool
-CQRubik::
-solveMidInd4()
-{
-  CRubikPieceInd ind = findPiece(0, 4);
-
-  uint side_num = ind.side_num;
-
-  if (side_num == 0) return true;
-
-  if (getUndoGroup()) undo_->startGroup();
-
-  if      (side_num == 1) moveSideDown(0, 1);
-  else if (side_num == 3) moveSideUp  (0, 1);
-  else if (side_num == 4) moveSideUp2 (0, 1);
-
-  if (getUndoGroup()) undo_->endGroup();
-
-  ind = findPiece(2, 4); if (! ind.assertInd("top 4", 2, 1, 1)) return false;
-  ind = findPiece(2, 1); if (! ind.assertInd("top 1", 2, 0, 1)) return false;
-  ind = findPiece(2, 3); if (! ind.assertInd("top 3", 2, 1, 0)) return false;
-  ind = findPiece(2, 5); if (! ind.assertInd("top 5", 2, 1, 2)) return false;
-  ind = findPiece(2, 7); if (! ind.assertInd("top 7", 2, 2, 1)) return false;
-  ind = findPiece(2, 0); if (! ind.assertInd("top 0", 2, 0, 0)) return false;
-  ind = findPiece(2, 2); if (! ind.assertInd("top 2", 2, 0, 2)) return false;
-  ind = findPiece(2, 6); if (! ind.assertInd("top 6", 2, 2, 0)) return false;
-  ind = findPiece(2, 8); if (! ind.assertInd("top 8", 2, 2, 2)) return false;
-  ind = findPiece(0, 4); if (! ind.assertInd("mid 4", 0, 1, 1)) return false;
-
-  return true;
-}
-
-bool
-CQRubik::
-solveMidLeftInd3()
-{
-  CRubikPieceInd ind = findPiece(0, 3);
-
-  uint side_num = ind.side_num;
-  uint side_col = ind.side_col;
-  uint side_row = ind.side_row;
-
-  if (side_num == 0 && side_col == 1 && side_row == 0) return true;
-
-  if (getUndoGroup()) undo_->startGroup();
-
-  if      (side_num == 1) {
-    if      (side_col == 0) {
-      moveSideDown (0, 0); moveSideLeft(0, 0); moveSideUp  (0, 0); moveSideRight(0, 0);
-      moveSideRight(1, 0); moveSideUp  (1, 0); moveSideLeft(1, 0); moveSideDown (1, 0);
-
-      moveSideDown2(0, 0);
-
-      side_num = 0; side_col = 0; side_row = 1;
-    }
-    else if (side_col == 2) {
-      moveSideDown(4, 2); moveSideRight(4, 0); moveSideUp   (4, 2); moveSideLeft(4, 0);
-      moveSideLeft(1, 0); moveSideUp   (1, 2); moveSideRight(1, 0); moveSideDown(1, 2);
-
-      side_num = 0; side_col = 0; side_row = 1;
-    }
-    else if (side_row == 0) {
-      moveSideDown(0, 0);
-
-      side_num = 0; side_col = 0; side_row = 1;
-    }
-    else if (side_row == 2) { // not possible
-    }
-  }
-  else if (side_num == 3) {
-    if      (side_col == 0) {
-      moveSideUp   (0, 0); moveSideLeft(0, 2); moveSideDown(0, 0); moveSideRight(0, 2);
-      moveSideRight(3, 2); moveSideDown(3, 0); moveSideLeft(3, 2); moveSideUp   (3, 0);
-      moveSideUp2  (0, 0);
-
-      side_num = 0; side_col = 0; side_row = 1;
-    }
-    else if (side_col == 2) {
-      moveSideUp  (4, 2); moveSideRight(4, 2); moveSideDown (4, 2); moveSideLeft(4, 2);
-      moveSideLeft(3, 2); moveSideDown (3, 2); moveSideRight(3, 2); moveSideUp  (3, 2);
-
-      side_num = 0; side_col = 0; side_row = 1;
-    }
-    else if (side_row == 0) { // not possible
-    }
-    else if (side_row == 2) {
-      moveSideUp(0, 0);
-
-      side_num = 0; side_col = 0; side_row = 1;
-    }
-  }
-  else if (side_num == 4) {
-    if      (side_col == 0) { // not possible
-    }
-    else if (side_col == 2) {
-      moveSideDown2(0, 0);
-
-      side_num = 0; side_col = 0; side_row = 1;
-    }
-    else if (side_row == 0) {
-      moveSideLeft(1, 0); moveSideUp   (1, 2); moveSideRight(1, 0); moveSideDown(1, 2);
-      moveSideDown(4, 2); moveSideRight(4, 0); moveSideUp   (4, 2); moveSideLeft(4, 0);
-
-      moveSideUp(0, 0);
-
-      side_num = 0; side_col = 0; side_row = 1;
-    }
-    else if (side_row == 2) {
-      moveSideLeft(3, 2); moveSideDown (3, 2); moveSideRight(3, 2); moveSideUp  (3, 2);
-      moveSideUp  (4, 2); moveSideRight(4, 2); moveSideDown (4, 2); moveSideLeft(4, 2);
-
-      moveSideDown(0, 0);
-
-      side_num = 0; side_col = 0; side_row = 1;
-    }
-  }
-
-  if      (side_num == 0) {
-    if (side_row == 2) {
-      moveSideRight(3, 2); moveSideDown(3, 0); moveSideLeft(3, 2); moveSideUp   (3, 0);
-      moveSideUp   (0, 0); moveSideLeft(0, 2); moveSideDown(0, 0); moveSideRight(0, 2);
-
-      moveSideDown(0, 0);
-
-      side_col = 0; side_row = 1;
-    }
-
-    if      (side_col == 0) {
-      moveSideDown (0, 0); moveSideLeft(0, 0); moveSideUp  (0, 0); moveSideRight(0, 0);
-      moveSideRight(1, 0); moveSideUp  (1, 0); moveSideLeft(1, 0); moveSideDown (1, 0);
-    }
-    else if (side_col == 2) { // not possible
-    }
-    else if (side_row == 0) { // done
-    }
-  }
-  else if (side_num == 5) {
-    // move to side_row 0
-    if      (side_col == 0) {
-      rotateSide(5, false);
-    }
-    else if (side_col == 2) {
-      rotateSide(5, true);
-    }
-    else if (side_row == 2) {
-      rotateSide2(5);
-    }
-
-    moveSideRight(1, 0); moveSideUp  (1, 0); moveSideLeft(1, 0); moveSideDown (1, 0);
-    moveSideDown (0, 0); moveSideLeft(0, 0); moveSideUp  (0, 0); moveSideRight(0, 0);
-  }
-
-  if (getUndoGroup()) undo_->endGroup();
-
-  ind = findPiece(2, 4); if (! ind.assertInd("top 4", 2, 1, 1)) return false;
-  ind = findPiece(2, 1); if (! ind.assertInd("top 1", 2, 0, 1)) return false;
-  ind = findPiece(2, 3); if (! ind.assertInd("top 3", 2, 1, 0)) return false;
-  ind = findPiece(2, 5); if (! ind.assertInd("top 5", 2, 1, 2)) return false;
-  ind = findPiece(2, 7); if (! ind.assertInd("top 7", 2, 2, 1)) return false;
-  ind = findPiece(2, 0); if (! ind.assertInd("top 0", 2, 0, 0)) return false;
-  ind = findPiece(2, 2); if (! ind.assertInd("top 2", 2, 0, 2)) return false;
-  ind = findPiece(2, 6); if (! ind.assertInd("top 6", 2, 2, 0)) return false;
-  ind = findPiece(2, 8); if (! ind.assertInd("top 8", 2, 2, 2)) return false;
-  ind = findPiece(0, 4); if (! ind.assertInd("mid 4", 0, 1, 1)) return false;
-
-  ind = findPiece(0, 3); if (! ind.assertInd("mid left 3", 0, 1, 0)) return false;
-
-  return true;
-}
-
-bool
-CQRubik::
-solveMidLeftInd5()
-{
-  CRubikPieceInd ind = findPiece(0, 5);
-
-  uint side_num = ind.side_num;
-  uint side_col = ind.side_col;
-  uint side_row = ind.side_row;
-
-  if (side_num == 0 && side_col == 1 && side_row == 2) return true;
-
-  if (getUndoGroup()) undo_->startGroup();
-
-  if      (side_num == 1) {
-    if      (side_col == 0) {
-      moveSideDown (0, 0); moveSideLeft(0, 0); moveSideUp  (0, 0); moveSideRight(0, 0);
-      moveSideRight(1, 0); moveSideUp  (1, 0); moveSideLeft(1, 0); moveSideDown (1, 0);
-
-      moveSideDown2(0, 0);
-
-      side_num = 0; side_col = 0; side_row = 1;
-    }
-    else if (side_col == 2) {
-      moveSideDown(4, 2); moveSideRight(4, 0); moveSideUp   (4, 2); moveSideLeft(4, 0);
-      moveSideLeft(1, 0); moveSideUp   (1, 2); moveSideRight(1, 0); moveSideDown(1, 2);
-
-      side_num = 0; side_col = 0; side_row = 1;
-    }
-    else if (side_row == 0) {
-      moveSideDown(0, 0);
-
-      side_num = 0; side_col = 0; side_row = 1;
-    }
-    else if (side_row == 2) { // not possible
-    }
-  }
-  else if (side_num == 3) {
-    if      (side_col == 0) {
-      moveSideUp   (0, 0); moveSideLeft(0, 2); moveSideDown(0, 0); moveSideRight(0, 2);
-      moveSideRight(3, 2); moveSideDown(3, 0); moveSideLeft(3, 2); moveSideUp   (3, 0);
-      moveSideUp2  (0, 0);
-
-      side_num = 0; side_col = 0; side_row = 1;
-    }
-    else if (side_col == 2) {
-      moveSideUp  (4, 2); moveSideRight(4, 2); moveSideDown (4, 2); moveSideLeft(4, 2);
-      moveSideLeft(3, 2); moveSideDown (3, 2); moveSideRight(3, 2); moveSideUp  (3, 2);
-
-      side_num = 0; side_col = 0; side_row = 1;
-    }
-    else if (side_row == 0) { // not possible
-    }
-    else if (side_row == 2) {
-      moveSideUp(0, 0);
-
-      side_num = 0; side_col = 0; side_row = 1;
-    }
-  }
-  else if (side_num == 4) {
-    if      (side_col == 0) { // not possible
-    }
-    else if (side_col == 2) {
-      moveSideUp2(0, 0);
-
-      side_num = 0; side_col = 0; side_row = 1;
-    }
-    else if (side_row == 0) {
-      moveSideLeft(1, 0); moveSideUp   (1, 2); moveSideRight(1, 0); moveSideDown(1, 2);
-      moveSideDown(4, 2); moveSideRight(4, 0); moveSideUp   (4, 2); moveSideLeft(4, 0);
-
-      moveSideUp(0, 0);
-
-      side_num = 0; side_col = 0; side_row = 1;
-    }
-    else if (side_row == 2) {
-      moveSideLeft(3, 2); moveSideDown (3, 2); moveSideRight(3, 2); moveSideUp  (3, 2);
-      moveSideUp  (4, 2); moveSideRight(4, 2); moveSideDown (4, 2); moveSideLeft(4, 2);
-
-      moveSideDown(0, 0);
-
-      side_num = 0; side_col = 0; side_row = 1;
-    }
-  }
-
-  if      (side_num == 0) {
-    if (side_row == 0) {
-    }
-
-    if      (side_col == 0) {
-      moveSideUp   (0, 0); moveSideLeft(0, 2); moveSideDown(0, 0); moveSideRight(0, 2);
-      moveSideRight(3, 2); moveSideDown(3, 0); moveSideLeft(3, 2); moveSideUp   (3, 0);
-    }
-    else if (side_col == 2) { // not possible
-    }
-    else if (side_row == 2) { // done
-    }
-  }
-  else if (side_num == 5) {
-    // move to side_row 2
-    if      (side_col == 0) {
-      rotateSide(5, true);
-    }
-    else if (side_col == 2) {
-      rotateSide(5, false);
-    }
-    else if (side_row == 0) {
-      rotateSide2(5);
-    }
-
-    moveSideRight(3, 2); moveSideDown(3, 0); moveSideLeft(3, 2); moveSideUp   (3, 0);
-    moveSideUp   (0, 0); moveSideLeft(0, 2); moveSideDown(0, 0); moveSideRight(0, 2);
-  }
-
-  if (getUndoGroup()) undo_->endGroup();
-
-  ind = findPiece(2, 4); if (! ind.assertInd("top 4", 2, 1, 1)) return false;
-  ind = findPiece(2, 1); if (! ind.assertInd("top 1", 2, 0, 1)) return false;
-  ind = findPiece(2, 3); if (! ind.assertInd("top 3", 2, 1, 0)) return false;
-  ind = findPiece(2, 5); if (! ind.assertInd("top 5", 2, 1, 2)) return false;
-  ind = findPiece(2, 7); if (! ind.assertInd("top 7", 2, 2, 1)) return false;
-  ind = findPiece(2, 0); if (! ind.assertInd("top 0", 2, 0, 0)) return false;
-  ind = findPiece(2, 2); if (! ind.assertInd("top 2", 2, 0, 2)) return false;
-  ind = findPiece(2, 6); if (! ind.assertInd("top 6", 2, 2, 0)) return false;
-  ind = findPiece(2, 8); if (! ind.assertInd("top 8", 2, 2, 2)) return false;
-  ind = findPiece(0, 4); if (! ind.assertInd("mid 4", 0, 1, 1)) return false;
-
-  ind = findPiece(0, 3); if (! ind.assertInd("mid left 3", 0, 1, 0)) return false;
-  ind = findPiece(0, 5); if (! ind.assertInd("mid left 5", 0, 1, 2)) return false;
-
-  return true;
-}
-
-bool
-CQRubik::
-solveMidRightInd3()
-{
-  CRubikPieceInd ind = findPiece(4, 3);
-
-  uint side_num = ind.side_num;
-  uint side_col = ind.side_col;
-  uint side_row = ind.side_row;
-
-  if (side_num == 4 && side_col == 1 && side_row == 0) return true;
-
-  if (getUndoGroup()) undo_->startGroup();
-
-  if      (side_num == 0) {
-    if      (side_col == 0) {
-      moveSideUp2(0, 0);
-
-      side_num = 4; side_col = 2; side_row = 1;
-    }
-    else if (side_col == 2) { // not possible
-    }
-    else if (side_row == 0) { // not possible
-    }
-    else if (side_row == 2) { // not possible
-    }
-  }
-  else if (side_num == 1) {
-    if      (side_col == 0) { // not possible
-    }
-    else if (side_col == 2) {
-      moveSideDown(4, 2); moveSideRight(4, 0); moveSideUp   (4, 2); moveSideLeft(4, 0);
-      moveSideLeft(1, 0); moveSideUp   (1, 2); moveSideRight(1, 0); moveSideDown(1, 2);
-
-      moveSideUp2(0, 0);
-
-      side_num = 4; side_col = 2; side_row = 1;
-    }
-    else if (side_row == 0) {
-      moveSideUp(0, 0);
-
-      side_num = 4; side_col = 2; side_row = 1;
-    }
-    else if (side_row == 2) { // not possible
-    }
-  }
-  else if (side_num == 3) {
-    if      (side_col == 0) { // not possible
-    }
-    else if (side_col == 2) {
-      moveSideUp  (4, 2); moveSideRight(4, 2); moveSideDown (4, 2); moveSideLeft(4, 2);
-      moveSideLeft(3, 2); moveSideDown (3, 2); moveSideRight(3, 2); moveSideUp  (3, 2);
-
-      moveSideUp2(0, 0);
-
-      side_num = 4; side_col = 2; side_row = 1;
-    }
-    else if (side_row == 0) { // not possible
-    }
-    else if (side_row == 2) {
-      moveSideDown(0, 0);
-
-      side_num = 4; side_col = 2; side_row = 1;
-    }
-  }
-
-  if      (side_num == 4) {
-    if      (side_col == 0) { // not possible
-    }
-    else if (side_row == 0) { // done
-    }
-    else if (side_row == 2) {
-      moveSideLeft(3, 2); moveSideDown (3, 2); moveSideRight(3, 2); moveSideUp  (3, 2);
-      moveSideUp  (4, 2); moveSideRight(4, 2); moveSideDown (4, 2); moveSideLeft(4, 2);
-
-      moveSideUp(0, 0);
-
-      side_num = 4; side_col = 2; side_row = 1;
-    }
-
-    if (side_col == 2) {
-      moveSideDown(4, 2); moveSideRight(4, 0); moveSideUp   (4, 2); moveSideLeft(4, 0);
-      moveSideLeft(1, 0); moveSideUp   (1, 2); moveSideRight(1, 0); moveSideDown(1, 2);
-    }
-  }
-  else if (side_num == 5) {
-    // move to side_row 0
-    if      (side_col == 0) {
-      rotateSide(5, false);
-    }
-    else if (side_col == 2) {
-      rotateSide(5, true);
-    }
-    else if (side_row == 2) {
-      rotateSide2(5);
-    }
-
-    moveSideLeft(1, 0); moveSideUp   (1, 2); moveSideRight(1, 0); moveSideDown(1, 2);
-    moveSideDown(4, 2); moveSideRight(4, 0); moveSideUp   (4, 2); moveSideLeft(4, 0);
-  }
-
-  if (getUndoGroup()) undo_->endGroup();
-
-  ind = findPiece(2, 4); if (! ind.assertInd("top 4", 2, 1, 1)) return false;
-  ind = findPiece(2, 1); if (! ind.assertInd("top 1", 2, 0, 1)) return false;
-  ind = findPiece(2, 3); if (! ind.assertInd("top 3", 2, 1, 0)) return false;
-  ind = findPiece(2, 5); if (! ind.assertInd("top 5", 2, 1, 2)) return false;
-  ind = findPiece(2, 7); if (! ind.assertInd("top 7", 2, 2, 1)) return false;
-  ind = findPiece(2, 0); if (! ind.assertInd("top 0", 2, 0, 0)) return false;
-  ind = findPiece(2, 2); if (! ind.assertInd("top 2", 2, 0, 2)) return false;
-  ind = findPiece(2, 6); if (! ind.assertInd("top 6", 2, 2, 0)) return false;
-  ind = findPiece(2, 8); if (! ind.assertInd("top 8", 2, 2, 2)) return false;
-  ind = findPiece(0, 4); if (! ind.assertInd("mid 4", 0, 1, 1)) return false;
-
-  ind = findPiece(0, 3); if (! ind.assertInd("mid left 3", 0, 1, 0)) return false;
-  ind = findPiece(0, 5); if (! ind.assertInd("mid left 5", 0, 1, 2)) return false;
-
-  ind = findPiece(4, 3); if (! ind.assertInd("mid right 3", 4, 1, 0)) return false;
-
-  return true;
-}
-
-bool
-CQRubik::
-solveMidRightInd5()
-{
-  CRubikPieceInd ind = findPiece(4, 5);
-
-  uint side_num = ind.side_num;
-  uint side_col = ind.side_col;
-  uint side_row = ind.side_row;
-
-  if (side_num == 4 && side_col == 1 && side_row == 2) return true;
-
-  if (getUndoGroup()) undo_->startGroup();
-
-  if      (side_num == 0) {
-    if      (side_col == 0) {
-      moveSideUp2(0, 0);
-
-      side_num = 4; side_col = 2; side_row = 1;
-    }
-    else if (side_col == 2) { // not possible
-    }
-    else if (side_row == 0) { // not possible
-    }
-    else if (side_row == 2) { // not possible
-    }
-  }
-  else if (side_num == 1) {
-    if      (side_col == 0) { // not possible
-    }
-    else if (side_col == 2) { // not possible
-    }
-    else if (side_row == 0) {
-      moveSideUp(0, 0);
-
-      side_num = 4; side_col = 2; side_row = 1;
-    }
-    else if (side_row == 2) { // not possible
-    }
-  }
-  else if (side_num == 3) {
-    if      (side_col == 0) { // not possible
-    }
-    else if (side_col == 2) {
-      moveSideUp  (4, 2); moveSideRight(4, 2); moveSideDown (4, 2); moveSideLeft(4, 2);
-      moveSideLeft(3, 2); moveSideDown (3, 2); moveSideRight(3, 2); moveSideUp  (3, 2);
-
-      moveSideUp2(0, 0);
-
-      side_num = 4; side_col = 2; side_row = 1;
-    }
-    else if (side_row == 0) { // not possible
-    }
-    else if (side_row == 2) {
-      moveSideDown(0, 0);
-
-      side_num = 4; side_col = 2; side_row = 1;
-    }
-  }
-
-  if      (side_num == 4) {
-    if      (side_col == 0) { // not possible
-    }
-    else if (side_row == 0) { // not possible
-    }
-    else if (side_row == 2) { // done
-    }
-
-    if (side_col == 2) {
-      moveSideUp  (4, 2); moveSideRight(4, 2); moveSideDown (4, 2); moveSideLeft(4, 2);
-      moveSideLeft(3, 2); moveSideDown (3, 2); moveSideRight(3, 2); moveSideUp  (3, 2);
-    }
-  }
-  else if (side_num == 5) {
-    // move to side_row 2
-    if      (side_col == 0) {
-      rotateSide(5, true);
-    }
-    else if (side_col == 2) {
-      rotateSide(5, false);
-    }
-    else if (side_row == 0) {
-      rotateSide2(5);
-    }
-
-    moveSideLeft(3, 2); moveSideDown (3, 2); moveSideRight(3, 2); moveSideUp  (3, 2);
-    moveSideUp  (4, 2); moveSideRight(4, 2); moveSideDown (4, 2); moveSideLeft(4, 2);
-  }
-
-  if (getUndoGroup()) undo_->endGroup();
-
-  ind = findPiece(2, 4); if (! ind.assertInd("top 4", 2, 1, 1)) return false;
-  ind = findPiece(2, 1); if (! ind.assertInd("top 1", 2, 0, 1)) return false;
-  ind = findPiece(2, 3); if (! ind.assertInd("top 3", 2, 1, 0)) return false;
-  ind = findPiece(2, 5); if (! ind.assertInd("top 5", 2, 1, 2)) return false;
-  ind = findPiece(2, 7); if (! ind.assertInd("top 7", 2, 2, 1)) return false;
-  ind = findPiece(2, 0); if (! ind.assertInd("top 0", 2, 0, 0)) return false;
-  ind = findPiece(2, 2); if (! ind.assertInd("top 2", 2, 0, 2)) return false;
-  ind = findPiece(2, 6); if (! ind.assertInd("top 6", 2, 2, 0)) return false;
-  ind = findPiece(2, 8); if (! ind.assertInd("top 8", 2, 2, 2)) return false;
-  ind = findPiece(0, 4); if (! ind.assertInd("mid 4", 0, 1, 1)) return false;
-
-  ind = findPiece(0, 3); if (! ind.assertInd("mid left 3", 0, 1, 0)) return false;
-  ind = findPiece(0, 5); if (! ind.assertInd("mid left 5", 0, 1, 2)) return false;
-
-  ind = findPiece(4, 3); if (! ind.assertInd("mid right 3", 4, 1, 0)) return false;
-  ind = findPiece(4, 5); if (! ind.assertInd("mid right 5", 4, 1, 2)) return false;
-
-  return true;
-}
-
-bool
-CQRubik::
-solveBottomCross()
-{
-  CRubikSide &side = sides_[2];
-
-  CRubikPiece &piece1 = side.pieces[0][1];
-  CRubikPiece &piece3 = side.pieces[1][0];
-  CRubikPiece &piece5 = side.pieces[1][2];
-  CRubikPiece &piece7 = side.pieces[2][1];
-
-  if (piece1.side == 5 && piece3.side == 5 &&
-      piece5.side == 5 && piece7.side == 5) {
-    return true;
-  }
-
-  if (getUndoGroup()) undo_->startGroup();
-
-  if      ((piece1.side != 5 && piece7.side != 5 &&
-            piece3.side == 5 && piece5.side == 5) ||
-           (piece1.side == 5 && piece7.side == 5 &&
-            piece3.side != 5 && piece5.side != 5)) {
-    if (piece1.side != 5)
-      rotateSide(2, false);
-
-    rotateSide(3, false); rotateSide(4, false); rotateSide(2, false);
-    rotateSide(4, true ); rotateSide(2, true ); rotateSide(3, true );
-  }
-  else if (piece1.side != 5 && piece3.side != 5 &&
-           piece5.side != 5 && piece7.side != 5) {
-    rotateSide(3, false); rotateSide(4, false); rotateSide(2, false);
-    rotateSide(4, true ); rotateSide(2, true ); rotateSide(3, true );
-
-    CRubikPiece &piece1 = side.pieces[0][1];
-    CRubikPiece &piece3 = side.pieces[1][0];
-    CRubikPiece &piece5 = side.pieces[1][2];
-    CRubikPiece &piece7 = side.pieces[2][1];
-
-    if      ((piece1.side != 5 && piece7.side != 5 &&
-             piece3.side == 5 && piece5.side == 5) ||
-            (piece1.side == 5 && piece7.side == 5 &&
-             piece3.side != 5 && piece5.side != 5)) {
-      // State 3
-
-      if (piece1.side != 5)
-        rotateSide(2, false);
-
-      rotateSide(3, false); rotateSide(4, false); rotateSide(2, false);
-      rotateSide(4, true ); rotateSide(2, true ); rotateSide(3, true );
-    }
-    else {
-      // State 2
-      if      (piece1.side != 5 && piece3.side != 5)
-        rotateSide2(2);
-      else if (piece1.side == 5 && piece3.side != 5)
-        rotateSide(2, false);
-      else if (piece1.side != 5 && piece3.side == 5)
-        rotateSide(2, true);
-
-      rotateSide(3, false); rotateSide(2, false); rotateSide(4, false);
-      rotateSide(2, true ); rotateSide(4, true ); rotateSide(3, true );
-    }
-  }
-  else {
-    if      (piece1.side != 5 && piece3.side != 5)
-      rotateSide2(2);
-    else if (piece1.side == 5 && piece3.side != 5)
-      rotateSide(2, false);
-    else if (piece1.side != 5 && piece3.side == 5)
-      rotateSide(2, true);
-
-    rotateSide(3, false); rotateSide(2, false); rotateSide(4, false);
-    rotateSide(2, true ); rotateSide(4, true ); rotateSide(3, true );
-  }
-
-  if (getUndoGroup()) undo_->endGroup();
-
-  {
-    CRubikPiece &piece1 = side.pieces[0][1];
-    CRubikPiece &piece3 = side.pieces[1][0];
-    CRubikPiece &piece5 = side.pieces[1][2];
-    CRubikPiece &piece7 = side.pieces[2][1];
-
-    if (piece1.side != 5 || piece3.side != 5 || piece5.side != 5 || piece7.side != 5)
-      return false;
-  }
-
-  return true;
-}
-
-bool
-CQRubik::
-solveBottomCornerOrder()
-{
-  if (getUndoGroup()) undo_->startGroup();
-
-  solveBottomCornerOrder1();
-
-  if (getUndoGroup()) undo_->endGroup();
-
-  return solveBottomCornerOrder1(true);
-}
-
-bool
-CQRubik::
-solveBottomCornerOrder1(bool check)
-{
-  CRubikSide &side = sides_[2];
-
-  const CRubikPiece &piece0 = side.pieces[0][0];
-  const CRubikPiece &piece2 = side.pieces[0][2];
-  const CRubikPiece &piece6 = side.pieces[2][0];
-  const CRubikPiece &piece8 = side.pieces[2][2];
-
-  uint corner0, corner2, corner6, corner8;
-
-  if (piece0.side == 5)
-    corner0 = piece0.id;
-  else {
-    const CRubikPiece &piece0 = getPieceLeft(2, 0, 0);
-
-    if (piece0.side == 5)
-      corner0 = piece0.id;
-    else {
-      const CRubikPiece &piece0 = getPieceUp(2, 0, 0);
-
-      corner0 = piece0.id;
-    }
-  }
-
-  if (piece2.side == 5)
-    corner2 = piece2.id;
-  else {
-    const CRubikPiece &piece2 = getPieceLeft(2, 0, 2);
-
-    if (piece2.side == 5)
-      corner2 = piece2.id;
-    else {
-      const CRubikPiece &piece2 = getPieceDown(2, 0, 2);
-
-      corner2 = piece2.id;
-    }
-  }
-
-  if (piece6.side == 5)
-    corner6 = piece6.id;
-  else {
-    const CRubikPiece &piece6 = getPieceRight(2, 2, 0);
-
-    if (piece6.side == 5)
-      corner6 = piece6.id;
-    else {
-      const CRubikPiece &piece6 = getPieceUp(2, 2, 0);
-
-      corner6 = piece6.id;
-    }
-  }
-
-  if (piece8.side == 5)
-    corner8 = piece8.id;
-  else {
-    const CRubikPiece &piece8 = getPieceRight(2, 2, 2);
-
-    if (piece8.side == 5)
-      corner8 = piece8.id;
-    else {
-      const CRubikPiece &piece8 = getPieceDown(2, 2, 2);
-
-      corner8 = piece8.id;
-    }
-  }
-
-  if      (corner2 == 0) {
-    rotateSide(2, false);
-
-    uint t = corner0; corner0 = corner2; corner2 = corner8; corner8 = corner6; corner6 = t;
-  }
-  else if (corner6 == 0) {
-    rotateSide(2, true);
-
-    uint t = corner0; corner0 = corner6; corner6 = corner8; corner8 = corner2; corner2 = t;
-  }
-  else if (corner8 == 0) {
-    rotateSide2(2);
-
-    uint t1 = corner0; corner0 = corner8; corner8 = t1;
-    uint t2 = corner2; corner2 = corner6; corner6 = t2;
-  }
-
-  if (check) {
-    return (corner2 == 2 && corner6 == 6);
-  }
-
-  //-----
-
-  if      (corner2 == 2) {
-    if   (corner6 == 6) { // 0 2 6 8
-      // done
-    }
-    else { // 0 2 8 6
-      // adjacent 6/8
-      rotateSide(0, false); rotateSide(2, true); rotateSide(4, true ); rotateSide (2, false);
-      rotateSide(0, true ); rotateSide(2, true); rotateSide(4, false); rotateSide2(2);
-    }
-  }
-  else if (corner2 == 6) {
-    if   (corner6 == 2) { // 0 6 2 8
-      // swap 2/6
-
-      rotateSide(0, false); rotateSide(2, true); rotateSide(4, true ); rotateSide (2, false);
-      rotateSide(0, true ); rotateSide(2, true); rotateSide(4, false); rotateSide2(2);
-
-      solveBottomCornerOrder1();
-    }
-    else { // 0 6 8 2
-      // swap 0/6
-      rotateSide2(2);
-
-      rotateSide(0, false); rotateSide(2, true); rotateSide(4, true ); rotateSide (2, false);
-      rotateSide(0, true ); rotateSide(2, true); rotateSide(4, false); rotateSide2(2);
-    }
-  }
-  else {
-    if   (corner6 == 2) { // 0 8 2 6
-      rotateSide(2, false);
-
-      // adjacent 0/8
-      rotateSide(0, false); rotateSide(2, true); rotateSide(4, true ); rotateSide (2, false);
-      rotateSide(0, true ); rotateSide(2, true); rotateSide(4, false); rotateSide2(2);
-    }
-    else { // 0 8 6 2
-      rotateSide(2, true);
-
-      // adjacent 2/8
-      rotateSide(0, false); rotateSide(2, true); rotateSide(4, true ); rotateSide (2, false);
-      rotateSide(0, true ); rotateSide(2, true); rotateSide(4, false); rotateSide2(2);
-    }
-  }
-
-  return true;
-}
-
-bool
-CQRubik::
-solveBottomCornerOrient(bool check)
-{
-  CRubikSide &side = sides_[2];
-
-  const CRubikPiece &piece0 = side.pieces[0][0];
-  const CRubikPiece &piece2 = side.pieces[0][2];
-  const CRubikPiece &piece6 = side.pieces[2][0];
-  const CRubikPiece &piece8 = side.pieces[2][2];
-
-  uint num = 0;
-
-  if (piece0.side == 5) ++num;
-  if (piece2.side == 5) ++num;
-  if (piece6.side == 5) ++num;
-  if (piece8.side == 5) ++num;
-
-  if (check) return (num == 4);
-
-  if (num == 4) return true;
-
-  if (getUndoGroup()) undo_->startGroup();
-
-  uint state = 0;
-
-  if      (num == 0) {
-    const CRubikPiece &upiece1 = getPieceUp  (2, 0, 0);
-    const CRubikPiece &upiece2 = getPieceUp  (2, 2, 0);
-    const CRubikPiece &dpiece1 = getPieceDown(2, 0, 2);
-    const CRubikPiece &dpiece2 = getPieceDown(2, 2, 2);
-
-    if ((upiece1.side != 5 && upiece2.side != 5 && dpiece1.side != 5 && dpiece2.side != 5) ||
-       (upiece1.side == upiece2.side && dpiece1.side == dpiece2.side)) {
-      if (upiece1.side != 5)
-        rotateSide(2, false);
-
-      state = 7;
-
-      rotateSide(2, false);
-
-      solveBottomCornerOrient2();
-
-      rotateSide2(2);
-
-      solveBottomCornerOrient2();
-    }
-    else {
-      if      (upiece1.side != 5 && upiece2.side != 5)
-        rotateSide(2, false);
-      else if (upiece1.side == 5 && upiece2.side != 5)
-        rotateSide2(2);
-      else if (upiece1.side == 5 && upiece2.side == 5)
-        rotateSide(2, true);
-
-      state = 6;
-
-      solveBottomCornerOrient2();
-
-      rotateSide(2, false);
-
-      solveBottomCornerOrient2();
-    }
-  }
-  else if (num == 1) {
-    if (piece2.side == 5) rotateSide (2, false);
-    if (piece6.side == 5) rotateSide (2, true);
-    if (piece8.side == 5) rotateSide2(2);
-
-    const CRubikPiece &upiece = getPieceUp(2, 2, 0);
-
-    if (upiece.side == 5) {
-      // State 1
-      state = 1;
-
-      solveBottomCornerOrient1();
-    }
-    else {
-      rotateSide(2, true);
-
-      // State 2
-      state = 2;
-
-      solveBottomCornerOrient2();
-    }
-  }
-  else if (num == 2) {
-    if (piece0.side != piece8.side && piece2.side != piece6.side) {
-      if      (piece0.side != 5 && piece2.side != 5) rotateSide2(2);
-      else if (piece0.side != 5) rotateSide(2, false);
-      else if (piece2.side != 5) rotateSide(2, true);
-
-      const CRubikPiece &upiece = getPieceUp(2, 2, 0);
-
-      if (upiece.side == 5) {
-        // State 4
-        state = 4;
-
-        rotateSide2(2);
-
-        solveBottomCornerOrient1();
-
-        solveBottomCornerOrient2();
-      }
-      else {
-        // State 3
-        state = 3;
-
-        rotateSide(2, false);
-
-        solveBottomCornerOrient2();
-
-        rotateSide2(2);
-
-        solveBottomCornerOrient1();
-      }
-    }
-    else {
-      state = 5;
-
-      if (piece0.side != 5) rotateSide(2, false);
-
-      const CRubikPiece &upiece = getPieceUp(2, 2, 0);
-
-      if (upiece.side != 5) rotateSide2(2);
-
-      rotateSide(2, false);
-
-      solveBottomCornerOrient1();
-
-      rotateSide(2, false);
-
-      solveBottomCornerOrient2();
-    }
-  }
-
-  if (side.pieces[0][0].id != 0) rotateSide(2, false);
-  if (side.pieces[0][0].id != 0) rotateSide(2, false);
-  if (side.pieces[0][0].id != 0) rotateSide(2, false);
-
-  if (getUndoGroup()) undo_->endGroup();
-
-  if (! solveBottomCornerOrient(true)) {
-    std::cerr << "State " << state << "(" << num << ")" << std::endl;
-    return false;
-  }
-
-  return true;
-}
-
-bool
-CQRubik::
-solveBottomMiddles()
-{
-  CRubikSide &side = sides_[2];
-
-  CRubikPiece &piece1 = side.pieces[0][1];
-  CRubikPiece &piece3 = side.pieces[1][0];
-  CRubikPiece &piece5 = side.pieces[1][2];
-  CRubikPiece &piece7 = side.pieces[2][1];
-
-  if (piece1.id == 1 && piece3.id == 3 && piece5.id == 5 && piece7.id == 7)
-    return true;
-
-  if (getUndoGroup()) undo_->startGroup();
-
-  solveBottomMiddlesSub();
-
-  if (getUndoGroup()) undo_->endGroup();
-
-  return (piece1.id == 1 && piece3.id == 3 && piece5.id == 5 && piece7.id == 7);
-}
-
-void
-CQRubik::
-solveBottomMiddlesSub()
-{
-  CRubikSide &side = sides_[2];
-
-  CRubikPiece &piece1 = side.pieces[0][1];
-  CRubikPiece &piece3 = side.pieces[1][0];
-  CRubikPiece &piece5 = side.pieces[1][2];
-  CRubikPiece &piece7 = side.pieces[2][1];
-
-  if (piece1.id == 1 && piece3.id == 3 && piece5.id == 5 && piece7.id == 7) return;
-
-  if      (piece1.id == 1) { // L Side Correct
-    if      (piece3.id == 3) {
-      if (piece5.id == 5) {
-      }
-      else { // 7
-      }
-    }
-    else if (piece3.id == 5) {
-      if (piece5.id == 3) {
-      }
-      else { // 7
-        // State 2
-        solveBottomMiddles2();
-      }
-    }
-    else { // 7
-      if (piece5.id == 3) {
-        // State 1
-        solveBottomMiddles1();
-      }
-      else { // 5
-      }
-    }
-  }
-  else if (piece3.id == 3) { // T Side Correct
-    rotateSide(2, true);
-
-    if      (piece3.id == 1) {
-      if (piece5.id == 5) {
-        // State 2
-        solveBottomMiddles2();
-      }
-      else { // 7
-      }
-    }
-    else if (piece3.id == 5) {
-      if (piece5.id == 3) {
-      }
-      else { // 7
-        // State 1
-        solveBottomMiddles1();
-      }
-    }
-    else { // 7
-      if (piece5.id == 1) {
-      }
-      else { // 5
-      }
-    }
-
-    rotateSide(2, false);
-  }
-  else if (piece5.id == 5) { // B Side Correct
-    rotateSide(2, false);
-
-    if      (piece3.id == 1) {
-      if (piece5.id == 3) {
-      }
-      else { // 7
-      }
-    }
-    else if (piece3.id == 3) {
-      if (piece5.id == 1) {
-        // State 1
-        solveBottomMiddles1();
-      }
-      else { // 7
-      }
-    }
-    else { // 7
-      if (piece5.id == 1) {
-      }
-      else { // 3
-        // State 2
-        solveBottomMiddles2();
-      }
-    }
-
-    rotateSide(2, true);
-  }
-  else if (piece7.id == 7) { // R Side Correct
-    rotateSide2(2);
-
-    if      (piece3.id == 1) {
-      if (piece5.id == 3) {
-      }
-      else { // 5
-        // State 1
-        solveBottomMiddles1();
-      }
-    }
-    else if (piece3.id == 3) {
-      if (piece5.id == 1) {
-        // State 1
-        solveBottomMiddles2();
-      }
-      else { // 5
-      }
-    }
-    else { // 5
-      if (piece5.id == 1) {
-      }
-      else { // 3
-      }
-    }
-
-    rotateSide2(2);
-  }
-  else { // No Sides Correct
-    if ((piece1.side == 7 && piece7.side == 1) ||
-        (piece1.side == 3 && piece7.side == 5) ||
-        (piece1.side == 5 && piece7.side == 3)) {
-      solveBottomMiddles1();
-
-      solveBottomMiddlesSub();
-    }
-    else {
-      solveBottomMiddles1();
-
-      solveBottomMiddlesSub();
-    }
-  }
-}
+  updateHistory();
+}
 
 void
 CQRubik::
-solveBottomMiddles1()
+updateHistory()
 {
-  rotateSide2(4); rotateSide(2, false); rotateSide(3, false); rotateSide(1, true );
-  rotateSide2(4); rotateSide(3, true ); rotateSide(1, false); rotateSide(2, false);
-  rotateSide2(4);
-}
+  history_->blockSignals(true);
 
-void
-CQRubik::
-solveBottomMiddles2()
-{
-  rotateSide2(4); rotateSide(2, true); rotateSide(3, false); rotateSide(1, true);
-  rotateSide2(4); rotateSide(3, true); rotateSide(1, false); rotateSide(2, true);
-  rotateSide2(4);
-}
+  history_->setRange(0, int(undo_.size()));
+  history_->setValue(int(undo_.pos()));
 
-void
-CQRubik::
-solveBottomCornerOrient1()
-{
-  rotateSide(4, true); rotateSide (2, true); rotateSide(4, false); rotateSide (2, true);
-  rotateSide(4, true); rotateSide2(2      ); rotateSide(4, false); rotateSide2(2);
+  history_->blockSignals(false);
 }
 
 void
 CQRubik::
-solveBottomCornerOrient2()
-{
-  rotateSide(4, false); rotateSide (2, false); rotateSide(4, true); rotateSide (2, false);
-  rotateSide(4, false); rotateSide2(2       ); rotateSide(4, true); rotateSide2(2);
-}
-
-CRubikPieceInd
-CQRubik::
-findPiece(uint side_num, uint id)
+setMessage(const QString &msg)
 {
-  for (uint i = 0; i < CUBE_SIDES; ++i) {
-    CRubikSide &side = sides_[i];
-
-    for (uint j = 0; j < SIDE_PIECES; ++j) {
-      uint ix = j % SIDE_LENGTH;
-      uint iy = j / SIDE_LENGTH;
+  message_ = msg;
 
-      if (side.pieces[ix][iy].side == side_num && side.pieces[ix][iy].id == id)
-        return CRubikPieceInd(i, ix, iy);
-    }
-  }
-
-  return CRubikPieceInd(0, 0, 0);
+  update();
 }
 
 void
@@ -2310,6 +409,14 @@ paintEvent(QPaintEvent *)
   QPainter p(this);
 
   p.fillRect(rect(), QColor(140,140,140));
+
+  // solve method and progress
+  static const char *methodNames[] = { "Layer", "Two Phase", "Optimal" };
+
+  p.setPen(QColor(0,0,0));
+
+  p.drawText(8, 16, methodNames[int(model_.getSolveMethod())]);
+  p.drawText(8, 32, message_);
 }
 
 void
@@ -2336,6 +443,8 @@ placeWidgets()
     w3_->resize(s1, s1);
     w3_->move  (width() - s1 - b, b);
 
+    history_->setGeometry(b, 40, width() - s1 - 3*b, 20);
+
     //toolbar_->move(width() - s1 - b, b + s1);
   }
   else {
@@ -2348,6 +457,8 @@ placeWidgets()
     w3_->resize(2*s3, 2*s3);
     w3_->move  (b, height() - 2*s3 - b);
 
+    history_->setGeometry(b, 40, width() - s2 - 3*b, 20);
+
     //toolbar_->move(b, height() - 2*s3 - b - toolbar_->height());
   }
 }
@@ -2391,9 +502,12 @@ keyPressEvent(QKeyEvent *e)
     getTwoD()->update(); getThreeD()->update();
   }
   else if (key == Qt::Key_S) {
-    solve();
+    startSolve();
+  }
+  else if (key == Qt::Key_Escape) {
+    cancelSolve();
 
-    getTwoD()->update(); getThreeD()->update();
+    finishAnimation();
   }
   else if (key == Qt::Key_T) {
     getThreeD()->toggleTexture();
@@ -2403,12 +517,37 @@ keyPressEvent(QKeyEvent *e)
   else if (key == Qt::Key_U) {
     setUndoGroup(! getUndoGroup());
   }
+  else if (key == Qt::Key_K) {
+    // cycle layer, two phase and optimal solver
+    if      (model_.getSolveMethod() == CRubikModel::SolveMethod::LAYER)
+      model_.setSolveMethod(CRubikModel::SolveMethod::TWO_PHASE);
+    else if (model_.getSolveMethod() == CRubikModel::SolveMethod::TWO_PHASE)
+      model_.setSolveMethod(CRubikModel::SolveMethod::OPTIMAL);
+    else
+      model_.setSolveMethod(CRubikModel::SolveMethod::LAYER);
+
+    update();
+  }
   else if (key == Qt::Key_X) {
-    for (uint i = 0; i < 1000; ++i) {
-      randomize();
+    startTest(1000);
+  }
+  else if (key == Qt::Key_Plus || key == Qt::Key_Minus) {
+    // faster/slower animation
+    if (key == Qt::Key_Plus)
+      setTurnTime(std::max(getTurnTime()*2/3, uint(MIN_TURN_TIME)));
+    else
+      setTurnTime(std::min(getTurnTime()*3/2, 5000u));
 
-      if (! solve()) break;
-    }
+    setMessage(QString("Turn time %1ms").arg(getTurnTime()));
+  }
+  else if (key == Qt::Key_V) {
+    setValidate(! getValidate());
+
+    getTwoD()->update();
+  }
+  else if (key >= Qt::Key_1 && key <= Qt::Key_6) {
+    // set current sticker to side color (L U F D R B)
+    setPieceColor(uint(key - Qt::Key_1));
 
     getTwoD()->update(); getThreeD()->update();
   }
@@ -2417,12 +556,17 @@ keyPressEvent(QKeyEvent *e)
   }
   else if (e->modifiers() & Qt::ControlModifier) {
     if      (key == Qt::Key_Z) {
-      getUndo()->undo();
+      undo();
 
       getTwoD()->update(); getThreeD()->update();
     }
     else if (key == Qt::Key_Y) {
-      getUndo()->redo();
+      redo();
+
+      getTwoD()->update(); getThreeD()->update();
+    }
+    else if (key == Qt::Key_Home || key == Qt::Key_End) {
+      seekUndo(key == Qt::Key_Home ? 0 : undo_.size());
 
       getTwoD()->update(); getThreeD()->update();
     }
@@ -2442,20 +586,20 @@ CQRubik::
 movePosition(int key)
 {
   if      (key == Qt::Key_Left) {
-    getPosLeft(ind_.side_num, ind_.side_col, ind_.side_row, dir_,
-               ind_.side_num, ind_.side_col, ind_.side_row, dir_);
+    model_.getPosLeft(ind_.side_num, ind_.side_col, ind_.side_row, dir_,
+                      ind_.side_num, ind_.side_col, ind_.side_row, dir_);
   }
   else if (key == Qt::Key_Right) {
-    getPosRight(ind_.side_num, ind_.side_col, ind_.side_row, dir_,
-                ind_.side_num, ind_.side_col, ind_.side_row, dir_);
+    model_.getPosRight(ind_.side_num, ind_.side_col, ind_.side_row, dir_,
+                       ind_.side_num, ind_.side_col, ind_.side_row, dir_);
   }
   else if (key == Qt::Key_Down) {
-    getPosDown(ind_.side_num, ind_.side_col, ind_.side_row, dir_,
-               ind_.side_num, ind_.side_col, ind_.side_row, dir_);
+    model_.getPosDown(ind_.side_num, ind_.side_col, ind_.side_row, dir_,
+                      ind_.side_num, ind_.side_col, ind_.side_row, dir_);
   }
   else if (key == Qt::Key_Up) {
-    getPosUp(ind_.side_num, ind_.side_col, ind_.side_row, dir_,
-             ind_.side_num, ind_.side_col, ind_.side_row, dir_);
+    model_.getPosUp(ind_.side_num, ind_.side_col, ind_.side_row, dir_,
+                    ind_.side_num, ind_.side_col, ind_.side_row, dir_);
   }
   else
     return;
@@ -2463,270 +607,6 @@ movePosition(int key)
   getTwoD()->update(); getThreeD()->update();
 }
 
-const CRubikPiece &
-CQRubik::
-getPieceLeft(uint side_num, uint side_col, uint side_row) const
-{
-  uint side_num1, side_col1, side_row1;
-  int  dir1;
-
-  getPosLeft(side_num, side_col, side_row, 0, side_num1, side_col1, side_row1, dir1);
-
-  return sides_[side_num1].pieces[side_col1][side_row1];
-}
-
-const CRubikPiece &
-CQRubik::
-getPieceRight(uint side_num, uint side_col, uint side_row) const
-{
-  uint side_num1, side_col1, side_row1;
-  int  dir1;
-
-  getPosRight(side_num, side_col, side_row, 0, side_num1, side_col1, side_row1, dir1);
-
-  return sides_[side_num1].pieces[side_col1][side_row1];
-}
-
-const CRubikPiece &
-CQRubik::
-getPieceDown(uint side_num, uint side_col, uint side_row) const
-{
-  uint side_num1, side_col1, side_row1;
-  int  dir1;
-
-  getPosDown(side_num, side_col, side_row, 0, side_num1, side_col1, side_row1, dir1);
-
-  return sides_[side_num1].pieces[side_col1][side_row1];
-}
-
-const CRubikPiece &
-CQRubik::
-getPieceUp(uint side_num, uint side_col, uint side_row) const
-{
-  uint side_num1, side_col1, side_row1;
-  int  dir1;
-
-  getPosUp(side_num, side_col, side_row, 0, side_num1, side_col1, side_row1, dir1);
-
-  return sides_[side_num1].pieces[side_col1][side_row1];
-}
-
-void
-CQRubik::
-getPosLeft(uint side_num, uint side_col, uint side_row, int dir,
-           uint &side_num1, uint &side_col1, uint &side_row1, int &dir1) const
-{
-  side_num1 = side_num;
-  side_col1 = side_col;
-  side_row1 = side_row;
-  dir1      = dir;
-
-  const CRubikSide &side = sides_[side_num1];
-
-  if (side_col1 > 0)
-    --side_col1;
-  else {
-    side_num1 = side.side_l.side;
-
-    dir1 += side.side_l.rotate;
-
-    if (dir1 <= -180) dir1 += 360; else if (dir1 > 180) dir1 -= 360;
-
-    if      (dir1 ==   0)   side_col1 = 2;
-    else if (dir1 == 180) { side_col1 = 0; side_row1 = 2 - side_row1; }
-    else if (dir1 ==  90) { side_col1 = side_row1    ; side_row1 = 0; }
-    else if (dir1 == -90) { side_col1 = 2 - side_row1; side_row1 = 2; }
-  }
-
-  dir1 = 0;
-}
-
-void
-CQRubik::
-getPosRight(uint side_num, uint side_col, uint side_row, int dir,
-            uint &side_num1, uint &side_col1, uint &side_row1, int &dir1) const
-{
-  side_num1 = side_num;
-  side_col1 = side_col;
-  side_row1 = side_row;
-  dir1      = dir;
-
-  const CRubikSide &side = sides_[side_num1];
-
-  if (side_col1 < 2)
-    ++side_col1;
-  else {
-    side_num1 = side.side_r.side;
-
-    dir1 += side.side_r.rotate;
-
-    if (dir1 <= -180) dir1 += 360; else if (dir1 > 180) dir1 -= 360;
-
-    if      (dir1 ==   0)   side_col1 = 0;
-    else if (dir1 == 180) { side_col1 = 2; side_row1 = 2 - side_row1; }
-    else if (dir1 ==  90) { side_col1 = side_row1    ; side_row1 = 2; }
-    else if (dir1 == -90) { side_col1 = 2 - side_row1; side_row1 = 0; }
-  }
-
-  dir1 = 0;
-}
-
-void
-CQRubik::
-getPosDown(uint side_num, uint side_col, uint side_row, int dir,
-           uint &side_num1, uint &side_col1, uint &side_row1, int &dir1) const
-{
-  side_num1 = side_num;
-  side_col1 = side_col;
-  side_row1 = side_row;
-  dir1      = dir;
-
-  const CRubikSide &side = sides_[side_num1];
-
-  if      (dir1 == 0) {
-    if (side_row1 < 2)
-      ++side_row1;
-    else {
-      side_num1 = side.side_d.side;
-
-      dir1 += side.side_d.rotate;
-
-      if (dir1 <= -180) dir1 += 360; else if (dir1 > 180) dir1 -= 360;
-
-      if      (dir1 ==   0)   side_row1 = 0;
-      else if (dir1 == 180) { side_row1 = 2; side_col1 = 2 - side_col1; }
-      else if (dir1 ==  90) { side_row1 = 2 - side_col1; side_col1 = 0; }
-      else if (dir1 == -90) { side_row1 = side_col1    ; side_col1 = 2; }
-    }
-  }
-  else if (dir1 == 180) {
-    if (side_row1 > 0)
-      --side_row1;
-    else {
-      side_num1 = side.side_u.side;
-
-      dir1 += side.side_u.rotate;
-
-      if (dir1 <= -180) dir1 += 360; else if (dir1 > 180) dir1 -= 360;
-
-      if      (dir1 ==   0) { side_row1 = 0; side_col1 = 2 - side_col1; }
-      else if (dir1 == 180)   side_row1 = 2;
-      else if (dir1 ==  90) { side_row1 =     side_col1; side_col1 = 0; }
-      else if (dir1 == -90) { side_row1 = 2 - side_col1; side_col1 = 2; }
-    }
-  }
-  else if (dir1 == 90) {
-    if (side_col1 < 2)
-      ++side_col1;
-    else {
-      side_num1 = side.side_r.side;
-
-      dir1 += side.side_r.rotate;
-
-      if (dir1 <= -180) dir1 += 360; else if (dir1 > 180) dir1 -= 360;
-
-      if      (dir1 ==  90)   side_col1 = 0;
-      else if (dir1 == -90)   side_col1 = 2;
-      else if (dir1 ==   0) { side_col1 = 2 - side_row1; side_row1 = 0; }
-      else if (dir1 == 180) { side_col1 =     side_row1; side_row1 = 2; }
-    }
-  }
-  else if (dir1 == -90) {
-    if (side_col1 > 0)
-      --side_col1;
-    else {
-      side_num1 = side.side_l.side;
-
-      dir1 += side.side_l.rotate;
-
-      if (dir1 <= -180) dir1 += 360; else if (dir1 > 180) dir1 -= 360;
-
-      if      (dir1 ==  90)   side_col1 = 0;
-      else if (dir1 == -90)   side_col1 = 2;
-      else if (dir1 ==   0) { side_col1 =     side_row1; side_row1 = 0; }
-      else if (dir1 == 180) { side_col1 = 2 - side_row1; side_row1 = 2; }
-    }
-  }
-}
-
-void
-CQRubik::
-getPosUp(uint side_num, uint side_col, uint side_row, int dir,
-         uint &side_num1, uint &side_col1, uint &side_row1, int &dir1) const
-{
-  side_num1 = side_num;
-  side_col1 = side_col;
-  side_row1 = side_row;
-  dir1      = dir;
-
-  const CRubikSide &side = sides_[side_num1];
-
-  if      (dir1 == 0) {
-    if (side_row1 > 0)
-      --side_row1;
-    else {
-      side_num1 = side.side_u.side;
-
-      dir1 += side.side_u.rotate;
-
-      if  (dir1 <= -180) dir1 += 360; else if (dir1 > 180) dir1 -= 360;
-
-      if      (dir1 ==   0)   side_row1 = 2;
-      else if (dir1 == 180) { side_row1 = 0; side_col1 = 2 - side_col1; }
-      else if (dir1 ==  90) { side_row1 = 2 - side_col1; side_col1 = 2; }
-      else if (dir1 == -90) { side_row1 =     side_col1; side_col1 = 0; }
-    }
-  }
-  else if (dir1 == 180) {
-    if (side_row1 < 2)
-      ++side_row1;
-    else {
-      side_num1 = side.side_d.side;
-
-      dir1 += side.side_d.rotate;
-
-      if (dir1 <= -180) dir1 += 360; else if (dir1 > 180) dir1 -= 360;
-
-      if      (dir1 ==   0) { side_row1 = 2; side_col1 = 2 - side_col1; }
-      else if (dir1 == 180)   side_row1 = 0;
-      else if (dir1 ==  90) { side_row1 =     side_col1; side_col1 = 2; }
-      else if (dir1 == -90) { side_row1 = 2 - side_col1; side_col1 = 0; }
-    }
-  }
-  else if (dir1 == 90) {
-    if (side_col1 > 0)
-      --side_col1;
-    else {
-      side_num1 = side.side_l.side;
-
-      dir1 += side.side_l.rotate;
-
-      if (dir1 <= -180) dir1 += 360; else if (dir1 > 180) dir1 -= 360;
-
-      if      (dir1 ==  90)   side_col1 = 2;
-      else if (dir1 == -90)   side_col1 = 0;
-      else if (dir1 ==   0) { side_col1 = 2 - side_row1; side_row1 = 2; }
-      else if (dir1 == 180) { side_col1 =     side_row1; side_row1 = 0; }
-    }
-  }
-  else if (dir1 == -90) {
-    if (side_col1 < 2)
-      ++side_col1;
-    else {
-      side_num1 = side.side_r.side;
-
-      dir1 += side.side_r.rotate;
-
-      if (dir1 <= -180) dir1 += 360; else if (dir1 > 180) dir1 -= 360;
-
-      if      (dir1 ==  90)   side_col1 = 2;
-      else if (dir1 == -90)   side_col1 = 0;
-      else if (dir1 ==   0) { side_col1 =     side_row1; side_row1 = 2; }
-      else if (dir1 == 180) { side_col1 = 2 - side_row1; side_row1 = 0; }
-    }
-  }
-}
-
 void
 CQRubik::
 movePieces(int key)
@@ -2777,109 +657,13 @@ moveSides(int key)
   getTwoD()->update(); getThreeD()->update();
 }
 
-void
-CQRubik::
-execute(const std::string &moveStr)
-{
-  // syntax:
-  //  <side> (F,B,U,D,L,R) [']
-
-  CStrParse parse(moveStr);
-
-  parse.skipSpace();
-
-  char side;
-
-  while (! parse.readChar(&side)) {
-    bool clockwise = true;
-    uint turns     = 1;
-
-    if      (parse.isChar('\''))
-      clockwise = false;
-    else if (parse.isChar('2'))
-      turns = 2;
-
-    uint iside;
-
-    if (! decodeSideChar(side, iside))
-      return;
-
-    if      (turns == 1)
-      rotateSide(iside, clockwise);
-    else
-      rotateSide2(iside);
-
-    parse.skipSpace();
-  }
-}
-
-bool
-CQRubik::
-decodeSideChar(char c, uint &n)
-{
-  static std::string sides = "LUFDRB";
-
-  std::string::size_type iside = sides.find(c);
-
-  if (iside == std::string::npos) return false;
-
-  n = iside;
-
-  return true;
-}
-
-bool
-CQRubik::
-encodeSideChar(uint n, char &c)
-{
-  static std::string sides = "LUFDRB";
-
-  if (n >= 6) return false;
-
-  c = sides[n];
-
-  return true;
-}
-
-void
-CQRubik::
-moveSideLeft2(uint side_num, uint side_row)
-{
-  moveSideLeft(side_num, side_row);
-  moveSideLeft(side_num, side_row);
-}
-
-void
-CQRubik::
-moveSideRight2(uint side_num, uint side_row)
-{
-  moveSideRight(side_num, side_row);
-  moveSideRight(side_num, side_row);
-}
-
-void
-CQRubik::
-moveSideDown2(uint side_num, uint side_row)
-{
-  moveSideDown(side_num, side_row);
-  moveSideDown(side_num, side_row);
-}
-
-void
-CQRubik::
-moveSideUp2(uint side_num, uint side_row)
-{
-  moveSideUp(side_num, side_row);
-  moveSideUp(side_num, side_row);
-}
-
 void
 CQRubik::
 moveSideLeft(uint side_num, uint side_row)
 {
   int side_num1 = side_num;
 
-  CRubikSide &side1 = sides_[side_num1];
+  const CRubikSideData &side1 = CRubikModel::getSideData(side_num1);
 
   if      (side_row == 0) {
     int tside_num = side1.side_u.side;
@@ -2896,9 +680,9 @@ moveSideLeft(uint side_num, uint side_row)
       return;
     }
 
-    moveSideLeft1(side_num, side_row);
+    finishAnimation();
 
-    undo_->addUndo(new CQRubikUndoMoveData(this, side_num, 'L', side_row));
+    model_.moveSideLeft(side_num, side_row);
   }
   else if (side_row == 2) {
     int bside_num = side1.side_d.side;
@@ -2913,7 +697,7 @@ moveSideRight(uint side_num, uint side_row)
 {
   int side_num1 = side_num;
 
-  CRubikSide &side1 = sides_[side_num1];
+  const CRubikSideData &side1 = CRubikModel::getSideData(side_num1);
 
   if      (side_row == 0) {
     int tside_num = side1.side_u.side;
@@ -2930,9 +714,9 @@ moveSideRight(uint side_num, uint side_row)
       return;
     }
 
-    moveSideRight1(side_num, side_row);
+    finishAnimation();
 
-    undo_->addUndo(new CQRubikUndoMoveData(this, side_num, 'R', side_row));
+    model_.moveSideRight(side_num, side_row);
   }
   else if (side_row == 2) {
     int bside_num = side1.side_d.side;
@@ -2947,7 +731,7 @@ moveSideDown(uint side_num, uint side_col)
 {
   int side_num1 = side_num;
 
-  CRubikSide &side1 = sides_[side_num1];
+  const CRubikSideData &side1 = CRubikModel::getSideData(side_num1);
 
   if      (side_col == 0) {
     uint lside_num = side1.side_l.side;
@@ -2966,9 +750,9 @@ moveSideDown(uint side_num, uint side_col)
       return;
     }
 
-    moveSideDown1(side_num, side_col);
+    finishAnimation();
 
-    undo_->addUndo(new CQRubikUndoMoveData(this, side_num, 'D', side_col));
+    model_.moveSideDown(side_num, side_col);
   }
   else if (side_col == 2) {
     uint rside_num = side1.side_r.side;
@@ -2983,7 +767,7 @@ moveSideUp(uint side_num, uint side_col)
 {
   int side_num1 = side_num;
 
-  CRubikSide &side1 = sides_[side_num1];
+  const CRubikSideData &side1 = CRubikModel::getSideData(side_num1);
 
   if      (side_col == 0) {
     uint lside_num = side1.side_l.side;
@@ -3002,9 +786,9 @@ moveSideUp(uint side_num, uint side_col)
       return;
     }
 
-    moveSideUp1(side_num, side_col);
+    finishAnimation();
 
-    undo_->addUndo(new CQRubikUndoMoveData(this, side_num, 'U', side_col));
+    model_.moveSideUp(side_num, side_col);
   }
   else if (side_col == 2) {
     uint rside_num = side1.side_r.side;
@@ -3013,14 +797,6 @@ moveSideUp(uint side_num, uint side_col)
   }
 }
 
-void
-CQRubik::
-rotateSide2(uint side_num)
-{
-  rotateSide(side_num, true);
-  rotateSide(side_num, true);
-}
-
 void
 CQRubik::
 rotateSide(uint side_num, bool clockwise)
@@ -3029,882 +805,444 @@ rotateSide(uint side_num, bool clockwise)
     animateRotateSide(side_num, clockwise);
     return;
   }
-
-  if (clockwise) {
-    rotateSide1(side_num, true);
-
-    CRubikSide &side = sides_[side_num];
-
-    if      (side.side_l.rotate == 0)
-      moveSideDown1(side.side_l.side, 2);
-    else if (side.side_r.rotate == 0)
-      moveSideUp1  (side.side_r.side, 0);
-    else if (side.side_d.rotate == 0)
-      moveSideRight1(side.side_d.side, 0);
-    else if (side.side_u.rotate == 0)
-      moveSideLeft1(side.side_u.side, 2);
-  }
-  else {
-    rotateSide1(side_num, false);
-
-    CRubikSide &side = sides_[side_num];
-
-    if      (side.side_l.rotate == 0)
-      moveSideUp1  (side.side_l.side, 2);
-    else if (side.side_r.rotate == 0)
-      moveSideDown1(side.side_r.side, 0);
-    else if (side.side_d.rotate == 0)
-      moveSideLeft1(side.side_d.side, 0);
-    else if (side.side_u.rotate == 0)
-      moveSideRight1(side.side_u.side, 2);
-  }
-
-  undo_->addUndo(new CQRubikUndoRotateData(this, side_num, clockwise));
-}
-
-void
-CQRubik::
-animateRotateSide(uint side_num, bool clockwise)
-{
-  animateData_.side_num  = side_num;
-  animateData_.clockwise = clockwise;
-  animateData_.axis      = false;
-  animateData_.step      = 0;
-
-  animateData_.animating = true;
-
-  animateRotateSideSlot();
-}
-
-void
-CQRubik::
-animateRotateMiddleX(bool clockwise)
-{
-  animateData_.side_num  = 0;
-  animateData_.clockwise = clockwise;
-  animateData_.axis      = true;
-  animateData_.step      = 0;
-
-  animateData_.animating = true;
-
-  animateRotateSideSlot();
-}
-
-void
-CQRubik::
-animateRotateMiddleY(bool clockwise)
-{
-  animateData_.side_num  = 1;
-  animateData_.clockwise = clockwise;
-  animateData_.axis      = true;
-  animateData_.step      = 0;
-
-  animateData_.animating = true;
-
-  animateRotateSideSlot();
-}
-
-void
-CQRubik::
-animateRotateMiddleZ(bool clockwise)
-{
-  animateData_.side_num  = 2;
-  animateData_.clockwise = clockwise;
-  animateData_.axis      = true;
-  animateData_.step      = 0;
-
-  animateData_.animating = true;
-
-  animateRotateSideSlot();
-}
-
-void
-CQRubik::
-animateRotateSideSlot()
-{
-  getTwoD()->update(); getThreeD()->update();
-
-  ++animateData_.step;
-
-  uint num = 10;
-
-  if (animateData_.step <= num)
-    QTimer::singleShot(50, this, SLOT(animateRotateSideSlot()));
-  else {
-    animateData_.animating = false;
-
-    setAnimate(false);
-
-    if      (! animateData_.axis)
-      rotateSide(animateData_.side_num, animateData_.clockwise);
-    else if (animateData_.side_num == 0) {
-      if (! animateData_.clockwise)
-        moveSideLeft (2, 1);
-      else
-        moveSideRight(2, 1);
-    }
-    else if (animateData_.side_num == 1) {
-      if (animateData_.clockwise)
-        moveSideUp  (0, 1);
-      else
-        moveSideDown(0, 1);
-    }
-    else if (animateData_.side_num == 2) {
-      if (animateData_.clockwise)
-        moveSideUp  (2, 1);
-      else
-        moveSideDown(2, 1);
-    }
-
-    setAnimate(true);
-  }
+
+  finishAnimation();
+
+  model_.rotateSide(side_num, clockwise);
 }
 
 void
 CQRubik::
-waitAnimate()
+applyMove(uint move)
 {
-  while (animateData_.animating) {
-    QApplication::processEvents();
+  if (getAnimate()) {
+    animateMove(move);
+    return;
   }
+
+  finishAnimation();
+
+  model_.applyMove(move);
 }
 
+// add move to undo log and queue its animation
 void
 CQRubik::
-moveSidesLeft()
+animateMove(uint move)
 {
-  moveSideLeft(2, 0);
-  moveSideLeft(2, 1);
-  moveSideLeft(2, 2);
+  undo_.addMove(move);
+
+  updateHistory();
+
+  queueMove(move);
 }
 
 void
 CQRubik::
-moveSidesRight()
+animateRotateSide(uint side_num, bool clockwise)
 {
-  moveSideRight(2, 0);
-  moveSideRight(2, 1);
-  moveSideRight(2, 2);
+  animateMove(CRubikMove::faceMove(side_num, clockwise));
 }
 
 void
 CQRubik::
-moveSidesDown()
+animateRotateMiddleX(bool clockwise)
 {
-  moveSideDown(2, 0);
-  moveSideDown(2, 1);
-  moveSideDown(2, 2);
+  animateMove(CRubikMove::move(CRubikMove::BASE_E,
+    clockwise ? CRubikMove::TURN_CW : CRubikMove::TURN_CCW));
 }
 
 void
 CQRubik::
-moveSidesUp()
+animateRotateMiddleY(bool clockwise)
 {
-  moveSideUp(2, 0);
-  moveSideUp(2, 1);
-  moveSideUp(2, 2);
+  animateMove(CRubikMove::move(CRubikMove::BASE_S,
+    clockwise ? CRubikMove::TURN_CW : CRubikMove::TURN_CCW));
 }
 
 void
 CQRubik::
-moveSideLeft1(uint side_num, uint side_row)
+animateRotateMiddleZ(bool clockwise)
 {
-  uint side_num1 = side_num;
-
-  int dir1 = 0, dir2, dir3, dir4;
-
-  int side_num2, side_num3, side_num4;
-
-  side_num2 = sides_[side_num1].side_l.side; dir2 = dir1 + sides_[side_num1].side_l.rotate;
-
-  if (dir2 <= -180) dir2 += 360; else if (dir2 > 180) dir2 -= 360;
-
-  if      (dir2 == 0) {
-    side_num3 = sides_[side_num2].side_l.side; dir3 = dir2 + sides_[side_num2].side_l.rotate;
-  }
-  else if (dir2 == 90) {
-    side_num3 = sides_[side_num2].side_d.side; dir3 = dir2 + sides_[side_num2].side_d.rotate;
-  }
-  else if (dir2 == -90) {
-    side_num3 = sides_[side_num2].side_u.side; dir3 = dir2 + sides_[side_num2].side_u.rotate;
-  }
-  else {
-    side_num3 = sides_[side_num2].side_r.side; dir3 = dir2 + sides_[side_num2].side_r.rotate;
-  }
-
-  if (dir3 <= -180) dir3 += 360; else if (dir3 > 180) dir3 -= 360;
-
-  if      (dir3 == 0) {
-    side_num4 = sides_[side_num3].side_l.side; dir4 = dir3 + sides_[side_num3].side_l.rotate;
-  }
-  else if (dir3 == 90) {
-    side_num4 = sides_[side_num3].side_d.side; dir4 = dir3 + sides_[side_num3].side_d.rotate;
-  }
-  else if (dir3 == -90) {
-    side_num4 = sides_[side_num3].side_u.side; dir4 = dir3 + sides_[side_num3].side_u.rotate;
-  }
-  else {
-    side_num4 = sides_[side_num3].side_r.side; dir4 = dir3 + sides_[side_num3].side_r.rotate;
-  }
-
-  if (dir4 <= -180) dir4 += 360; else if (dir4 > 180) dir4 -= 360;
-
-  CRubikSide &side1 = sides_[side_num1];
-  CRubikSide &side2 = sides_[side_num2];
-  CRubikSide &side3 = sides_[side_num3];
-  CRubikSide &side4 = sides_[side_num4];
+  animateMove(CRubikMove::move(CRubikMove::BASE_M,
+    clockwise ? CRubikMove::TURN_CCW : CRubikMove::TURN_CW));
+}
 
-  CRubikPiece t[15];
+// queue move animation (merged with last queued move if same face or slice)
+void
+CQRubik::
+queueMove(uint move)
+{
+  uint base = CRubikMove::base(move);
 
-  uint j = 0;
+  if (! animateQueue_.empty() && CRubikMove::base(animateQueue_.back()) == base) {
+    // sum of quarter turns (turn + 1)
+    uint turns = (CRubikMove::turn(animateQueue_.back()) + CRubikMove::turn(move) + 2) % 4;
 
-  for (uint i = 0; i < 3; ++i, ++j)
-    t[j] = side1.pieces[2 - i][side_row];
+    animateQueue_.pop_back();
 
-  for (uint i = 0; i < 3; ++i, ++j) {
-    if      (dir2 ==   0) t[j] = side2.pieces[       2 - i][    side_row];
-    else if (dir2 ==  90) t[j] = side2.pieces[    side_row][           i];
-    else if (dir2 == 180) t[j] = side2.pieces[           i][2 - side_row];
-    else                  t[j] = side2.pieces[2 - side_row][       2 - i];
+    if (turns > 0)
+      animateQueue_.push_back(CRubikMove::move(base, turns - 1));
   }
+  else
+    animateQueue_.push_back(move);
 
-  for (uint i = 0; i < 3; ++i, ++j) {
-    if      (dir3 ==   0) t[j] = side3.pieces[       2 - i][    side_row];
-    else if (dir3 ==  90) t[j] = side3.pieces[    side_row][           i];
-    else if (dir3 == 180) t[j] = side3.pieces[           i][2 - side_row];
-    else                  t[j] = side3.pieces[2 - side_row][       2 - i];
-  }
+  if (! animateData_.animating) {
+    if (! startNextMove())
+      return;
 
-  for (uint i = 0; i < 3; ++i, ++j) {
-    if      (dir4 ==   0) t[j] = side4.pieces[       2 - i][    side_row];
-    else if (dir4 ==  90) t[j] = side4.pieces[    side_row][           i];
-    else if (dir4 == 180) t[j] = side4.pieces[           i][2 - side_row];
-    else                  t[j] = side4.pieces[2 - side_row][       2 - i];
+    getTwoD()->update(); getThreeD()->update();
   }
 
-  //----
-
-  for (int i = 11; i >= 0; --i)
-    t[i + 3] = t[i];
-
-  for (uint i = 12; i < 15; ++i)
-    t[i - 12] = t[i];
-
-  //----
+  if (! animateTimer_->isActive())
+    animateTimer_->start();
+}
 
-  j = 0;
+// start animation of next queued move (moves which can't be animated are applied)
+bool
+CQRubik::
+startNextMove()
+{
+  while (! animateQueue_.empty()) {
+    uint move = animateQueue_.front();
 
-  for (uint i = 0; i < 3; ++i, ++j)
-    side1.pieces[2 - i][side_row] = t[j];
+    animateQueue_.pop_front();
 
-  for (uint i = 0; i < 3; ++i, ++j) {
-    if      (dir2 ==   0) side2.pieces[       2 - i][    side_row] = t[j];
-    else if (dir2 ==  90) side2.pieces[    side_row][           i] = t[j];
-    else if (dir2 == 180) side2.pieces[           i][2 - side_row] = t[j];
-    else                  side2.pieces[2 - side_row][       2 - i] = t[j];
-  }
+    if (startAnimation(move))
+      return true;
 
-  for (uint i = 0; i < 3; ++i, ++j) {
-    if      (dir3 ==   0) side3.pieces[       2 - i][    side_row] = t[j];
-    else if (dir3 ==  90) side3.pieces[    side_row][           i] = t[j];
-    else if (dir3 == 180) side3.pieces[           i][2 - side_row] = t[j];
-    else                  side3.pieces[2 - side_row][       2 - i] = t[j];
+    // whole cube rotations are not animated
+    commitMove(move);
   }
 
-  for (uint i = 0; i < 3; ++i, ++j) {
-    if      (dir4 ==   0) side4.pieces[       2 - i][    side_row] = t[j];
-    else if (dir4 ==  90) side4.pieces[    side_row][           i] = t[j];
-    else if (dir4 == 180) side4.pieces[           i][2 - side_row] = t[j];
-    else                  side4.pieces[2 - side_row][       2 - i] = t[j];
-  }
+  return false;
 }
 
-void
+// set animate data for move
+bool
 CQRubik::
-moveSideRight1(uint side_num, uint side_row)
+startAnimation(uint move)
 {
-  uint side_num1 = side_num;
-
-  int dir1 = 0, dir2, dir3, dir4;
-
-  int side_num2, side_num3, side_num4;
-
-  side_num2 = sides_[side_num1].side_r.side; dir2 = dir1 + sides_[side_num1].side_r.rotate;
-
-  if (dir2 <= -180) dir2 += 360; else if (dir2 > 180) dir2 -= 360;
-
-  if      (dir2 == 0) {
-    side_num3 = sides_[side_num2].side_r.side; dir3 = dir2 + sides_[side_num2].side_r.rotate;
-  }
-  else if (dir2 == 90) {
-    side_num3 = sides_[side_num2].side_u.side; dir3 = dir2 + sides_[side_num2].side_u.rotate;
-  }
-  else if (dir2 == -90) {
-    side_num3 = sides_[side_num2].side_d.side; dir3 = dir2 + sides_[side_num2].side_d.rotate;
-  }
-  else {
-    side_num3 = sides_[side_num2].side_l.side; dir3 = dir2 + sides_[side_num2].side_l.rotate;
-  }
+  uint base = CRubikMove::base(move);
+  uint turn = CRubikMove::turn(move);
 
-  if (dir3 <= -180) dir3 += 360; else if (dir3 > 180) dir3 -= 360;
+  // rotateSide direction (half turns are turned clockwise)
+  bool clockwise = (turn != CRubikMove::TURN_CW);
 
-  if      (dir3 == 0) {
-    side_num4 = sides_[side_num3].side_r.side; dir4 = dir3 + sides_[side_num3].side_r.rotate;
+  if      (CRubikMove::isFaceMove(move)) {
+    animateData_.side_num  = base;
+    animateData_.clockwise = clockwise;
+    animateData_.axis      = false;
   }
-  else if (dir3 == 90) {
-    side_num4 = sides_[side_num3].side_u.side; dir4 = dir3 + sides_[side_num3].side_u.rotate;
+  else if (base == CRubikMove::BASE_E) {
+    animateData_.side_num  = 0;
+    animateData_.clockwise = ! clockwise;
+    animateData_.axis      = true;
   }
-  else if (dir3 == -90) {
-    side_num4 = sides_[side_num3].side_d.side; dir4 = dir3 + sides_[side_num3].side_d.rotate;
-  }
-  else {
-    side_num4 = sides_[side_num3].side_l.side; dir4 = dir3 + sides_[side_num3].side_l.rotate;
-  }
-
-  if (dir4 <= -180) dir4 += 360; else if (dir4 > 180) dir4 -= 360;
-
-  CRubikSide &side1 = sides_[side_num1];
-  CRubikSide &side2 = sides_[side_num2];
-  CRubikSide &side3 = sides_[side_num3];
-  CRubikSide &side4 = sides_[side_num4];
-
-  CRubikPiece t[15];
-
-  uint j = 0;
-
-  for (uint i = 0; i < 3; ++i, ++j)
-    t[j] = side1.pieces[i][side_row];
-
-  for (uint i = 0; i < 3; ++i, ++j) {
-    if      (dir2 ==   0) t[j] = side2.pieces[           i][    side_row];
-    else if (dir2 ==  90) t[j] = side2.pieces[    side_row][       2 - i];
-    else if (dir2 == 180) t[j] = side2.pieces[       2 - i][2 - side_row];
-    else                  t[j] = side2.pieces[2 - side_row][           i];
+  else if (base == CRubikMove::BASE_S) {
+    animateData_.side_num  = 1;
+    animateData_.clockwise = ! clockwise;
+    animateData_.axis      = true;
   }
-
-  for (uint i = 0; i < 3; ++i, ++j) {
-    if      (dir3 ==   0) t[j] = side3.pieces[           i][    side_row];
-    else if (dir3 ==  90) t[j] = side3.pieces[    side_row][       2 - i];
-    else if (dir3 == 180) t[j] = side3.pieces[       2 - i][2 - side_row];
-    else                  t[j] = side3.pieces[2 - side_row][           i];
+  else if (base == CRubikMove::BASE_M) {
+    animateData_.side_num  = 2;
+    animateData_.clockwise = clockwise;
+    animateData_.axis      = true;
   }
+  else
+    return false;
 
-  for (uint i = 0; i < 3; ++i, ++j) {
-    if      (dir4 ==   0) t[j] = side4.pieces[           i][    side_row];
-    else if (dir4 ==  90) t[j] = side4.pieces[    side_row][       2 - i];
-    else if (dir4 == 180) t[j] = side4.pieces[       2 - i][2 - side_row];
-    else                  t[j] = side4.pieces[2 - side_row][           i];
-  }
+  // half turns take 1.5 times as long and all turns are shortened when moves are
+  // waiting (but last at least MIN_TURN_TIME)
+  bool half = (turn == CRubikMove::TURN_2);
 
-  //----
+  double duration = (half ? 1.5 : 1.0)*getTurnTime()/(1.0 + animateQueue_.size()/2.0);
 
-  for (int i = 11; i >= 0; --i)
-    t[i + 3] = t[i];
+  animateData_.move      = move;
+  animateData_.angle     = 0.0;
+  animateData_.end_angle = (half ? 180.0 : 90.0);
+  animateData_.duration  = std::max(duration, double(MIN_TURN_TIME));
 
-  for (uint i = 12; i < 15; ++i)
-    t[i - 12] = t[i];
+  animateData_.start_time = double(animateTime_.elapsed());
 
-  //----
+  animateData_.animating = true;
 
-  j = 0;
+  return true;
+}
 
-  for (uint i = 0; i < 3; ++i, ++j)
-    side1.pieces[i][side_row] = t[j];
+// apply animated move to model (it is already in the undo log)
+void
+CQRubik::
+commitMove(uint move)
+{
+  record_ = false;
 
-  for (uint i = 0; i < 3; ++i, ++j) {
-    if      (dir2 ==   0) side2.pieces[           i][    side_row] = t[j];
-    else if (dir2 ==  90) side2.pieces[    side_row][       2 - i] = t[j];
-    else if (dir2 == 180) side2.pieces[       2 - i][2 - side_row] = t[j];
-    else                  side2.pieces[2 - side_row][           i] = t[j];
-  }
+  model_.applyMove(move);
 
-  for (uint i = 0; i < 3; ++i, ++j) {
-    if      (dir3 ==   0) side3.pieces[           i][    side_row] = t[j];
-    else if (dir3 ==  90) side3.pieces[    side_row][       2 - i] = t[j];
-    else if (dir3 == 180) side3.pieces[       2 - i][2 - side_row] = t[j];
-    else                  side3.pieces[2 - side_row][           i] = t[j];
-  }
+  record_ = true;
 
-  for (uint i = 0; i < 3; ++i, ++j) {
-    if      (dir4 ==   0) side4.pieces[           i][    side_row] = t[j];
-    else if (dir4 ==  90) side4.pieces[    side_row][       2 - i] = t[j];
-    else if (dir4 == 180) side4.pieces[       2 - i][2 - side_row] = t[j];
-    else                  side4.pieces[2 - side_row][           i] = t[j];
-  }
+  emit moveFinished(move);
 }
 
 void
 CQRubik::
-moveSideDown1(uint side_num, uint side_col)
+animateTimerSlot()
 {
-  uint side_num1 = side_num;
+  double t = double(animateTime_.elapsed());
 
-  int dir1 = 0, dir2, dir3, dir4;
+  // apply finished moves (next move starts when the previous one ended so speed does
+  // not depend on the frame rate)
+  while (animateData_.animating &&
+         t >= animateData_.start_time + animateData_.duration) {
+    double end_time = animateData_.start_time + animateData_.duration;
 
-  int side_num2, side_num3, side_num4;
-
-  side_num2 = sides_[side_num1].side_d.side; dir2 = dir1 + sides_[side_num1].side_d.rotate;
+    animateData_.animating = false;
 
-  if (dir2 <= -180) dir2 += 360; else if (dir2 > 180) dir2 -= 360;
+    commitMove(animateData_.move);
 
-  if      (dir2 == 0) {
-    side_num3 = sides_[side_num2].side_d.side; dir3 = dir2 + sides_[side_num2].side_d.rotate;
-  }
-  else if (dir2 == -90) {
-    side_num3 = sides_[side_num2].side_l.side; dir3 = dir2 + sides_[side_num2].side_l.rotate;
-  }
-  else if (dir2 == 90) {
-    side_num3 = sides_[side_num2].side_r.side; dir3 = dir2 + sides_[side_num2].side_r.rotate;
-  }
-  else {
-    side_num3 = sides_[side_num2].side_u.side; dir3 = dir2 + sides_[side_num2].side_u.rotate;
+    if (startNextMove())
+      animateData_.start_time = end_time;
   }
 
-  if (dir3 <= -180) dir3 += 360; else if (dir3 > 180) dir3 -= 360;
+  if (animateData_.animating) {
+    double f = (t - animateData_.start_time)/animateData_.duration;
 
-  if      (dir3 == 0) {
-    side_num4 = sides_[side_num3].side_d.side; dir4 = dir3 + sides_[side_num3].side_d.rotate;
+    // ease in and out
+    animateData_.angle = animateData_.end_angle*f*f*(3.0 - 2.0*f);
   }
-  else if (dir3 == -90) {
-    side_num4 = sides_[side_num3].side_l.side; dir4 = dir3 + sides_[side_num3].side_l.rotate;
-  }
-  else if (dir3 == 90) {
-    side_num4 = sides_[side_num3].side_r.side; dir4 = dir3 + sides_[side_num3].side_r.rotate;
-  }
-  else {
-    side_num4 = sides_[side_num3].side_u.side; dir4 = dir3 + sides_[side_num3].side_u.rotate;
-  }
-
-  if (dir4 <= -180) dir4 += 360; else if (dir4 > 180) dir4 -= 360;
-
-  CRubikSide &side1 = sides_[side_num1];
-  CRubikSide &side2 = sides_[side_num2];
-  CRubikSide &side3 = sides_[side_num3];
-  CRubikSide &side4 = sides_[side_num4];
-
-  CRubikPiece t[15];
-
-  uint j = 0;
+  else
+    animateTimer_->stop();
 
-  for (uint i = 0; i < 3; ++i, ++j)
-    t[j] = side1.pieces[side_col][i];
+  getTwoD()->update(); getThreeD()->update();
+}
 
-  for (uint i = 0; i < 3; ++i, ++j) {
-    if      (dir2 ==   0) t[j] = side2.pieces[    side_col][           i];
-    else if (dir2 ==  90) t[j] = side2.pieces[           i][2 - side_col];
-    else if (dir2 == 180) t[j] = side2.pieces[2 - side_col][       2 - i];
-    else                  t[j] = side2.pieces[       2 - i][    side_col];
-  }
+// apply current and queued moves without animation
+void
+CQRubik::
+finishAnimation()
+{
+  if (! isAnimating())
+    return;
 
-  for (uint i = 0; i < 3; ++i, ++j) {
-    if      (dir3 ==   0) t[j] = side3.pieces[    side_col][           i];
-    else if (dir3 ==  90) t[j] = side3.pieces[           i][2 - side_col];
-    else if (dir3 == 180) t[j] = side3.pieces[2 - side_col][       2 - i];
-    else                  t[j] = side3.pieces[       2 - i][    side_col];
-  }
+  if (animateData_.animating) {
+    animateData_.animating = false;
 
-  for (uint i = 0; i < 3; ++i, ++j) {
-    if      (dir4 ==   0) t[j] = side4.pieces[    side_col][           i];
-    else if (dir4 ==  90) t[j] = side4.pieces[           i][2 - side_col];
-    else if (dir4 == 180) t[j] = side4.pieces[2 - side_col][       2 - i];
-    else                  t[j] = side4.pieces[       2 - i][    side_col];
+    commitMove(animateData_.move);
   }
 
-  //----
+  while (! animateQueue_.empty()) {
+    uint move = animateQueue_.front();
 
-  for (int i = 11; i >= 0; --i)
-    t[i + 3] = t[i];
+    animateQueue_.pop_front();
 
-  for (uint i = 12; i < 15; ++i)
-    t[i - 12] = t[i];
+    commitMove(move);
+  }
 
-  //----
+  animateTimer_->stop();
 
-  j = 0;
+  getTwoD()->update(); getThreeD()->update();
+}
 
-  for (uint i = 0; i < 3; ++i, ++j)
-    side1.pieces[side_col][i] = t[j];
+void
+CQRubik::
+moveSidesLeft()
+{
+  moveSideLeft(2, 0);
+  moveSideLeft(2, 1);
+  moveSideLeft(2, 2);
+}
 
-  for (uint i = 0; i < 3; ++i, ++j) {
-    if      (dir2 ==   0) side2.pieces[    side_col][           i] = t[j];
-    else if (dir2 ==  90) side2.pieces[           i][2 - side_col] = t[j];
-    else if (dir2 == 180) side2.pieces[2 - side_col][       2 - i] = t[j];
-    else                  side2.pieces[       2 - i][    side_col] = t[j];
-  }
+void
+CQRubik::
+moveSidesRight()
+{
+  moveSideRight(2, 0);
+  moveSideRight(2, 1);
+  moveSideRight(2, 2);
+}
 
-  for (uint i = 0; i < 3; ++i, ++j) {
-    if      (dir3 ==   0) side3.pieces[    side_col][           i] = t[j];
-    else if (dir3 ==  90) side3.pieces[           i][2 - side_col] = t[j];
-    else if (dir3 == 180) side3.pieces[2 - side_col][       2 - i] = t[j];
-    else                  side3.pieces[       2 - i][    side_col] = t[j];
-  }
+void
+CQRubik::
+moveSidesDown()
+{
+  moveSideDown(2, 0);
+  moveSideDown(2, 1);
+  moveSideDown(2, 2);
+}
 
-  for (uint i = 0; i < 3; ++i, ++j) {
-    if      (dir4 ==   0) side4.pieces[    side_col][           i] = t[j];
-    else if (dir4 ==  90) side4.pieces[           i][2 - side_col] = t[j];
-    else if (dir4 == 180) side4.pieces[2 - side_col][       2 - i] = t[j];
-    else                  side4.pieces[       2 - i][    side_col] = t[j];
-  }
+void
+CQRubik::
+moveSidesUp()
+{
+  moveSideUp(2, 0);
+  moveSideUp(2, 1);
+  moveSideUp(2, 2);
 }
 
 void
 CQRubik::
-moveSideUp1(uint side_num, uint side_col)
+moveApplied(uint move)
 {
-  uint side_num1 = side_num;
+  if (! record_)
+    return;
 
-  int dir1 = 0, dir2, dir3, dir4;
+  undo_.addMove(move);
 
-  int side_num2, side_num3, side_num4;
+  updateHistory();
+}
 
-  side_num2 = sides_[side_num1].side_u.side; dir2 = dir1 + sides_[side_num1].side_u.rotate;
+QColor
+CQRubik::
+getColor(const CRubikPiece &piece)
+{
+  if (getShade()) {
+    QColor c = colors_[piece.side];
 
-  if (dir2 <= -180) dir2 += 360; else if (dir2 > 180) dir2 -= 360;
+    double f = 0.75 + 0.25*(piece.id + 1)/9.0 ;
 
-  if      (dir2 == 0) {
-    side_num3 = sides_[side_num2].side_u.side; dir3 = dir2 + sides_[side_num2].side_u.rotate;
-  }
-  else if (dir2 == 90) {
-    side_num3 = sides_[side_num2].side_l.side; dir3 = dir2 + sides_[side_num2].side_l.rotate;
-  }
-  else if (dir2 == -90) {
-    side_num3 = sides_[side_num2].side_r.side; dir3 = dir2 + sides_[side_num2].side_r.rotate;
-  }
-  else {
-    side_num3 = sides_[side_num2].side_d.side; dir3 = dir2 + sides_[side_num2].side_d.rotate;
+    return QColor(c.red()*f, c.green()*f, c.blue()*f);
   }
+  else
+    return colors_[piece.side];
+}
 
-  if (dir3 <= -180) dir3 += 360; else if (dir3 > 180) dir3 -= 360;
+QColor
+CQRubik::
+getColor(uint value)
+{
+  return colors_[value];
+}
 
-  if      (dir3 == 0) {
-    side_num4 = sides_[side_num3].side_u.side; dir4 = dir3 + sides_[side_num3].side_u.rotate;
-  }
-  else if (dir3 == 90) {
-    side_num4 = sides_[side_num3].side_l.side; dir4 = dir3 + sides_[side_num3].side_l.rotate;
-  }
-  else if (dir3 == -90) {
-    side_num4 = sides_[side_num3].side_r.side; dir4 = dir3 + sides_[side_num3].side_r.rotate;
-  }
-  else {
-    side_num4 = sides_[side_num3].side_d.side; dir4 = dir3 + sides_[side_num3].side_d.rotate;
-  }
+//---
 
-  if (dir4 <= -180) dir4 += 360; else if (dir4 > 180) dir4 -= 360;
+CQRubikSolveThread::
+CQRubikSolveThread(QObject *parent) :
+ QThread(parent)
+{
+  // only report solver progress for single solves
+  model_.setProgressProc([this](const std::string &msg) {
+    if (numTests_ == 0)
+      emit progressChanged(QString(msg.c_str()));
+  });
+}
+
+void
+CQRubikSolveThread::
+startSolve(const uint8_t *facelets, CRubikModel::SolveMethod method, uint optimalDepth)
+{
+  if (isRunning()) return;
 
-  CRubikSide &side1 = sides_[side_num1];
-  CRubikSide &side2 = sides_[side_num2];
-  CRubikSide &side3 = sides_[side_num3];
-  CRubikSide &side4 = sides_[side_num4];
+  memcpy(facelets_, facelets, sizeof(facelets_));
 
-  CRubikPiece t[15];
+  model_.setSolveMethod(method);
+  model_.setOptimalDepth(optimalDepth);
 
-  uint j = 0;
+  numTests_  = 0;
+  cancelled_ = false;
 
-  for (uint i = 0; i < 3; ++i, ++j)
-    t[j] = side1.pieces[side_col][2 - i];
+  model_.clearCancelSolve();
 
-  for (uint i = 0; i < 3; ++i, ++j) {
-    if      (dir2 ==   0) t[j] = side2.pieces[    side_col][       2 - i];
-    else if (dir2 ==  90) t[j] = side2.pieces[       2 - i][2 - side_col];
-    else if (dir2 == 180) t[j] = side2.pieces[2 - side_col][           i];
-    else                  t[j] = side2.pieces[           i][    side_col];
-  }
+  start();
+}
 
-  for (uint i = 0; i < 3; ++i, ++j) {
-    if      (dir3 ==   0) t[j] = side3.pieces[    side_col][       2 - i];
-    else if (dir3 ==  90) t[j] = side3.pieces[       2 - i][2 - side_col];
-    else if (dir3 == 180) t[j] = side3.pieces[2 - side_col][           i];
-    else                  t[j] = side3.pieces[           i][    side_col];
-  }
+void
+CQRubikSolveThread::
+startTest(uint n, CRubikModel::SolveMethod method, uint optimalDepth)
+{
+  if (isRunning()) return;
 
-  for (uint i = 0; i < 3; ++i, ++j) {
-    if      (dir4 ==   0) t[j] = side4.pieces[    side_col][       2 - i];
-    else if (dir4 ==  90) t[j] = side4.pieces[       2 - i][2 - side_col];
-    else if (dir4 == 180) t[j] = side4.pieces[2 - side_col][           i];
-    else                  t[j] = side4.pieces[           i][    side_col];
-  }
+  model_.setSolveMethod(method);
+  model_.setOptimalDepth(optimalDepth);
 
-  //----
+  numTests_  = n;
+  cancelled_ = false;
 
-  for (int i = 11; i >= 0; --i)
-    t[i + 3] = t[i];
+  model_.clearCancelSolve();
 
-  for (uint i = 12; i < 15; ++i)
-    t[i - 12] = t[i];
+  start();
+}
 
-  //----
+bool
+CQRubikSolveThread::
+solve(const uint8_t *facelets, CRubikModel::SolveMethod method, uint optimalDepth,
+      std::vector<uint> &moves)
+{
+  moves.clear();
 
-  j = 0;
+  if (isRunning()) return false;
 
-  for (uint i = 0; i < 3; ++i, ++j)
-    side1.pieces[side_col][2 - i] = t[j];
+  model_.setSolveMethod(method);
+  model_.setOptimalDepth(optimalDepth);
 
-  for (uint i = 0; i < 3; ++i, ++j) {
-    if      (dir2 ==   0) side2.pieces[    side_col][       2 - i] = t[j];
-    else if (dir2 ==  90) side2.pieces[       2 - i][2 - side_col] = t[j];
-    else if (dir2 == 180) side2.pieces[2 - side_col][           i] = t[j];
-    else                  side2.pieces[           i][    side_col] = t[j];
-  }
+  numTests_  = 0;
+  cancelled_ = false;
 
-  for (uint i = 0; i < 3; ++i, ++j) {
-    if      (dir3 ==   0) side3.pieces[    side_col][       2 - i] = t[j];
-    else if (dir3 ==  90) side3.pieces[       2 - i][2 - side_col] = t[j];
-    else if (dir3 == 180) side3.pieces[2 - side_col][           i] = t[j];
-    else                  side3.pieces[           i][    side_col] = t[j];
-  }
+  model_.clearCancelSolve();
 
-  for (uint i = 0; i < 3; ++i, ++j) {
-    if      (dir4 ==   0) side4.pieces[    side_col][       2 - i] = t[j];
-    else if (dir4 ==  90) side4.pieces[       2 - i][2 - side_col] = t[j];
-    else if (dir4 == 180) side4.pieces[2 - side_col][           i] = t[j];
-    else                  side4.pieces[           i][    side_col] = t[j];
-  }
+  return (model_.setFacelets(facelets) && model_.solve(moves));
 }
 
 void
-CQRubik::
-rotateSide1(uint side_num, bool clockwise)
+CQRubikSolveThread::
+cancel()
 {
-  CRubikSide &side = sides_[side_num];
-
-  CRubikPiece t;
-
-  if (! clockwise) {
-    t                 = side.pieces[2][1];
-    side.pieces[2][1] = side.pieces[1][0];
-    side.pieces[1][0] = side.pieces[0][1];
-    side.pieces[0][1] = side.pieces[1][2];
-    side.pieces[1][2] = t;
-
-    t                 = side.pieces[2][0];
-    side.pieces[2][0] = side.pieces[0][0];
-    side.pieces[0][0] = side.pieces[0][2];
-    side.pieces[0][2] = side.pieces[2][2];
-    side.pieces[2][2] = t;
-  }
-  else {
-    t                 = side.pieces[2][1];
-    side.pieces[2][1] = side.pieces[1][2];
-    side.pieces[1][2] = side.pieces[0][1];
-    side.pieces[0][1] = side.pieces[1][0];
-    side.pieces[1][0] = t;
-
-    t                 = side.pieces[2][0];
-    side.pieces[2][0] = side.pieces[2][2];
-    side.pieces[2][2] = side.pieces[0][2];
-    side.pieces[0][2] = side.pieces[0][0];
-    side.pieces[0][0] = t;
-  }
+  cancelled_ = true;
+
+  model_.cancelSolve();
 }
 
-QColor
-CQRubik::
-getColor(const CRubikPiece &piece)
+void
+CQRubikSolveThread::
+run()
 {
-  if (getShade()) {
-    QColor c = colors_[piece.side];
-
-    double f = 0.75 + 0.25*(piece.id + 1)/9.0 ;
-
-    return QColor(c.red()*f, c.green()*f, c.blue()*f);
-  }
+  if (numTests_ > 0)
+    runTest();
   else
-    return colors_[piece.side];
+    runSolve();
 }
 
-QColor
-CQRubik::
-getColor(uint value)
+void
+CQRubikSolveThread::
+runSolve()
 {
-  return colors_[value];
-}
+  moves_.clear();
 
-bool
-CQRubik::
-validate()
-{
-  for (uint i = 0; i < CUBE_SIDES; ++i) {
-    CRubikSide &side = sides_[i];
+  // don't solve state left from last solve if facelets are not a valid cube
+  if (! model_.setFacelets(facelets_)) {
+    emit solveFinished(false);
+    return;
+  }
 
-    for (uint j = 0; j < SIDE_PIECES; ++j) {
-      uint ix = j % SIDE_LENGTH;
-      uint iy = j / SIDE_LENGTH;
+  bool rc = (! cancelled_ && model_.solve(moves_));
 
-      CRubikPiece &piece = side.pieces[ix][iy];
+  emit solveFinished(rc && ! cancelled_);
+}
 
-      uint side_num1, side_col1, side_row1;
-      int  dir1;
+void
+CQRubikSolveThread::
+runTest()
+{
+  bool rc = true;
 
-      if      (ix == 0)
-        getPosLeft (i, ix, iy, 0, side_num1, side_col1, side_row1, dir1);
-      else if (ix == 2)
-        getPosRight(i, ix, iy, 0, side_num1, side_col1, side_row1, dir1);
-      else
-        return true;
+  for (uint i = 0; i < numTests_ && ! cancelled_; ++i) {
+    if (i % 10 == 0)
+      emit progressChanged(QString("Test %1/%2").arg(i).arg(numTests_));
 
-      uint side_num2, side_col2, side_row2;
-      int  dir2;
+    model_.randomize();
 
-      if      (iy == 0)
-        getPosUp  (i, ix, iy, 0, side_num2, side_col2, side_row2, dir2);
-      else if (iy == 2)
-        getPosDown(i, ix, iy, 0, side_num2, side_col2, side_row2, dir2);
-      else
-        return true;
-
-      CRubikSide &side1 = sides_[side_num1];
-      CRubikSide &side2 = sides_[side_num2];
-
-      CRubikPiece &piece1 = side1.pieces[side_col1][side_row1];
-      CRubikPiece &piece2 = side2.pieces[side_col2][side_row2];
-
-      uint id1 = piece1.id;
-      uint id2 = piece2.id;
-
-      if (id1 > id2) std::swap(id1, id2);
-
-      // validate white side
-      if      (piece.side == 0) {
-        if      (piece.id == 0) {
-          if (id1 != 0 || id2 != 6) {
-            std::cerr << "Trap: " << i << ":" << ix << "," << iy << std::endl;
-            return false;
-          }
-        }
-        else if (piece.id == 2) {
-          if (id1 != 2 || id2 != 8) {
-            std::cerr << "Trap: " << i << ":" << ix << "," << iy << std::endl;
-            return false;
-          }
-        }
-        else if (piece.id == 6) {
-          if (id1 != 0 || id2 != 2) {
-            std::cerr << "Trap: " << i << ":" << ix << "," << iy << std::endl;
-            return false;
-          }
-        }
-        else if (piece.id == 8) {
-          if (id1 != 0 || id2 != 2) {
-            std::cerr << "Trap: " << i << ":" << ix << "," << iy << std::endl;
-            return false;
-          }
-        }
-      }
-      // validate red side
-      else if (piece.side == 1) {
-        if      (piece.id == 0) {
-          if (id1 != 0 || id2 != 6) {
-            std::cerr << "Trap: " << i << ":" << ix << "," << iy << std::endl;
-            return false;
-          }
-        }
-        else if (piece.id == 2) {
-          if (id1 != 0 || id2 != 6) {
-            std::cerr << "Trap: " << i << ":" << ix << "," << iy << std::endl;
-            return false;
-          }
-        }
-        else if (piece.id == 6) {
-          if (id1 != 0 || id2 != 6) {
-            std::cerr << "Trap: " << i << ":" << ix << "," << iy << std::endl;
-            return false;
-          }
-        }
-        else if (piece.id == 8) {
-          if (id1 != 0 || id2 != 6) {
-            std::cerr << "Trap: " << i << ":" << ix << "," << iy << std::endl;
-            return false;
-          }
-        }
-      }
-      // validate green side
-      else if (piece.side == 2) {
-        if      (piece.id == 0) {
-          if (id1 != 2 || id2 != 6) {
-            std::cerr << "Trap: " << i << ":" << ix << "," << iy << std::endl;
-            return false;
-          }
-        }
-        else if (piece.id == 2) {
-          if (id1 != 0 || id2 != 8) {
-            std::cerr << "Trap: " << i << ":" << ix << "," << iy << std::endl;
-            return false;
-          }
-        }
-        else if (piece.id == 6) {
-          if (id1 != 0 || id2 != 8) {
-            std::cerr << "Trap: " << i << ":" << ix << "," << iy << std::endl;
-            return false;
-          }
-        }
-        else if (piece.id == 8) {
-          if (id1 != 2 || id2 != 6) {
-            std::cerr << "Trap: " << i << ":" << ix << "," << iy << std::endl;
-            return false;
-          }
-        }
-      }
-      // validate yellow side
-      else if (piece.side == 4) {
-        if      (piece.id == 0) {
-          if (id1 != 6 || id2 != 8) {
-            std::cerr << "Trap: " << i << ":" << ix << "," << iy << std::endl;
-            return false;
-          }
-        }
-        else if (piece.id == 2) {
-          if (id1 != 6 || id2 != 8) {
-            std::cerr << "Trap: " << i << ":" << ix << "," << iy << std::endl;
-            return false;
-          }
-        }
-        else if (piece.id == 6) {
-          if (id1 != 0 || id2 != 6) {
-            std::cerr << "Trap: " << i << ":" << ix << "," << iy << std::endl;
-            return false;
-          }
-        }
-        else if (piece.id == 8) {
-          if (id1 != 2 || id2 != 8) {
-            std::cerr << "Trap: " << i << ":" << ix << "," << iy << std::endl;
-            return false;
-          }
-        }
-      }
-      // validate blue side
-      else if (piece.side == 5) {
-        if      (piece.id == 0) {
-          if (id1 != 6 || id2 != 6) {
-            std::cerr << "Trap: " << i << ":" << ix << "," << iy << std::endl;
-            return false;
-          }
-        }
-        else if (piece.id == 2) {
-          if (id1 != 8 || id2 != 8) {
-            std::cerr << "Trap: " << i << ":" << ix << "," << iy << std::endl;
-            return false;
-          }
-        }
-        else if (piece.id == 6) {
-          if (id1 != 0 || id2 != 0) {
-            std::cerr << "Trap: " << i << ":" << ix << "," << iy << std::endl;
-            return false;
-          }
-        }
-        else if (piece.id == 8) {
-          if (id1 != 2 || id2 != 2) {
-            std::cerr << "Trap: " << i << ":" << ix << "," << iy << std::endl;
-            return false;
-          }
-        }
-      }
+    CRubikCubie cubie;
+
+    if (! model_.solve() || ! model_.getCubie(cubie) || ! cubie.isSolved()) {
+      rc = false;
+      break;
     }
   }
 
-  return true;
+  emit solveFinished(rc && ! cancelled_);
 }
 
-//------
+//---
+
 
 CQRubik2D::
 CQRubik2D(CQRubik *rubik) :
@@ -3932,7 +1270,11 @@ paintEvent(QPaintEvent *)
 
     int h = height();
 
-    QString valid_str = (rubik_->validate() ? "Valid" : "Invalid");
+    // tracked by model (no check on repaint)
+    const CRubikValidity &validity = rubik_->getModel().getValidity();
+
+    QString valid_str = (validity.isValid() ? "Valid" :
+                         QString("Invalid (%1)").arg(validity.reason()));
 
     p.setPen(QColor(0,0,0));
 
@@ -3970,8 +1312,6 @@ drawSide(QPainter *p, uint i)
   int x = x_pos[i];
   int y = y_pos[i];
 
-  side.r = QRect(x*ds + b/2, y*ds + b/2 + dy, ds, ds);
-
   for (uint j = 0; j < CQRubik::SIDE_PIECES; ++j) {
     uint ix = j % CQRubik::SIDE_LENGTH;
     uint iy = j / CQRubik::SIDE_LENGTH;
@@ -3981,14 +1321,14 @@ drawSide(QPainter *p, uint i)
     int xo = x*ds + ix*dp + b/2;
     int yo = y*ds + iy*dp + b/2 + dy;
 
-    piece.r = QRect(xo, yo, dp, dp);
+    QRect r(xo, yo, dp, dp);
 
     QColor c = rubik_->getColor(piece);
 
     p->setPen(QColor(0,0,0));
     p->setBrush(c);
 
-    p->drawRect(piece.r);
+    p->drawRect(r);
 
     if (ind.side_num == i && ind.side_col == ix && ind.side_row == iy) {
       int xc = xo + dp/2;
@@ -4005,7 +1345,7 @@ drawSide(QPainter *p, uint i)
       int xc = xo + dp/2;
       int yc = yo + dp/2;
 
-      QColor c = rubik_->getColor(side.side_d.side);
+      QColor c = rubik_->getColor(CRubikModel::getSideData(i).side_d.side);
 
       p->setPen(QColor(0,0,0));
       p->setBrush(c);
@@ -4048,12 +1388,9 @@ drawAnimation(QPainter *p, CQRubikAnimateData *animateData)
   double xc = (x1 + x2)/2;
   double yc = (y1 + y2)/2;
 
-  uint   num = 10;
-  double da  = 90/num;
-
-  if (animateData->clockwise) da = -da;
+  double a = animateData->angle;
 
-  double a = da*animateData->step;
+  if (animateData->clockwise) a = -a;
 
   CMatrix2D m1, m2, m3;
 
@@ -4117,7 +1454,7 @@ keyPressEvent(QKeyEvent *e)
   rubik_->keyPressEvent(e);
 }
 
-//------
+//---
 
 CQRubik3D::
 CQRubik3D(CQRubik *rubik) :
@@ -4309,28 +1646,25 @@ drawSideCubes(uint i, bool *b, CQRubikAnimateData *animateData)
     double yc = (y1 + y2)/2.0;
     double zc = (z1 + z2)/2.0;
 
-    uint   num = 10;
-    double da  = 90/num;
+    double a = animateData->angle;
 
     if (! animateData->axis) {
       if (i == 0 || i == 3 || i == 5) {
-        if (! animateData->clockwise) da = -da;
+        if (! animateData->clockwise) a = -a;
       }
       else {
-        if (  animateData->clockwise) da = -da;
+        if (  animateData->clockwise) a = -a;
       }
     }
     else {
       if (animateData->side_num == 0) {
-        if (  animateData->clockwise) da = -da;
+        if (  animateData->clockwise) a = -a;
       }
       else {
-        if (! animateData->clockwise) da = -da;
+        if (! animateData->clockwise) a = -a;
       }
     }
 
-    double a = da*animateData->step;
-
     double ra = a*M_PI/180.0;
 
     CMatrix3D m1, m2, m3;
@@ -4397,10 +1731,12 @@ drawSideCubes(uint i, bool *b, CQRubikAnimateData *animateData)
 
     const CRubikPiece &piece = side.pieces[ix][iy];
 
-    const CRubikPiece &piece1 = rubik_->getPieceLeft (i, ix, iy);
-    const CRubikPiece &piece3 = rubik_->getPieceUp   (i, ix, iy);
-    const CRubikPiece &piece5 = rubik_->getPieceDown (i, ix, iy);
-    const CRubikPiece &piece7 = rubik_->getPieceRight(i, ix, iy);
+    const CRubikModel &model = rubik_->getModel();
+
+    const CRubikPiece &piece1 = model.getPieceLeft (i, ix, iy);
+    const CRubikPiece &piece3 = model.getPieceUp   (i, ix, iy);
+    const CRubikPiece &piece5 = model.getPieceDown (i, ix, iy);
+    const CRubikPiece &piece7 = model.getPieceRight(i, ix, iy);
 
     QColor c1 = (ix == 0 ? rubik_->getColor(piece1) : QColor(100,100,100));
     QColor c3 = (iy == 0 ? rubik_->getColor(piece3) : QColor(100,100,100));
@@ -4718,12 +2054,9 @@ animateSide(CQRubikAnimateData *animateData)
   double yc = (y1 + y2)/2.0;
   double zc = (z1 + z2)/2.0;
 
-  uint   num = 10;
-  double da  = 90/num;
-
-  if (animateData->clockwise) da = -da;
+  double a = animateData->angle;
 
-  double a = da*animateData->step;
+  if (animateData->clockwise) a = -a;
 
   CMatrix3D m1, m2, m3;
 
@@ -1,112 +1,111 @@
 #include <QWidget>
 #include <QGLWidget>
+#include <QThread>
+#include <QElapsedTimer>
 
+#include <CRubikModel.h>
+#include <CRubikUndoLog.h>
 #include <CMatrix3D.h>
 
+#include <atomic>
+#include <deque>
 #include <iostream>
 
 class CQGLControl;
 class CQRubik2D;
 class CQRubik3D;
 class CQGLControlToolBar;
-class CUndo;
 class CGLTexture;
 class CQWinWidget;
+class QSlider;
+class QTimer;
 
-struct CRubikSideConnect {
-  uint side;
-  int  rotate;
+struct CQRubikAnimateData {
+  bool      animating;
+  uint      move;
+  uint      side_num;
+  bool      clockwise;
+  bool      axis;
+  double    angle;
+  double    end_angle;
+  double    start_time;
+  double    duration;
+  QPolygonF polygon;
 
-  CRubikSideConnect(uint side1=0, int rotate1=0) :
-   side(side1), rotate(rotate1) {
+  CQRubikAnimateData() :
+   animating(false), move(0), side_num(0), clockwise(false), axis(false),
+   angle(0.0), end_angle(90.0), start_time(0.0), duration(0.0) {
   }
 };
 
-struct CRubikPieceInd {
-  uint side_num;
-  uint side_col;
-  uint side_row;
+// Background solver.
+//
+// Solves a copy of the cube state on its own model (so the displayed cube is not
+// changed) or runs randomize/solve rounds as a test. Progress messages and the
+// result are signalled (queued to the GUI thread).
+class CQRubikSolveThread : public QThread {
+  Q_OBJECT
 
-  CRubikPieceInd(uint side_num1=0, uint side_col1=0, uint side_row1=0) :
-   side_num(side_num1), side_col(side_col1), side_row(side_row1) {
-  }
+ public:
+  CQRubikSolveThread(QObject *parent=nullptr);
 
-  bool assertInd(const char *msg, uint side_num1, uint side_col1, uint side_row1) {
-    if (side_num != side_num1 || side_col != side_col1 || side_row != side_row1) {
-      std::cerr << msg << "# ";
+  CRubikModel &getModel() { return model_; }
 
-      print(std::cerr);
+  // start solve of facelets using method
+  void startSolve(const uint8_t *facelets, CRubikModel::SolveMethod method, uint optimalDepth);
 
-      std::cerr << std::endl;
+  // solve facelets in calling thread (if not running)
+  bool solve(const uint8_t *facelets, CRubikModel::SolveMethod method, uint optimalDepth,
+             std::vector<uint> &moves);
 
-      return false;
-    }
+  // start n randomize/solve rounds
+  void startTest(uint n, CRubikModel::SolveMethod method, uint optimalDepth);
 
-    return true;
-  }
+  void cancel();
 
-  void print(std::ostream &os=std::cout) {
-    os << side_num << ": " << side_col << ", " << side_row;
-  }
-};
+  bool isCancelled() const { return cancelled_; }
 
-struct CRubikPiece {
-  uint side;
-  uint id;
+  const uint8_t *facelets() const { return facelets_; }
 
-  mutable QRect r;
+  const std::vector<uint> &moves() const { return moves_; }
 
-  CRubikPiece(uint side1=0, uint id1=0) :
-   side(side1), id(id1) {
-  }
+ signals:
+  void progressChanged(const QString &msg);
 
-  CRubikPiece &operator=(const CRubikPiece &piece) {
-    side = piece.side;
-    id   = piece.id;
-    r    = piece.r;
+  void solveFinished(bool rc);
 
-    return *this;
-  }
-};
-
-struct CRubikSide {
-  enum { SIDE_ROWS = 3 };
-  enum { SIDE_COLS = 3 };
-
-  std::string       name;
-  CRubikPiece       pieces[SIDE_COLS][SIDE_ROWS];
-  CRubikSideConnect side_l, side_r, side_u, side_d;
+ protected:
+  void run() override;
 
-  mutable QRect r;
+ private:
+  void runSolve();
+  void runTest();
 
-  CRubikSide() { }
+ private:
+  CRubikModel       model_;
+  uint8_t           facelets_[CRubikMove::NUM_FACELETS];
+  std::vector<uint> moves_;
+  uint              numTests_  { 0 };
+  std::atomic<bool> cancelled_ { false };
 };
 
-struct CQRubikAnimateData {
-  bool      animating;
-  uint      side_num;
-  bool      clockwise;
-  bool      axis;
-  uint      step;
-  QPolygonF polygon;
-
-  CQRubikAnimateData() :
-   animating(false), side_num(0), clockwise(false), axis(false), step(0) {
-  }
-};
+//---
 
-class CQRubik : public QWidget {
+class CQRubik : public QWidget, public CRubikModelListener {
   Q_OBJECT
 
  public:
-  enum { CUBE_SIDES   = 6 };
-  enum { SIDE_LENGTH  = 3 };
-  enum { SIDE_PIECES  = 9 };
-  enum { SIDE_ROWS    = 3 };
-  enum { SIDE_COLS    = 3 };
+  enum { CUBE_SIDES   = CRubikModel::CUBE_SIDES  };
+  enum { SIDE_LENGTH  = CRubikModel::SIDE_LENGTH };
+  enum { SIDE_PIECES  = CRubikModel::SIDE_PIECES };
+  enum { SIDE_ROWS    = CRubikModel::SIDE_ROWS   };
+  enum { SIDE_COLS    = CRubikModel::SIDE_COLS   };
+
+  enum { MIN_TURN_TIME = 40 };
 
  public:
   CQRubik(QWidget *parent=NULL);
+ ~CQRubik();
 
   bool getShade    () const { return shade_     ; }
   bool getNumber   () const { return number_    ; }
@@ -119,9 +118,17 @@ class CQRubik : public QWidget {
   void setNumber   (bool number    ) { number_     = number    ; }
   void setUndoGroup(bool undo_group) { undo_group_ = undo_group; }
   void setAnimate  (bool animate   ) { animate_    = animate   ; }
+  void setValidate (bool validate  ) { validate_   = validate  ; }
   void setShow3    (bool show3     ) { show3_      = show3     ; }
 
-  CUndo *getUndo() const { return undo_; }
+  // base animated quarter turn time (ms) : half turns take 1.5 times as long and
+  // turns are shortened to turnTime/(1 + queued/2) when moves are queued
+  uint getTurnTime() const { return turnTime_; }
+  void setTurnTime(uint t) { turnTime_ = std::max(t, 1u); }
+
+  CRubikUndoLog &getUndo() { return undo_; }
+
+  CRubikModel &getModel() { return model_; }
 
   const CRubikPieceInd &getInd() const { return ind_; }
   int                   getDir() const { return dir_; }
@@ -135,45 +142,57 @@ class CQRubik : public QWidget {
 
   void randomize();
 
+  // set sticker color (side number) of current piece
+  void setPieceColor(uint color);
+
   bool solve();
-  bool solve1();
 
-  void execute(const std::string &str);
+  // solve in background and replay result when done
+  void startSolve();
+
+  // run n randomize/solve rounds in background
+  void startTest(uint n);
+
+  void cancelSolve();
+
+  bool isSolving() const;
+
+  // move being animated or queued
+  bool isAnimating() const { return animateData_.animating || ! animateQueue_.empty(); }
 
-  void moveSideLeft2 (uint side_num, uint side_row);
-  void moveSideRight2(uint side_num, uint side_row);
-  void moveSideDown2 (uint side_num, uint side_col);
-  void moveSideUp2   (uint side_num, uint side_col);
+  // apply current and queued moves now
+  void finishAnimation();
+
+  // undo/redo last/next group of moves
+  bool undo();
+  bool redo();
+
+  // jump to undo position (number of moves from start of undo history)
+  bool seekUndo(size_t pos);
 
   void moveSideLeft (uint side_num, uint side_row);
   void moveSideRight(uint side_num, uint side_row);
   void moveSideDown (uint side_num, uint side_col);
   void moveSideUp   (uint side_num, uint side_col);
 
-  void rotateSide2(uint side_num);
-
   void rotateSide(uint side_num, bool clockwise);
 
+  void applyMove(uint move);
+
+  // animated move (added to undo log and queued)
+  void animateMove(uint move);
+
   void animateRotateSide(uint side_num, bool clockwise);
 
   void animateRotateMiddleX(bool clockwise);
   void animateRotateMiddleY(bool clockwise);
   void animateRotateMiddleZ(bool clockwise);
 
-  CRubikPieceInd findPiece(uint side_num, uint id);
-
-  const CRubikSide &getSide(uint i) const { return sides_[i]; }
+  const CRubikSide &getSide(uint i) const { return model_.getSide(i); }
 
   QColor getColor(const CRubikPiece &piece);
   QColor getColor(uint value);
 
-  const CRubikPiece &getPieceLeft (uint side_num, uint side_col, uint side_row) const;
-  const CRubikPiece &getPieceRight(uint side_num, uint side_col, uint side_row) const;
-  const CRubikPiece &getPieceUp   (uint side_num, uint side_col, uint side_row) const;
-  const CRubikPiece &getPieceDown (uint side_num, uint side_col, uint side_row) const;
-
-  bool validate();
-
   void movePosition(int key);
   void movePieces  (int key);
   void rotatePieces(int key);
@@ -186,66 +205,53 @@ class CQRubik : public QWidget {
 
   void keyPressEvent(QKeyEvent *e) override;
 
-  void waitAnimate();
-
-  static bool decodeSideChar(char c, uint &n);
-  static bool encodeSideChar(uint n, char &c);
-
  private:
-  bool solveTopInd4();
-  bool solveTopInd1();
-  bool solveTopInd3();
-  bool solveTopInd5();
-  bool solveTopInd7();
-  bool solveTopInd0();
-  bool solveTopInd2();
-  bool solveTopInd6();
-  bool solveTopInd8();
-  bool solveMidInd4();
-
-  bool solveMidLeftInd3();
-  bool solveMidLeftInd5();
-
-  bool solveMidRightInd3();
-  bool solveMidRightInd5();
-
-  bool solveBottomCross();
-  bool solveBottomCornerOrder();
-  bool solveBottomCornerOrder1(bool check=false);
-  bool solveBottomCornerOrient(bool check=false);
-  void solveBottomCornerOrient1();
-  void solveBottomCornerOrient2();
-  bool solveBottomMiddles();
-  void solveBottomMiddlesSub();
-  void solveBottomMiddles1();
-  void solveBottomMiddles2();
-
-  void getPosLeft (uint side_num, uint side_col, uint side_row, int dir,
-                   uint &side_num1, uint &side_col1, uint &side_row1, int &dir1) const;
-  void getPosRight(uint side_num, uint side_col, uint side_row, int dir,
-                   uint &side_num1, uint &side_col1, uint &side_row1, int &dir1) const;
-  void getPosUp   (uint side_num, uint side_col, uint side_row, int dir,
-                   uint &side_num1, uint &side_col1, uint &side_row1, int &dir1) const;
-  void getPosDown (uint side_num, uint side_col, uint side_row, int dir,
-                   uint &side_num1, uint &side_col1, uint &side_row1, int &dir1) const;
-
   void moveSidesLeft ();
   void moveSidesRight();
   void moveSidesDown ();
   void moveSidesUp   ();
 
-  void moveSideLeft1 (uint side_num, uint side_row);
-  void moveSideRight1(uint side_num, uint side_row);
-  void moveSideDown1 (uint side_num, uint side_col);
-  void moveSideUp1   (uint side_num, uint side_col);
+  void moveApplied(uint move) override;
+
+  void replayMoves(const std::vector<uint> &moves);
+
+  void queueMove(uint move);
+
+  bool startNextMove();
+
+  bool startAnimation(uint move);
 
-  void rotateSide1(uint side_num, bool clockwise);
+  void commitMove(uint move);
+
+  void applyUndoMoves(const std::vector<uint> &moves);
+
+  void clearUndo();
+
+  void updateHistory();
+
+  void setMessage(const QString &msg);
+
+ signals:
+  // animated move applied to model
+  void moveFinished(uint move);
 
  private slots:
-  void animateRotateSideSlot();
+  void animateTimerSlot();
+
+  void historySlot(int pos);
+
+  void solveProgressSlot(const QString &msg);
+  void solveFinishedSlot(bool rc);
 
  private:
-  CRubikSide          sides_[CUBE_SIDES];
+  CRubikModel         model_;
+  CRubikUndoLog       undo_;
+  bool                record_     { true };
+  std::vector<uint>   solveMoves_;
+  std::deque<uint>    animateQueue_;
+  QTimer*             animateTimer_ { nullptr };
+  QElapsedTimer       animateTime_;
+  uint                turnTime_   { 300 };
   CRubikPieceInd      ind_;
   QColor              colors_[CUBE_SIDES];
   bool                shade_      { true };
@@ -261,7 +267,10 @@ class CQRubik : public QWidget {
   CQWinWidget*        w2_         { nullptr };
   CQWinWidget*        w3_         { nullptr };
   CQGLControlToolBar* toolbar_    { nullptr };
-  CUndo*              undo_       { nullptr };
+  QSlider*            history_    { nullptr };
+  CQRubikSolveThread* solveThread_ { nullptr };
+  bool                testing_    { false };
+  QString             message_;
 };
 
 class CQRubik2D : public QWidget {
@@ -36,7 +36,6 @@ INCLUDEPATH += \
 ../../CQUtil/include \
 ../../CImageLib/include \
 ../../CFont/include \
-../../CUndo/include \
 ../../CFile/include \
 ../../CMath/include \
 ../../CStrUtil/include \
@@ -44,13 +43,15 @@ INCLUDEPATH += \
 ../../CUtil/include \
 .
 
+PRE_TARGETDEPS = \
+$$LIB_DIR/libCRubikModel.a
+
 unix:LIBS += \
 -L$$LIB_DIR \
 -L../../CQUtil/lib \
 -L../../CImageLib/lib \
 -L../../CFont/lib \
 -L../../CConfig/lib \
--L../../CUndo/lib \
 -L../../CFile/lib \
 -L../../CFileUtil/lib \
 -L../../CMath/lib \
@@ -58,6 +59,7 @@ unix:LIBS += \
 -L../../CRegExp/lib \
 -L../../COS/lib \
 -L../../CUtil/lib \
+-lCRubikModel \
 -lCQUtil -lCImageLib -lCFont -lCConfig \
--lCUndo -lCFile -lCFileUtil -lCMath -lCStrUtil -lCRegExp -lCOS -lCUtil \
--lglut -lGLU -lGL -lpng -ljpeg -ltre
+-lCFile -lCFileUtil -lCMath -lCStrUtil -lCRegExp -lCOS -lCUtil \
+-lglut -lGLU -lGL -lpng -ljpeg -ltre -lpthread
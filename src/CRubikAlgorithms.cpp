@@ -0,0 +1,176 @@
+#include <CRubikAlgorithms.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+CRubikAlgorithms &
+CRubikAlgorithms::
+instance()
+{
+  static CRubikAlgorithms *instance = []() {
+    CRubikAlgorithms *algorithms = new CRubikAlgorithms;
+
+    // bottom layer (F) corner orientation and middle edge cycles
+    algorithms->add("LBL", LBL_CORNER_ORIENT1, "CornerOrient1", "R' F' R F' R' F2 R F2");
+    algorithms->add("LBL", LBL_CORNER_ORIENT2, "CornerOrient2", "R F R' F R F2 R' F2");
+    algorithms->add("LBL", LBL_MIDDLES1      , "Middles1"     , "R2 F D U' R2 D' U F R2");
+    algorithms->add("LBL", LBL_MIDDLES2      , "Middles2"     , "R2 F' D U' R2 D' U F' R2");
+
+    return algorithms;
+  }();
+
+  return *instance;
+}
+
+bool
+CRubikAlgorithms::
+add(const std::string &set, uint id, const std::string &name,
+    const std::string &moves, std::string *errorMsg)
+{
+  if (id > MAX_ID) {
+    if (errorMsg) *errorMsg = "Bad case id " + std::to_string(id);
+    return false;
+  }
+
+  CRubikProgram program;
+
+  if (! program.compile(moves)) {
+    if (errorMsg)
+      *errorMsg = program.errorMsg() + " at " + std::to_string(program.errorPos() + 1);
+
+    return false;
+  }
+
+  Set &s = sets_[set];
+
+  if (id >= s.ids.size())
+    s.ids.resize(id + 1, -1);
+
+  int ind = s.ids[id];
+
+  if (ind < 0) {
+    ind = int(algorithms_.size());
+
+    algorithms_.emplace_back();
+
+    s.ids[id] = ind;
+  }
+  else
+    s.names.erase(algorithms_[ind].name);
+
+  Algorithm &algorithm = algorithms_[ind];
+
+  algorithm.set     = set;
+  algorithm.id      = id;
+  algorithm.name    = name;
+  algorithm.program = program;
+
+  s.names[name] = ind;
+
+  return true;
+}
+
+bool
+CRubikAlgorithms::
+load(const std::string &fileName, std::string *errorMsg)
+{
+  std::ifstream is(fileName);
+
+  if (! is) {
+    if (errorMsg) *errorMsg = "Failed to open " + fileName;
+    return false;
+  }
+
+  std::string line;
+  uint        lineNum = 0;
+
+  while (std::getline(is, line)) {
+    ++lineNum;
+
+    std::istringstream ss(line);
+
+    std::string set;
+
+    if (! (ss >> set) || set[0] == '#')
+      continue;
+
+    uint        id;
+    std::string name, moves;
+
+    if (! (ss >> id >> name)) {
+      if (errorMsg) *errorMsg = fileName + ":" + std::to_string(lineNum) + ": bad line";
+      return false;
+    }
+
+    std::getline(ss, moves);
+
+    std::string msg;
+
+    if (! add(set, id, name, moves, &msg)) {
+      if (errorMsg) *errorMsg = fileName + ":" + std::to_string(lineNum) + ": " + msg;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+const CRubikAlgorithms::Algorithm *
+CRubikAlgorithms::
+lookup(const std::string &set, uint id) const
+{
+  auto p = sets_.find(set);
+
+  if (p == sets_.end() || id >= (*p).second.ids.size() || (*p).second.ids[id] < 0)
+    return nullptr;
+
+  return &algorithms_[(*p).second.ids[id]];
+}
+
+const CRubikAlgorithms::Algorithm *
+CRubikAlgorithms::
+lookup(const std::string &set, const std::string &name) const
+{
+  auto p = sets_.find(set);
+
+  if (p == sets_.end())
+    return nullptr;
+
+  auto p1 = (*p).second.names.find(name);
+
+  if (p1 == (*p).second.names.end())
+    return nullptr;
+
+  return &algorithms_[(*p1).second];
+}
+
+std::vector<std::string>
+CRubikAlgorithms::
+sets() const
+{
+  std::vector<std::string> names;
+
+  for (const auto &s : sets_)
+    names.push_back(s.first);
+
+  std::sort(names.begin(), names.end());
+
+  return names;
+}
+
+std::vector<const CRubikAlgorithms::Algorithm *>
+CRubikAlgorithms::
+algorithms(const std::string &set) const
+{
+  std::vector<const Algorithm *> algorithms;
+
+  auto p = sets_.find(set);
+
+  if (p != sets_.end()) {
+    for (const auto &ind : (*p).second.ids)
+      if (ind >= 0)
+        algorithms.push_back(&algorithms_[ind]);
+  }
+
+  return algorithms;
+}
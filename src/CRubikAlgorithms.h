@@ -0,0 +1,73 @@
+#ifndef CRUBIK_ALGORITHMS_H
+#define CRUBIK_ALGORITHMS_H
+
+#include <CRubikProgram.h>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Named algorithm library.
+//
+// Algorithms belong to a set (e.g. OLL, PLL, F2L) and have a case id (unique in the
+// set) and a name. Each is compiled once to a CRubikProgram so its net effect is a
+// single facelet permutation (see CRubikModel::execute(const CRubikProgram &)).
+// Lookup by set and case id or by set and name is a hash and vector index.
+//
+// The instance holds the LBL set used by the layer solver and sets can be added from
+// files with lines :
+//
+//   <set> <id> <name> <moves>
+//
+// where moves is CRubikProgram syntax to the end of the line (blank lines and lines
+// starting with # are skipped). An algorithm with the same set and id is replaced.
+class CRubikAlgorithms {
+ public:
+  enum { MAX_ID = 0xFFFF };
+
+  // layer solver algorithms (set LBL)
+  enum LBL {
+    LBL_CORNER_ORIENT1,
+    LBL_CORNER_ORIENT2,
+    LBL_MIDDLES1,
+    LBL_MIDDLES2
+  };
+
+  struct Algorithm {
+    std::string   set;
+    uint          id { 0 };
+    std::string   name;
+    CRubikProgram program;
+  };
+
+ public:
+  static CRubikAlgorithms &instance();
+
+  CRubikAlgorithms() { }
+
+  // add algorithm (false if moves do not compile)
+  bool add(const std::string &set, uint id, const std::string &name,
+           const std::string &moves, std::string *errorMsg=nullptr);
+
+  // add algorithms from file (false and line number in message on first error)
+  bool load(const std::string &fileName, std::string *errorMsg=nullptr);
+
+  const Algorithm *lookup(const std::string &set, uint id) const;
+  const Algorithm *lookup(const std::string &set, const std::string &name) const;
+
+  std::vector<std::string> sets() const;
+
+  // algorithms in set in case id order
+  std::vector<const Algorithm *> algorithms(const std::string &set) const;
+
+ private:
+  struct Set {
+    std::vector<int>                     ids;   // algorithm index for case id (-1 if none)
+    std::unordered_map<std::string, int> names; // algorithm index for name
+  };
+
+  std::deque<Algorithm>                algorithms_;
+  std::unordered_map<std::string, Set> sets_;
+};
+
+#endif
@@ -0,0 +1,513 @@
+#include <CRubikCubie.h>
+#include <cstring>
+#include <utility>
+
+// facelet indices of each corner (U/D facelet first, then clockwise)
+const uint8_t CRubikCubie::cornerFacelets[NUM_CORNERS][3] = {
+  { 17, 36, 24 }, // URF
+  { 11, 18,  6 }, // UFL
+  {  9,  0, 51 }, // ULB
+  { 15, 45, 42 }, // UBR
+  { 33, 26, 38 }, // DFR
+  { 27,  8, 20 }, // DLF
+  { 29, 53,  2 }, // DBL
+  { 35, 44, 47 }, // DRB
+};
+
+// facelet indices of each edge (U/D or F/B facelet first)
+const uint8_t CRubikCubie::edgeFacelets[NUM_EDGES][2] = {
+  { 16, 39 }, // UR
+  { 14, 21 }, // UF
+  { 10,  3 }, // UL
+  { 12, 48 }, // UB
+  { 34, 41 }, // DR
+  { 30, 23 }, // DF
+  { 28,  5 }, // DL
+  { 32, 50 }, // DB
+  { 25, 37 }, // FR
+  { 19,  7 }, // FL
+  { 52,  1 }, // BL
+  { 46, 43 }, // BR
+};
+
+namespace {
+
+// map from facelet to owning cubie and facelet number (cubie*3 + n, cubie*2 + n)
+struct CRubikCubieFaceletMap {
+  uint8_t corner[CRubikCubie::NUM_FACELETS];
+  uint8_t edge  [CRubikCubie::NUM_FACELETS];
+
+  CRubikCubieFaceletMap() {
+    memset(corner, 0xFF, sizeof(corner));
+    memset(edge  , 0xFF, sizeof(edge  ));
+
+    for (uint i = 0; i < CRubikCubie::NUM_CORNERS; ++i)
+      for (uint n = 0; n < 3; ++n)
+        corner[CRubikCubie::cornerFacelets[i][n]] = uint8_t(i*3 + n);
+
+    for (uint i = 0; i < CRubikCubie::NUM_EDGES; ++i)
+      for (uint n = 0; n < 2; ++n)
+        edge[CRubikCubie::edgeFacelets[i][n]] = uint8_t(i*2 + n);
+  }
+};
+
+const CRubikCubieFaceletMap &faceletMap() {
+  static CRubikCubieFaceletMap map;
+
+  return map;
+}
+
+// side (center) geometry : opposite side, axis (L/R, U/D, F/B) and direction on axis
+const uint oppositeSide[] = { 4, 3, 5, 1, 0, 2 };
+const uint sideAxis    [] = { 0, 1, 2, 1, 0, 2 };
+const int  sideSign    [] = { -1, 1, 1, -1, 1, -1 };
+const uint axisSide    [] = { 4, 1, 2 }; // R U F
+
+// check centers are a whole cube rotation (keep opposite sides and are not a mirror)
+bool
+isRotation(const uint8_t *centers)
+{
+  uint axes[3];
+  int  sign = 1;
+
+  for (uint a = 0; a < 3; ++a) {
+    uint p = axisSide[a];
+    uint c = centers[p];
+
+    if (c >= CRubikCubie::NUM_CENTERS || centers[oppositeSide[p]] != oppositeSide[c])
+      return false;
+
+    axes[a] = sideAxis[c];
+    sign   *= sideSign[c];
+  }
+
+  if (axes[0] == axes[1] || axes[0] == axes[2] || axes[1] == axes[2])
+    return false;
+
+  if (((axes[0] > axes[1]) + (axes[0] > axes[2]) + (axes[1] > axes[2])) & 1)
+    sign = -sign;
+
+  return (sign == 1);
+}
+
+uint
+permParity(const uint8_t *perm, uint n)
+{
+  uint parity = 0;
+
+  for (uint i = 0; i < n; ++i)
+    for (uint j = i + 1; j < n; ++j)
+      parity ^= (perm[i] > perm[j]);
+
+  return parity;
+}
+
+}
+
+//---
+
+void
+CRubikCubie::
+reset()
+{
+  for (uint i = 0; i < NUM_CORNERS; ++i) corners[i] = uint8_t(i);
+  for (uint i = 0; i < NUM_EDGES  ; ++i) edges  [i] = uint8_t(i);
+  for (uint i = 0; i < NUM_CENTERS; ++i) centers[i] = uint8_t(i);
+}
+
+bool
+CRubikCubie::
+isSolved() const
+{
+  return (*this == CRubikCubie());
+}
+
+CRubikCubie::Validity
+CRubikCubie::
+validity() const
+{
+  uint8_t cp[NUM_CORNERS], ep[NUM_EDGES];
+
+  uint used = 0, twist = 0;
+
+  for (uint i = 0; i < NUM_CORNERS; ++i) {
+    if ((corners[i] >> 5) != 0 || cornerOri(i) > 2) return Validity::BAD_CORNERS;
+
+    cp[i] = uint8_t(cornerPerm(i));
+
+    used  |= 1u << cp[i];
+    twist += cornerOri(i);
+  }
+
+  if (used != (1u << NUM_CORNERS) - 1)
+    return Validity::BAD_CORNERS;
+
+  uint flip = 0;
+
+  used = 0;
+
+  for (uint i = 0; i < NUM_EDGES; ++i) {
+    if (edgePerm(i) >= NUM_EDGES || edgeOri(i) > 1) return Validity::BAD_EDGES;
+
+    ep[i] = uint8_t(edgePerm(i));
+
+    used |= 1u << ep[i];
+    flip += edgeOri(i);
+  }
+
+  if (used != (1u << NUM_EDGES) - 1)
+    return Validity::BAD_EDGES;
+
+  if (! isRotation(centers))
+    return Validity::BAD_CENTERS;
+
+  if (twist % 3 != 0)
+    return Validity::CORNER_TWIST;
+
+  if (flip % 2 != 0)
+    return Validity::EDGE_FLIP;
+
+  // every move is an even permutation of all pieces
+  if ((permParity(cp, NUM_CORNERS) ^ permParity(ep, NUM_EDGES) ^
+       permParity(centers, NUM_CENTERS)) != 0)
+    return Validity::PARITY;
+
+  return Validity::VALID;
+}
+
+const char *
+CRubikCubie::
+validityName(Validity validity)
+{
+  switch (validity) {
+    case Validity::VALID       : return "Valid";
+    case Validity::BAD_FACELETS: return "Bad Facelets";
+    case Validity::BAD_CORNERS : return "Bad Corners";
+    case Validity::BAD_EDGES   : return "Bad Edges";
+    case Validity::BAD_CENTERS : return "Bad Centers";
+    case Validity::CORNER_TWIST: return "Corner Twist";
+    case Validity::EDGE_FLIP   : return "Edge Flip";
+    case Validity::PARITY      : return "Parity";
+    default                    : return "";
+  }
+}
+
+CRubikValidity
+CRubikCubie::
+checkValidity(uint unknownCorners, uint unknownEdges) const
+{
+  CRubikValidity validity;
+
+  uint8_t cp[NUM_CORNERS], ep[NUM_EDGES];
+
+  uint cornersUsed = 0, twist = 0, numCorners = 0;
+
+  for (uint i = 0; i < NUM_CORNERS; ++i) {
+    cp[i] = uint8_t(cornerPerm(i));
+
+    if (unknownCorners & (1u << i)) continue;
+
+    if (! (cornersUsed & (1u << cp[i]))) ++numCorners;
+
+    cornersUsed |= 1u << cp[i];
+    twist       += cornerOri(i);
+  }
+
+  uint edgesUsed = 0, flip = 0, numEdges = 0;
+
+  for (uint i = 0; i < NUM_EDGES; ++i) {
+    ep[i] = uint8_t(edgePerm(i));
+
+    if (unknownEdges & (1u << i)) continue;
+
+    if (! (edgesUsed & (1u << ep[i]))) ++numEdges;
+
+    edgesUsed |= 1u << ep[i];
+    flip      += edgeOri(i);
+  }
+
+  validity.cubies = (numCorners == NUM_CORNERS && numEdges == NUM_EDGES &&
+                     isRotation(centers));
+
+  // twist and flip over known cubies (no total if any are unknown)
+  validity.twist = (unknownCorners != 0 || twist % 3 == 0);
+  validity.flip  = (unknownEdges   != 0 || flip  % 2 == 0);
+
+  validity.parity = (! validity.cubies ||
+    (permParity(cp, NUM_CORNERS) ^ permParity(ep, NUM_EDGES) ^
+     permParity(centers, NUM_CENTERS)) == 0);
+
+  return validity;
+}
+
+const char *
+CRubikValidity::
+reason() const
+{
+  if      (! stickers) return "Stickers";
+  else if (! cubies  ) return "Cubies";
+  else if (! twist   ) return "Corner Twist";
+  else if (! flip    ) return "Edge Flip";
+  else if (! parity  ) return "Parity";
+  else                 return "";
+}
+
+bool
+CRubikCubie::
+operator==(const CRubikCubie &cubie) const
+{
+  return (memcmp(corners, cubie.corners, sizeof(corners)) == 0 &&
+          memcmp(edges  , cubie.edges  , sizeof(edges  )) == 0 &&
+          memcmp(centers, cubie.centers, sizeof(centers)) == 0);
+}
+
+void
+CRubikCubie::
+multiply(const CRubikCubie &cubie)
+{
+  uint8_t corners1[NUM_CORNERS], edges1[NUM_EDGES], centers1[NUM_CENTERS];
+
+  for (uint i = 0; i < NUM_CORNERS; ++i) {
+    uint j = cubie.cornerPerm(i);
+
+    corners1[i] = uint8_t(cornerPerm(j) | (((cornerOri(j) + cubie.cornerOri(i)) % 3) << 3));
+  }
+
+  for (uint i = 0; i < NUM_EDGES; ++i) {
+    uint j = cubie.edgePerm(i);
+
+    edges1[i] = uint8_t(edgePerm(j) | (((edgeOri(j) + cubie.edgeOri(i)) & 1) << 4));
+  }
+
+  for (uint i = 0; i < NUM_CENTERS; ++i)
+    centers1[i] = centers[cubie.centers[i]];
+
+  memcpy(corners, corners1, sizeof(corners));
+  memcpy(edges  , edges1  , sizeof(edges  ));
+  memcpy(centers, centers1, sizeof(centers));
+}
+
+bool
+CRubikCubie::
+fromFacelets(const uint8_t *facelets)
+{
+  const CRubikCubieFaceletMap &map = faceletMap();
+
+  // corners : find which facelet holds the U/D facelet of the cubie
+  for (uint i = 0; i < NUM_CORNERS; ++i) {
+    uint ori = 0;
+
+    for ( ; ori < 3; ++ori) {
+      uint f = facelets[cornerFacelets[i][ori]];
+
+      if (f < NUM_FACELETS && map.corner[f] != 0xFF && map.corner[f] % 3 == 0)
+        break;
+    }
+
+    if (ori == 3) return false;
+
+    uint j = map.corner[facelets[cornerFacelets[i][ori]]]/3;
+
+    for (uint n = 1; n < 3; ++n) {
+      if (facelets[cornerFacelets[i][(ori + n) % 3]] != cornerFacelets[j][n])
+        return false;
+    }
+
+    setCorner(i, j, ori);
+  }
+
+  // edges : check which facelet holds the reference facelet of the cubie
+  for (uint i = 0; i < NUM_EDGES; ++i) {
+    uint f1 = facelets[edgeFacelets[i][0]];
+    uint f2 = facelets[edgeFacelets[i][1]];
+
+    if (f1 >= NUM_FACELETS || f2 >= NUM_FACELETS) return false;
+
+    uint e1 = map.edge[f1];
+    uint e2 = map.edge[f2];
+
+    if (e1 == 0xFF || e2 == 0xFF || e1/2 != e2/2 || e1 % 2 == e2 % 2)
+      return false;
+
+    setEdge(i, e1/2, e1 % 2);
+  }
+
+  // centers
+  for (uint i = 0; i < NUM_CENTERS; ++i) {
+    uint f = facelets[i*9 + 4];
+
+    if (f >= NUM_FACELETS || f % 9 != 4) return false;
+
+    centers[i] = uint8_t(f/9);
+  }
+
+  return true;
+}
+
+void
+CRubikCubie::
+toFacelets(uint8_t *facelets) const
+{
+  for (uint i = 0; i < NUM_CORNERS; ++i) {
+    uint j   = cornerPerm(i);
+    uint ori = cornerOri (i);
+
+    for (uint n = 0; n < 3; ++n)
+      facelets[cornerFacelets[i][(n + ori) % 3]] = cornerFacelets[j][n];
+  }
+
+  for (uint i = 0; i < NUM_EDGES; ++i) {
+    uint j   = edgePerm(i);
+    uint ori = edgeOri (i);
+
+    for (uint n = 0; n < 2; ++n)
+      facelets[edgeFacelets[i][(n + ori) % 2]] = edgeFacelets[j][n];
+  }
+
+  for (uint i = 0; i < NUM_CENTERS; ++i)
+    facelets[i*9 + 4] = uint8_t(centers[i]*9 + 4);
+}
+
+bool
+CRubikCubie::
+fromColors(const uint8_t *colors)
+{
+  uint8_t facelets[NUM_FACELETS];
+
+  // find cubie (and twist) with matching colors at each corner position
+  for (uint i = 0; i < NUM_CORNERS; ++i) {
+    uint j, ori;
+
+    if (! cornerFromColors(i, colors, j, ori)) return false;
+
+    for (uint n = 0; n < 3; ++n)
+      facelets[cornerFacelets[i][(n + ori) % 3]] = cornerFacelets[j][n];
+  }
+
+  for (uint i = 0; i < NUM_EDGES; ++i) {
+    uint j, ori;
+
+    if (! edgeFromColors(i, colors, j, ori)) return false;
+
+    facelets[edgeFacelets[i][ori    ]] = edgeFacelets[j][0];
+    facelets[edgeFacelets[i][1 - ori]] = edgeFacelets[j][1];
+  }
+
+  for (uint i = 0; i < NUM_CENTERS; ++i) {
+    if (colors[i*9 + 4] >= NUM_CENTERS) return false;
+
+    facelets[i*9 + 4] = uint8_t(colors[i*9 + 4]*9 + 4);
+  }
+
+  return (fromFacelets(facelets) && isValid());
+}
+
+bool
+CRubikCubie::
+cornerFromColors(uint i, const uint8_t *colors, uint &perm, uint &ori)
+{
+  for (perm = 0; perm < NUM_CORNERS; ++perm) {
+    for (ori = 0; ori < 3; ++ori) {
+      uint n = 0;
+
+      while (n < 3 && colors[cornerFacelets[i][(n + ori) % 3]] == cornerFacelets[perm][n]/9)
+        ++n;
+
+      if (n == 3)
+        return true;
+    }
+  }
+
+  return false;
+}
+
+bool
+CRubikCubie::
+edgeFromColors(uint i, const uint8_t *colors, uint &perm, uint &ori)
+{
+  for (perm = 0; perm < NUM_EDGES; ++perm) {
+    for (ori = 0; ori < 2; ++ori) {
+      if (colors[edgeFacelets[i][ori    ]] == edgeFacelets[perm][0]/9 &&
+          colors[edgeFacelets[i][1 - ori]] == edgeFacelets[perm][1]/9)
+        return true;
+    }
+  }
+
+  return false;
+}
+
+bool
+CRubikCubie::
+faceletCorner(uint f, uint &i)
+{
+  uint8_t c = faceletMap().corner[f];
+
+  if (c == 0xFF) return false;
+
+  i = c/3;
+
+  return true;
+}
+
+bool
+CRubikCubie::
+faceletEdge(uint f, uint &i)
+{
+  uint8_t e = faceletMap().edge[f];
+
+  if (e == 0xFF) return false;
+
+  i = e/2;
+
+  return true;
+}
+
+bool
+CRubikCubie::
+fromBytes(const uint8_t *bytes)
+{
+  for (uint i = 0; i < NUM_CORNERS; ++i)
+    corners[i] = bytes[i] & 0x1F;
+
+  for (uint i = 0; i < NUM_EDGES; ++i)
+    edges[i] = bytes[NUM_CORNERS + i];
+
+  // U and F centers give the others (L and R are the remaining pair, not mirrored)
+  uint u = bytes[0] >> 5;
+  uint f = bytes[1] >> 5;
+
+  if (u >= NUM_CENTERS || f >= NUM_CENTERS)
+    return false;
+
+  centers[1] = uint8_t(u); centers[3] = uint8_t(oppositeSide[u]);
+  centers[2] = uint8_t(f); centers[5] = uint8_t(oppositeSide[f]);
+
+  uint r = 0;
+
+  while (r < NUM_CENTERS && (sideAxis[r] == sideAxis[u] || sideAxis[r] == sideAxis[f]))
+    ++r;
+
+  if (r == NUM_CENTERS)
+    return false;
+
+  centers[4] = uint8_t(r); centers[0] = uint8_t(oppositeSide[r]);
+
+  if (! isRotation(centers))
+    std::swap(centers[0], centers[4]);
+
+  return isValid();
+}
+
+void
+CRubikCubie::
+toBytes(uint8_t *bytes) const
+{
+  for (uint i = 0; i < NUM_CORNERS; ++i)
+    bytes[i] = corners[i];
+
+  for (uint i = 0; i < NUM_EDGES; ++i)
+    bytes[NUM_CORNERS + i] = edges[i];
+
+  bytes[0] |= uint8_t(centers[1] << 5);
+  bytes[1] |= uint8_t(centers[2] << 5);
+}
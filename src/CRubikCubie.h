@@ -0,0 +1,112 @@
+#ifndef CRUBIK_CUBIE_H
+#define CRUBIK_CUBIE_H
+
+#include <cstdint>
+#include <sys/types.h>
+
+// Results of the individual validity checks (each true unless it found a problem).
+struct CRubikValidity {
+  bool stickers { true }; // nine stickers of each color
+  bool cubies   { true }; // stickers make each cubie once and centers a whole cube rotation
+  bool twist    { true }; // total corner twist zero (mod 3)
+  bool flip     { true }; // total edge flip zero (mod 2)
+  bool parity   { true }; // corner, edge and center permutation parities match
+
+  bool isValid() const { return stickers && cubies && twist && flip && parity; }
+
+  // name of first failed check (empty if valid)
+  const char *reason() const;
+};
+
+// Compact cubie level cube state.
+//
+// Each corner and edge position holds one byte for the cubie currently in that position
+// and its orientation (corner: perm | twist << 3, edge: perm | flip << 4). Centers are
+// kept as a permutation of the six sides so slice and whole cube moves can be held too.
+//
+// Corner order : URF UFL ULB UBR DFR DLF DBL DRB
+// Edge order   : UR UF UL UB DR DF DL DB FR FL BL BR
+// Center order : L U F D R B (same as CQRubik side numbers)
+//
+// Facelet arrays are indexed by side*9 + col*3 + row and hold the original piece
+// (side*9 + id) now at that position.
+struct CRubikCubie {
+  enum { NUM_CORNERS  = 8  };
+  enum { NUM_EDGES    = 12 };
+  enum { NUM_CENTERS  = 6  };
+  enum { NUM_FACELETS = 54 };
+  enum { NUM_BYTES    = 20 };
+
+  uint8_t corners[NUM_CORNERS];
+  uint8_t edges  [NUM_EDGES];
+  uint8_t centers[NUM_CENTERS];
+
+  CRubikCubie() { reset(); }
+
+  void reset();
+
+  uint cornerPerm(uint i) const { return corners[i] & 7; }
+  uint cornerOri (uint i) const { return corners[i] >> 3; }
+  uint edgePerm  (uint i) const { return edges[i] & 15; }
+  uint edgeOri   (uint i) const { return edges[i] >> 4; }
+
+  void setCorner(uint i, uint perm, uint ori) { corners[i] = uint8_t(perm | (ori << 3)); }
+  void setEdge  (uint i, uint perm, uint ori) { edges  [i] = uint8_t(perm | (ori << 4)); }
+
+  // reason a state is not reachable from solved
+  enum class Validity {
+    VALID,
+    BAD_FACELETS, // facelets do not make cubies
+    BAD_CORNERS,  // corner missing or repeated
+    BAD_EDGES,    // edge missing or repeated
+    BAD_CENTERS,  // centers not a whole cube rotation
+    CORNER_TWIST, // total corner twist not zero (mod 3)
+    EDGE_FLIP,    // total edge flip not zero (mod 2)
+    PARITY        // corner, edge and center permutation parities do not match
+  };
+
+  bool isSolved() const;
+
+  // reachable state (each cubie once, total twist and flip zero, matching permutation
+  // parities and centers a whole cube rotation)
+  bool isValid() const { return validity() == Validity::VALID; }
+
+  Validity validity() const;
+
+  static const char *validityName(Validity validity);
+
+  // validity checks with unknown corner and edge positions (bit masks) skipped : twist,
+  // flip and parity are only checked if all the cubies they need are known (stickers is
+  // not checked)
+  CRubikValidity checkValidity(uint unknownCorners=0, uint unknownEdges=0) const;
+
+  bool operator==(const CRubikCubie &cubie) const;
+  bool operator!=(const CRubikCubie &cubie) const { return ! (*this == cubie); }
+
+  // apply cubie (as a move) to this state
+  void multiply(const CRubikCubie &cubie);
+
+  bool fromFacelets(const uint8_t *facelets);
+  void toFacelets  (uint8_t *facelets) const;
+
+  // facelet colors (side number of each facelet's color, same indices as facelets)
+  bool fromColors(const uint8_t *colors);
+
+  // cubie and twist (flip) matching the facelet colors at a corner (edge) position
+  static bool cornerFromColors(uint i, const uint8_t *colors, uint &perm, uint &ori);
+  static bool edgeFromColors  (uint i, const uint8_t *colors, uint &perm, uint &ori);
+
+  // corner (edge) position of a facelet (false if not on a corner (edge))
+  static bool faceletCorner(uint f, uint &i);
+  static bool faceletEdge  (uint f, uint &i);
+
+  // binary encoding (NUM_BYTES) : corner and edge bytes as stored with the U and F
+  // centers in the unused top bits of the first two corner bytes
+  bool fromBytes(const uint8_t *bytes);
+  void toBytes  (uint8_t *bytes) const;
+
+  static const uint8_t cornerFacelets[NUM_CORNERS][3];
+  static const uint8_t edgeFacelets  [NUM_EDGES  ][2];
+};
+
+#endif
@@ -0,0 +1,621 @@
+#include <CRubikKociemba.h>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+enum { NUM_TWIST       = 2187  }; // 3^7
+enum { NUM_FLIP        = 2048  }; // 2^11
+enum { NUM_SLICE       = 495   }; // 12 choose 4
+enum { NUM_SLICE_PERM  = 24    }; // 4!
+enum { NUM_SLICE_SORT  = 11880 }; // NUM_SLICE*NUM_SLICE_PERM
+enum { NUM_CORNER_PERM = 40320 }; // 8!
+enum { NUM_EDGE_PERM   = 40320 }; // 8!
+
+enum { MAX_PHASE1 = 12 };
+enum { MAX_PHASE2 = 18 };
+enum { MAX_LENGTH = 31 };
+
+const uint NUM_FACE_MOVES = CRubikMove::NUM_FACE_MOVES;
+
+// moves of phase 2 : U, D and half turns of the other faces
+const uint phase2Moves[] = {
+  CRubikMove::BASE_U*3 + CRubikMove::TURN_CW,
+  CRubikMove::BASE_U*3 + CRubikMove::TURN_2,
+  CRubikMove::BASE_U*3 + CRubikMove::TURN_CCW,
+  CRubikMove::BASE_D*3 + CRubikMove::TURN_CW,
+  CRubikMove::BASE_D*3 + CRubikMove::TURN_2,
+  CRubikMove::BASE_D*3 + CRubikMove::TURN_CCW,
+  CRubikMove::BASE_L*3 + CRubikMove::TURN_2,
+  CRubikMove::BASE_F*3 + CRubikMove::TURN_2,
+  CRubikMove::BASE_R*3 + CRubikMove::TURN_2,
+  CRubikMove::BASE_B*3 + CRubikMove::TURN_2,
+};
+
+const uint NUM_PHASE2_MOVES = sizeof(phase2Moves)/sizeof(phase2Moves[0]);
+
+// axis of each face (L U F D R B) for ordering moves on opposite faces
+const uint faceAxis[] = { 0, 1, 2, 1, 0, 2 };
+
+// skip move on same face as last or on opposite face in the wrong order
+inline bool
+skipMove(uint lastMove, uint move)
+{
+  uint face1 = CRubikMove::base(lastMove);
+  uint face2 = CRubikMove::base(move);
+
+  return (face1 == face2 || (faceAxis[face1] == faceAxis[face2] && face2 < face1));
+}
+
+//---
+
+uint
+cnk(uint n, uint k)
+{
+  if (n < k) return 0;
+
+  if (k > n/2) k = n - k;
+
+  uint s = 1;
+
+  for (uint i = n, j = 1; i != n - k; --i, ++j) {
+    s *= i;
+    s /= j;
+  }
+
+  return s;
+}
+
+void
+rotateLeft(uint8_t *a, uint l, uint r)
+{
+  uint8_t t = a[l];
+
+  for (uint i = l; i < r; ++i)
+    a[i] = a[i + 1];
+
+  a[r] = t;
+}
+
+void
+rotateRight(uint8_t *a, uint l, uint r)
+{
+  uint8_t t = a[r];
+
+  for (uint i = r; i > l; --i)
+    a[i] = a[i - 1];
+
+  a[l] = t;
+}
+
+// permutation coordinate of values offset..offset + n - 1
+uint
+getPerm(const uint8_t *perm, uint n, uint offset)
+{
+  uint8_t p[12];
+
+  memcpy(p, perm, n);
+
+  uint b = 0;
+
+  for (uint j = n - 1; j > 0; --j) {
+    uint k = 0;
+
+    while (p[j] != j + offset) {
+      rotateLeft(p, 0, j);
+
+      ++k;
+    }
+
+    b = (j + 1)*b + k;
+  }
+
+  return b;
+}
+
+void
+setPerm(uint8_t *perm, uint n, uint offset, uint idx)
+{
+  for (uint i = 0; i < n; ++i)
+    perm[i] = uint8_t(i + offset);
+
+  for (uint j = 0; j < n; ++j) {
+    uint k = idx % (j + 1);
+
+    idx /= j + 1;
+
+    for ( ; k > 0; --k)
+      rotateRight(perm, 0, j);
+  }
+}
+
+//---
+
+uint
+getTwist(const CRubikCubie &cubie)
+{
+  uint twist = 0;
+
+  for (uint i = 0; i < CRubikCubie::NUM_CORNERS - 1; ++i)
+    twist = 3*twist + cubie.cornerOri(i);
+
+  return twist;
+}
+
+void
+setTwist(CRubikCubie &cubie, uint twist)
+{
+  uint sum = 0;
+
+  for (int i = CRubikCubie::NUM_CORNERS - 2; i >= 0; --i) {
+    uint ori = twist % 3;
+
+    cubie.setCorner(i, cubie.cornerPerm(i), ori);
+
+    sum   += ori;
+    twist /= 3;
+  }
+
+  uint i = CRubikCubie::NUM_CORNERS - 1;
+
+  cubie.setCorner(i, cubie.cornerPerm(i), (3 - sum % 3) % 3);
+}
+
+uint
+getFlip(const CRubikCubie &cubie)
+{
+  uint flip = 0;
+
+  for (uint i = 0; i < CRubikCubie::NUM_EDGES - 1; ++i)
+    flip = 2*flip + cubie.edgeOri(i);
+
+  return flip;
+}
+
+void
+setFlip(CRubikCubie &cubie, uint flip)
+{
+  uint sum = 0;
+
+  for (int i = CRubikCubie::NUM_EDGES - 2; i >= 0; --i) {
+    uint ori = flip & 1;
+
+    cubie.setEdge(i, cubie.edgePerm(i), ori);
+
+    sum  += ori;
+    flip >>= 1;
+  }
+
+  uint i = CRubikCubie::NUM_EDGES - 1;
+
+  cubie.setEdge(i, cubie.edgePerm(i), sum & 1);
+}
+
+// position (combination) and order of the slice edges FR FL BL BR (8..11).
+// Zero when the slice edges are in the slice, in order.
+uint
+getSliceSorted(const CRubikCubie &cubie)
+{
+  uint    a = 0, x = 0;
+  uint8_t edge4[4];
+
+  for (int j = CRubikCubie::NUM_EDGES - 1; j >= 0; --j) {
+    uint e = cubie.edgePerm(j);
+
+    if (e >= 8) {
+      a += cnk(11 - j, x + 1);
+
+      edge4[3 - x] = uint8_t(e);
+
+      ++x;
+    }
+  }
+
+  return NUM_SLICE_PERM*a + getPerm(edge4, 4, 8);
+}
+
+void
+setSliceSorted(CRubikCubie &cubie, uint idx)
+{
+  uint8_t sliceEdges[4];
+
+  setPerm(sliceEdges, 4, 8, idx % NUM_SLICE_PERM);
+
+  uint a = idx / NUM_SLICE_PERM;
+
+  int ep[CRubikCubie::NUM_EDGES];
+
+  for (uint j = 0; j < CRubikCubie::NUM_EDGES; ++j)
+    ep[j] = -1;
+
+  uint x = 4;
+
+  for (uint j = 0; j < CRubikCubie::NUM_EDGES && x > 0; ++j) {
+    uint c = cnk(11 - j, x);
+
+    if (a >= c) {
+      ep[j] = sliceEdges[4 - x];
+
+      a -= c;
+
+      --x;
+    }
+  }
+
+  x = 0;
+
+  for (uint j = 0; j < CRubikCubie::NUM_EDGES; ++j)
+    if (ep[j] == -1)
+      ep[j] = int(x++);
+
+  for (uint j = 0; j < CRubikCubie::NUM_EDGES; ++j)
+    cubie.setEdge(j, ep[j], cubie.edgeOri(j));
+}
+
+uint
+getCorners(const CRubikCubie &cubie)
+{
+  uint8_t cp[CRubikCubie::NUM_CORNERS];
+
+  for (uint i = 0; i < CRubikCubie::NUM_CORNERS; ++i)
+    cp[i] = uint8_t(cubie.cornerPerm(i));
+
+  return getPerm(cp, CRubikCubie::NUM_CORNERS, 0);
+}
+
+void
+setCorners(CRubikCubie &cubie, uint idx)
+{
+  uint8_t cp[CRubikCubie::NUM_CORNERS];
+
+  setPerm(cp, CRubikCubie::NUM_CORNERS, 0, idx);
+
+  for (uint i = 0; i < CRubikCubie::NUM_CORNERS; ++i)
+    cubie.setCorner(i, cp[i], cubie.cornerOri(i));
+}
+
+// permutation of the U and D edges (UR..DB) when they are in the U and D faces
+uint
+getEdges(const CRubikCubie &cubie)
+{
+  uint8_t ep[8];
+
+  for (uint i = 0; i < 8; ++i)
+    ep[i] = uint8_t(cubie.edgePerm(i));
+
+  return getPerm(ep, 8, 0);
+}
+
+void
+setEdges(CRubikCubie &cubie, uint idx)
+{
+  uint8_t ep[8];
+
+  setPerm(ep, 8, 0, idx);
+
+  for (uint i = 0; i < 8; ++i)
+    cubie.setEdge(i, ep[i], cubie.edgeOri(i));
+
+  for (uint i = 8; i < CRubikCubie::NUM_EDGES; ++i)
+    cubie.setEdge(i, i, cubie.edgeOri(i));
+}
+
+//---
+
+struct Tables {
+  uint16_t twistMove  [NUM_TWIST      ][NUM_FACE_MOVES];
+  uint16_t flipMove   [NUM_FLIP       ][NUM_FACE_MOVES];
+  uint16_t sliceMove  [NUM_SLICE_SORT ][NUM_FACE_MOVES];
+  uint16_t cornersMove[NUM_CORNER_PERM][NUM_FACE_MOVES];
+  uint16_t edgesMove  [NUM_EDGE_PERM  ][NUM_FACE_MOVES]; // phase 2 moves only
+
+  uint8_t twistSlicePrune [NUM_TWIST*NUM_SLICE];
+  uint8_t flipSlicePrune  [NUM_FLIP*NUM_SLICE];
+  uint8_t cornersSlicePrune[NUM_CORNER_PERM*NUM_SLICE_PERM];
+  uint8_t edgesSlicePrune  [NUM_EDGE_PERM*NUM_SLICE_PERM];
+
+  Tables() {
+    initMoves(twistMove  , NUM_TWIST      , setTwist      , getTwist      , false);
+    initMoves(flipMove   , NUM_FLIP       , setFlip       , getFlip       , false);
+    initMoves(sliceMove  , NUM_SLICE_SORT , setSliceSorted, getSliceSorted, false);
+    initMoves(cornersMove, NUM_CORNER_PERM, setCorners    , getCorners    , false);
+    initMoves(edgesMove  , NUM_EDGE_PERM  , setEdges      , getEdges      , true );
+
+    // phase 1 : twist/flip with slice edge positions (slice sorted / 24)
+    initPrune(twistSlicePrune, NUM_TWIST, NUM_SLICE, false,
+      [&](uint i, uint m) {
+        uint twist = i / NUM_SLICE, slice = i % NUM_SLICE;
+
+        return twistMove[twist][m]*NUM_SLICE + sliceMove[slice*NUM_SLICE_PERM][m]/NUM_SLICE_PERM;
+      });
+
+    initPrune(flipSlicePrune, NUM_FLIP, NUM_SLICE, false,
+      [&](uint i, uint m) {
+        uint flip = i / NUM_SLICE, slice = i % NUM_SLICE;
+
+        return flipMove[flip][m]*NUM_SLICE + sliceMove[slice*NUM_SLICE_PERM][m]/NUM_SLICE_PERM;
+      });
+
+    // phase 2 : corner/edge permutation with slice edge permutation
+    initPrune(cornersSlicePrune, NUM_CORNER_PERM, NUM_SLICE_PERM, true,
+      [&](uint i, uint m) {
+        uint corners = i / NUM_SLICE_PERM, slice = i % NUM_SLICE_PERM;
+
+        return cornersMove[corners][m]*NUM_SLICE_PERM + sliceMove[slice][m];
+      });
+
+    initPrune(edgesSlicePrune, NUM_EDGE_PERM, NUM_SLICE_PERM, true,
+      [&](uint i, uint m) {
+        uint edges = i / NUM_SLICE_PERM, slice = i % NUM_SLICE_PERM;
+
+        return edgesMove[edges][m]*NUM_SLICE_PERM + sliceMove[slice][m];
+      });
+  }
+
+  template<typename SET, typename GET>
+  static void initMoves(uint16_t (*table)[NUM_FACE_MOVES], uint n, SET set, GET get,
+                        bool phase2) {
+    for (uint i = 0; i < n; ++i) {
+      CRubikCubie cubie;
+
+      set(cubie, i);
+
+      for (uint face = 0; face < CRubikCubie::NUM_CENTERS; ++face) {
+        const CRubikCubie &faceCubie =
+          CRubikMove::cubie(CRubikMove::move(face, CRubikMove::TURN_CW));
+
+        CRubikCubie cubie1 = cubie;
+
+        for (uint turn = 0; turn < 3; ++turn) {
+          cubie1.multiply(faceCubie);
+
+          uint m = CRubikMove::move(face, turn);
+
+          bool valid = (! phase2 || std::find(phase2Moves, phase2Moves + NUM_PHASE2_MOVES, m) !=
+                                    phase2Moves + NUM_PHASE2_MOVES);
+
+          table[i][m] = uint16_t(valid ? get(cubie1) : 0);
+        }
+      }
+    }
+  }
+
+  // breadth first search from the solved state
+  template<typename MOVE>
+  static void initPrune(uint8_t *prune, uint n1, uint n2, bool phase2, MOVE move) {
+    uint n = n1*n2;
+
+    memset(prune, 0xFF, n);
+
+    std::vector<uint32_t> queue(n);
+
+    uint head = 0, tail = 0;
+
+    prune[0] = 0; queue[tail++] = 0;
+
+    while (head < tail) {
+      uint i = queue[head++];
+
+      uint nm = (phase2 ? NUM_PHASE2_MOVES : NUM_FACE_MOVES);
+
+      for (uint k = 0; k < nm; ++k) {
+        uint m = (phase2 ? phase2Moves[k] : k);
+
+        uint j = move(i, m);
+
+        if (prune[j] == 0xFF) {
+          prune[j] = uint8_t(prune[i] + 1);
+
+          queue[tail++] = j;
+        }
+      }
+    }
+  }
+};
+
+const Tables &
+tables()
+{
+  static Tables *tables = new Tables;
+
+  return *tables;
+}
+
+}
+
+//---
+
+CRubikKociemba::
+CRubikKociemba()
+{
+}
+
+void
+CRubikKociemba::
+init()
+{
+  (void) tables();
+}
+
+bool
+CRubikKociemba::
+solve(const CRubikCubie &cubie, std::vector<uint> &moves)
+{
+  cubie_ = cubie;
+
+  best_.clear();
+
+  bestLength_ = MAX_LENGTH;
+  done_       = false;
+  numNodes_   = 0;
+
+  // tables are shared so are always built (cancel checked after)
+  const Tables &t = tables();
+
+  if (cancelled_)
+    return false;
+
+  endTime_ = Clock::now() + std::chrono::milliseconds(timeout_);
+
+  if (cubie_.isSolved()) {
+    moves.clear();
+    return true;
+  }
+
+  uint twist = getTwist      (cubie_);
+  uint flip  = getFlip       (cubie_);
+  uint slice = getSliceSorted(cubie_);
+
+  uint dist = std::max(t.twistSlicePrune[twist*NUM_SLICE + slice/NUM_SLICE_PERM],
+                       t.flipSlicePrune [flip *NUM_SLICE + slice/NUM_SLICE_PERM]);
+
+  for (uint depth1 = dist; depth1 <= MAX_PHASE1 && depth1 < bestLength_; ++depth1) {
+    if (progressProc_)
+      progressProc_(depth1, numNodes_);
+
+    search1(twist, flip, slice, 0, depth1);
+
+    // finish each phase 1 depth (later solutions have shorter phase 2) before stopping
+    if (done_ || bestLength_ <= maxLength_) break;
+  }
+
+  if (cancelled_ || best_.empty())
+    return false;
+
+  moves = best_;
+
+  return true;
+}
+
+void
+CRubikKociemba::
+search1(uint twist, uint flip, uint slice, uint depth, uint togo)
+{
+  if (done_ || isTimedOut())
+    return;
+
+  if (togo == 0) {
+    if (twist == 0 && flip == 0 && slice < NUM_SLICE_PERM)
+      phase2Start(depth);
+
+    return;
+  }
+
+  const Tables &t = tables();
+
+  for (uint m = 0; m < NUM_FACE_MOVES; ++m) {
+    if (depth > 0 && skipMove(moves_[depth - 1], m))
+      continue;
+
+    uint twist1 = t.twistMove[twist][m];
+    uint flip1  = t.flipMove [flip ][m];
+    uint slice1 = t.sliceMove[slice][m];
+
+    uint dist = std::max(t.twistSlicePrune[twist1*NUM_SLICE + slice1/NUM_SLICE_PERM],
+                         t.flipSlicePrune [flip1 *NUM_SLICE + slice1/NUM_SLICE_PERM]);
+
+    if (dist >= togo)
+      continue;
+
+    moves_[depth] = m;
+
+    search1(twist1, flip1, slice1, depth + 1, togo - 1);
+
+    if (done_) return;
+  }
+}
+
+void
+CRubikKociemba::
+phase2Start(uint depth1)
+{
+  // phase 1 solutions ending in a phase 2 move were found at the previous depth
+  if (depth1 > 0) {
+    uint m = moves_[depth1 - 1];
+
+    if (std::find(phase2Moves, phase2Moves + NUM_PHASE2_MOVES, m) !=
+        phase2Moves + NUM_PHASE2_MOVES)
+      return;
+  }
+
+  const Tables &t = tables();
+
+  CRubikCubie cubie = cubie_;
+
+  for (uint i = 0; i < depth1; ++i)
+    cubie.multiply(CRubikMove::cubie(moves_[i]));
+
+  uint corners = getCorners    (cubie);
+  uint edges   = getEdges      (cubie);
+  uint slice   = getSliceSorted(cubie);
+
+  uint dist = std::max(t.cornersSlicePrune[corners*NUM_SLICE_PERM + slice],
+                       t.edgesSlicePrune  [edges  *NUM_SLICE_PERM + slice]);
+
+  uint limit = std::min(bestLength_ - depth1, uint(MAX_PHASE2 + 1));
+
+  for (uint togo2 = dist; togo2 < limit; ++togo2) {
+    if (search2(corners, edges, slice, depth1, togo2)) {
+      bestLength_ = depth1 + togo2;
+
+      best_.assign(moves_, moves_ + bestLength_);
+
+      break;
+    }
+
+    if (done_) break;
+  }
+}
+
+bool
+CRubikKociemba::
+search2(uint corners, uint edges, uint slice, uint depth, uint togo)
+{
+  if (togo == 0)
+    return (corners == 0 && edges == 0 && slice == 0);
+
+  if (done_ || isTimedOut())
+    return false;
+
+  const Tables &t = tables();
+
+  for (uint k = 0; k < NUM_PHASE2_MOVES; ++k) {
+    uint m = phase2Moves[k];
+
+    if (depth > 0 && skipMove(moves_[depth - 1], m))
+      continue;
+
+    uint corners1 = t.cornersMove[corners][m];
+    uint edges1   = t.edgesMove  [edges  ][m];
+    uint slice1   = t.sliceMove  [slice  ][m];
+
+    uint dist = std::max(t.cornersSlicePrune[corners1*NUM_SLICE_PERM + slice1],
+                         t.edgesSlicePrune  [edges1  *NUM_SLICE_PERM + slice1]);
+
+    if (dist >= togo)
+      continue;
+
+    moves_[depth] = m;
+
+    if (search2(corners1, edges1, slice1, depth + 1, togo - 1))
+      return true;
+  }
+
+  return false;
+}
+
+bool
+CRubikKociemba::
+isTimedOut()
+{
+  // check cancel and clock every 4096 nodes
+  if ((++numNodes_ & 0xFFF) != 0)
+    return false;
+
+  if (! cancelled_ && (timeout_ == 0 || Clock::now() < endTime_))
+    return false;
+
+  done_ = true;
+
+  return true;
+}
@@ -0,0 +1,84 @@
+#ifndef CRUBIK_KOCIEMBA_H
+#define CRUBIK_KOCIEMBA_H
+
+#include <CRubikMove.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <vector>
+
+// Two phase (Kociemba) solver.
+//
+// Phase 1 searches with face moves until corner twist, edge flip and the UD slice
+// edge positions are solved (the cube is then in the group <U, D, L2, F2, R2, B2>).
+// Phase 2 solves the remaining corner, edge and slice permutations using only moves
+// from that group. Both phases are IDA* searches over coordinate move tables with
+// pruning tables giving a lower bound of the moves to the phase goal.
+//
+// Phase 1 solutions are tried in increasing length so the total solution shortens
+// over time. Each phase 1 length is searched to the end (so a short scramble gets its
+// solution with an empty phase 2 rather than the first one found) and the search stops
+// after the first length giving a solution of at most maxLength moves, when no shorter
+// solution is possible or when the timeout expires (the best solution found so far is
+// returned). The search can be cancelled from another thread (no solution is returned).
+//
+// The cubie centers must be solved (use whole cube rotations first). Solutions are
+// face moves (CRubikMove ids < NUM_FACE_MOVES) counted in the half turn metric.
+class CRubikKociemba {
+ public:
+  // called at the start of each phase 1 depth
+  using ProgressProc = std::function<void (uint depth, uint64_t numNodes)>;
+
+ public:
+  CRubikKociemba();
+
+  uint maxLength() const { return maxLength_; }
+  void setMaxLength(uint n) { maxLength_ = n; }
+
+  // timeout in milliseconds (0 for none)
+  uint timeout() const { return timeout_; }
+  void setTimeout(uint t) { timeout_ = t; }
+
+  // number of nodes expanded by the last solve
+  uint64_t numNodes() const { return numNodes_; }
+
+  void setProgressProc(const ProgressProc &proc) { progressProc_ = proc; }
+
+  // stop running solve (thread safe), stays cancelled until cleared
+  void cancel() { cancelled_ = true; }
+
+  void clearCancel() { cancelled_ = false; }
+
+  bool isCancelled() const { return cancelled_; }
+
+  bool solve(const CRubikCubie &cubie, std::vector<uint> &moves);
+
+  // build move and pruning tables (done on first solve if not called)
+  static void init();
+
+ private:
+  void search1(uint twist, uint flip, uint slice, uint depth, uint togo);
+
+  bool search2(uint corners, uint edges, uint slice, uint depth, uint togo);
+
+  void phase2Start(uint depth1);
+
+  bool isTimedOut();
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  uint              maxLength_ { 22 };
+  uint              timeout_   { 1000 };
+  CRubikCubie       cubie_;
+  uint              moves_[32];
+  uint              bestLength_ { 0 };
+  std::vector<uint> best_;
+  bool              done_      { false };
+  uint64_t          numNodes_  { 0 };
+  Clock::time_point endTime_;
+  std::atomic<bool> cancelled_ { false };
+  ProgressProc      progressProc_;
+};
+
+#endif
@@ -0,0 +1,3004 @@
+#include <CRubikModel.h>
+
+CRubikModel::
+CRubikModel()
+{
+  reset();
+
+  kociemba_.setProgressProc([this](uint depth, uint64_t numNodes) {
+    progress("Two phase : depth " + std::to_string(depth) +
+             " (" + std::to_string(numNodes) + " nodes)");
+  });
+
+  optimal_.setProgressProc([this](uint depth, uint64_t numNodes) {
+    progress("Optimal : depth " + std::to_string(depth) +
+             " (" + std::to_string(numNodes) + " nodes)");
+  });
+}
+
+void
+CRubikModel::
+reset()
+{
+  for (uint i = 0; i < CUBE_SIDES; ++i) {
+    CRubikSide &side = sides_[i];
+
+    for (uint k = 0, id = 0; k < SIDE_COLS; ++k)
+      for (uint j = 0; j < SIDE_ROWS; ++j, ++id)
+        side.pieces[k][j] = CRubikPiece(i, id);
+  }
+
+  updatePositions();
+
+  cubie_.reset();
+
+  initValidity();
+}
+
+const CRubikSideData &
+CRubikModel::
+getSideData(uint i)
+{
+  static CRubikSideData sideData[CUBE_SIDES] = {
+    // Left Face
+    { "L", CRubikSideConnect(5,   0), CRubikSideConnect(2,   0),
+           CRubikSideConnect(1, -90), CRubikSideConnect(3,  90) },
+    // Up Face
+    { "U", CRubikSideConnect(0,  90), CRubikSideConnect(4, -90),
+           CRubikSideConnect(5, 180), CRubikSideConnect(2,   0) },
+    // Front Face
+    { "F", CRubikSideConnect(0,   0), CRubikSideConnect(4,   0),
+           CRubikSideConnect(1,   0), CRubikSideConnect(3,   0) },
+    // Down Face
+    { "D", CRubikSideConnect(0, -90), CRubikSideConnect(4,  90),
+           CRubikSideConnect(2,   0), CRubikSideConnect(5, 180) },
+    // Right Face
+    { "R", CRubikSideConnect(2,   0), CRubikSideConnect(5,   0),
+           CRubikSideConnect(1,  90), CRubikSideConnect(3, -90) },
+    // Back Face
+    { "B", CRubikSideConnect(4,   0), CRubikSideConnect(0,   0),
+           CRubikSideConnect(1, 180), CRubikSideConnect(3, 180) },
+  };
+
+  return sideData[i];
+}
+
+void
+CRubikModel::
+randomize()
+{
+  // uniform random state (not reported to the listener)
+  setCubie(random_.randomState());
+}
+
+bool
+CRubikModel::
+solve()
+{
+  if (! validity_.isValid())
+    return false;
+
+  // solver moves are not reported to the listener
+  CRubikModelListener *listener = nullptr;
+
+  std::swap(listener_, listener);
+
+  if (solveMethod_ == SolveMethod::LAYER)
+    progress("Layer");
+
+  bool rc = (solveMethod_ == SolveMethod::LAYER ? solve1() : solveCubie());
+
+  std::swap(listener_, listener);
+
+  return rc;
+}
+
+bool
+CRubikModel::
+solve(std::vector<uint> &moves)
+{
+  moves_ = &moves;
+
+  bool rc = solve();
+
+  moves_ = nullptr;
+
+  CRubikMove::optimize(moves);
+
+  return rc;
+}
+
+void
+CRubikModel::
+cancelSolve()
+{
+  kociemba_.cancel();
+  optimal_ .cancel();
+}
+
+void
+CRubikModel::
+clearCancelSolve()
+{
+  kociemba_.clearCancel();
+  optimal_ .clearCancel();
+}
+
+void
+CRubikModel::
+progress(const std::string &msg) const
+{
+  if (progressProc_)
+    progressProc_(msg);
+}
+
+bool
+CRubikModel::
+solveCubie()
+{
+  CRubikCubie cubie;
+
+  if (! getCubie(cubie))
+    return false;
+
+  // the cubie solvers need the centers on their sides so rotate whole cube first
+  std::vector<uint> orientMoves;
+
+  CRubikMove::orientMoves(cubie, orientMoves);
+
+  for (const auto &move : orientMoves)
+    cubie.multiply(CRubikMove::cubie(move));
+
+  std::vector<uint> faceMoves;
+
+  if (solveMethod_ == SolveMethod::OPTIMAL) {
+    if (! optimal_.isInitialized()) {
+      progress("Optimal : loading tables");
+
+      if (! optimal_.init())
+        return false;
+    }
+
+    if (! optimal_.solveOptimal(cubie, optimalDepth_, faceMoves))
+      return false;
+  }
+  else {
+    if (! kociemba_.solve(cubie, faceMoves))
+      return false;
+  }
+
+  for (const auto &move : orientMoves)
+    applyMove(move);
+
+  for (const auto &move : faceMoves)
+    applyMove(move);
+
+  return true;
+}
+
+bool
+CRubikModel::
+solve1()
+{
+  if (! solveTopInd4()) return false;
+
+  if (! solveTopInd1()) return false;
+  if (! solveTopInd3()) return false;
+  if (! solveTopInd5()) return false;
+  if (! solveTopInd7()) return false;
+
+  // Top Corners
+  if (! solveTopInd0()) return false;
+  if (! solveTopInd2()) return false;
+  if (! solveTopInd6()) return false;
+  if (! solveTopInd8()) return false;
+
+  // Middle Layer
+  if (! solveMidInd4()) return false;
+
+  if (! solveMidLeftInd3()) return false;
+  if (! solveMidLeftInd5()) return false;
+
+  if (! solveMidRightInd3()) return false;
+  if (! solveMidRightInd5()) return false;
+
+  // Last Layer
+  moveSidesLeft(); moveSidesLeft();
+
+  if (! solveBottomCross()) return false;
+
+  if (! solveBottomCornerOrder()) return false;
+
+  if (! solveBottomCornerOrient()) return false;
+
+  if (! solveBottomMiddles()) return false;
+
+  // Restore Original Top
+  moveSidesLeft(); moveSidesLeft();
+
+  return true;
+}
+
+bool
+CRubikModel::
+solveTopInd4()
+{
+  // Green center to top
+  CRubikPieceInd ind = findPiece(2, 4);
+
+  uint side_num = ind.side_num;
+
+  if (side_num == 2) return true;
+
+  if      (side_num == 0) moveSideRight(side_num, 1); // execute("mFMR");
+  else if (side_num == 1) moveSideDown (side_num, 1);
+  else if (side_num == 3) moveSideUp   (side_num, 1);
+  else if (side_num == 4) moveSideLeft (side_num, 1);
+  else if (side_num == 5) moveSideLeft2(side_num, 1);
+
+  ind = findPiece(2, 4);
+
+  if (! ind.assertInd("top 4", 2, 1, 1)) return false;
+
+  return true;
+}
+
+bool
+CRubikModel::
+solveTopInd1()
+{
+  // Green Cross on top (piece numbers 1L 3T 5B 7R)
+  CRubikPieceInd ind = findPiece(2, 1);
+
+  uint side_num = ind.side_num;
+  uint side_col = ind.side_col;
+  uint side_row = ind.side_row;
+
+  if (side_num == 2 && side_col == 0 && side_row == 1) return true;
+
+  if (side_num != 2) {
+    if      (side_col == 0) { }
+    else if (side_col == 2) rotateSide2(side_num);
+    else if (side_row == 0) rotateSide (side_num, true );
+    else if (side_row == 2) rotateSide (side_num, false);
+
+    if      (side_num == 0) {
+      moveSideUp  (side_num, 0); moveSideLeft (2, 1);
+      moveSideDown(side_num, 0); moveSideRight(2, 1);
+    }
+    else if (side_num == 1) {
+      moveSideDown(side_num, 0);
+    }
+    else if (side_num == 3) {
+      moveSideUp  (side_num, 0);
+    }
+    else if (side_num == 4) {
+      rotateSide2(side_num);
+      moveSideUp (side_num, 2); moveSideLeft (2, 1);
+      moveSideUp (side_num, 2); moveSideRight(2, 1);
+    }
+    else if (side_num == 5) {
+      rotateSide2(side_num);
+      moveSideUp(side_num, 2);
+      moveSideUp(side_num, 2);
+    }
+  }
+  else {
+    if      (side_col == 0) { }
+    else if (side_col == 2) rotateSide2(side_num);
+    else if (side_row == 0) rotateSide (side_num, true );
+    else if (side_row == 2) rotateSide (side_num, false);
+  }
+
+  ind = findPiece(2, 4); if (! ind.assertInd("top 4", 2, 1, 1)) return false;
+  ind = findPiece(2, 1); if (! ind.assertInd("top 1", 2, 0, 1)) return false;
+
+  return true;
+}
+
+bool
+CRubikModel::
+solveTopInd3()
+{
+  CRubikPieceInd ind = findPiece(2, 3);
+
+  uint side_num = ind.side_num;
+  uint side_col = ind.side_col;
+  uint side_row = ind.side_row;
+
+  if (side_num == 2 && side_col == 1 && side_row == 0) return true;
+
+  if      (side_num != 2 && side_num != 0) {
+    if      (side_row == 0) { }
+    else if (side_row == 2) rotateSide2(side_num);
+    else if (side_col == 0) rotateSide (side_num, false);
+    else if (side_col == 2) rotateSide (side_num, true );
+
+    if      (side_num == 0)
+      moveSideRight(side_num, 0);
+    else if (side_num == 1) {
+      moveSideLeft (1, 0); moveSideUp  (2, 1);
+      moveSideRight(1, 0); moveSideDown(2, 1);
+    }
+    else if (side_num == 3) {
+      rotateSide(3, false); rotateSide(2, false);
+      moveSideUp(3, 2); rotateSide(2, true);
+    }
+    else if (side_num == 4)
+      moveSideLeft (side_num, 0);
+    else if (side_num == 5)
+      moveSideLeft2(side_num, 0);
+  }
+  else if (side_num == 0) {
+    if      (side_row == 0)
+      moveSideRight(0, 0);
+    else if (side_row == 2) {
+      rotateSide2(2); moveSideRight(0, 2); rotateSide2(2);
+    }
+    else if (side_col == 0) {
+      moveSideUp(2, 1); moveSideUp(0, 0); moveSideDown(2, 1);
+    }
+    else if (side_col == 2) { // not possible
+    }
+  }
+  else if (side_num == 2) {
+    if      (side_row == 0) { }
+    else if (side_row == 2) {
+      moveSideDown(2, 1); moveSideLeft (3, 2); moveSideUp(2, 1); rotateSide2(2);
+      moveSideDown(2, 1); moveSideRight(3, 2); moveSideUp(2, 1); rotateSide2(2);
+    }
+    else if (side_col == 0) { }
+    else if (side_col == 2) {
+      moveSideRight(2, 1); moveSideUp(2, 1);
+      moveSideUp(4, 2);
+      moveSideDown(2, 1); moveSideLeft(2, 1);
+    }
+  }
+
+  ind = findPiece(2, 4); if (! ind.assertInd("top 4", 2, 1, 1)) return false;
+  ind = findPiece(2, 1); if (! ind.assertInd("top 1", 2, 0, 1)) return false;
+  ind = findPiece(2, 3); if (! ind.assertInd("top 3", 2, 1, 0)) return false;
+
+  return true;
+}
+
+bool
+CRubikModel::
+solveTopInd5()
+{
+  CRubikPieceInd ind = findPiece(2, 5);
+
+  uint side_num = ind.side_num;
+  uint side_col = ind.side_col;
+  uint side_row = ind.side_row;
+
+  if (side_num == 2 && side_col == 1 && side_row == 2) return true;
+
+  if (side_num != 2 && side_num != 0 && side_num != 1) {
+    if      (side_row == 2) { }
+    else if (side_row == 0) rotateSide2(side_num);
+    else if (side_col == 2) rotateSide (side_num, false);
+    else if (side_col == 0) rotateSide (side_num, true );
+
+    if      (side_num == 0)
+      moveSideRight(side_num, 2);
+    else if (side_num == 3) {
+      moveSideRight(3, 2); moveSideDown(3, 1);
+      moveSideLeft (3, 2); moveSideUp  (3, 1);
+    }
+    else if (side_num == 4)
+      moveSideLeft (side_num, 2);
+    else if (side_num == 5)
+      moveSideLeft2(side_num, 2);
+  }
+  else if (side_num == 2) {
+    if      (side_col == 0) { // not possible
+    }
+    else if (side_col == 2) {
+      moveSideDown(2, 2); rotateSide(2, true); moveSideUp(2, 2); rotateSide(2, false);
+    }
+    else if (side_row == 0) { // not possible
+    }
+    else if (side_row == 2) { // already done
+    }
+  }
+  else if (side_num == 0) {
+    if      (side_row == 0) {
+      rotateSide2(2); moveSideRight(0, 0); rotateSide2(2);
+    }
+    else if (side_row == 2)
+      moveSideRight(0, 2);
+    else if (side_col == 0) {
+      rotateSide(2, false); rotateSide(0, true); rotateSide(2, true); moveSideRight(0, 2);
+    }
+    else if (side_col == 2) {
+      rotateSide(2, true); moveSideRight(0, 0); rotateSide(2, false);
+    }
+  }
+  else if (side_num == 1) {
+    if      (side_row == 0) {
+      rotateSide(2, true);
+      moveSideRight(2, 1); moveSideRight(1, 0); moveSideLeft(2, 1);
+      rotateSide(2, false);
+    }
+    else if (side_row == 2) { // not possible
+    }
+    else if (side_col == 0) {
+      rotateSide(2, false); moveSideDown(1, 0); rotateSide(2, true);
+    }
+    else if (side_col == 2) {
+      rotateSide(2, true); moveSideDown(1, 2); rotateSide(2, false);
+    }
+  }
+
+  ind = findPiece(2, 4); if (! ind.assertInd("top 4", 2, 1, 1)) return false;
+  ind = findPiece(2, 1); if (! ind.assertInd("top 1", 2, 0, 1)) return false;
+  ind = findPiece(2, 3); if (! ind.assertInd("top 3", 2, 1, 0)) return false;
+  ind = findPiece(2, 5); if (! ind.assertInd("top 5", 2, 1, 2)) return false;
+
+  return true;
+}
+
+bool
+CRubikModel::
+solveTopInd7()
+{
+  CRubikPieceInd ind = findPiece(2, 7);
+
+  uint side_num = ind.side_num;
+  uint side_col = ind.side_col;
+  uint side_row = ind.side_row;
+
+  if (side_num == 2 && side_col == 2 && side_row == 1) return true;
+
+  if (side_num != 2 && side_num != 0 && side_num != 1 && side_num != 3) {
+    if      (side_col == 2) { }
+    else if (side_col == 0) rotateSide2(side_num);
+    else if (side_row == 2) rotateSide (side_num, true );
+    else if (side_row == 0) rotateSide (side_num, false);
+
+    if      (side_num == 1)
+      moveSideDown(side_num, 2);
+    else if (side_num == 3)
+      moveSideUp  (side_num, 2);
+    else if (side_num == 4) {
+      moveSideUp  (4, 2); moveSideRight(2, 1);
+      moveSideDown(4, 2); moveSideLeft (2, 1);
+    }
+    else if (side_num == 5) {
+      rotateSide2(5);
+      moveSideRight(5, 1); moveSideUp(4, 2); moveSideUp(4, 2); moveSideLeft(5, 1);
+    }
+  }
+  else if (side_num == 2) {
+    // must be correct
+  }
+  else if (side_num == 0) {
+    if      (side_col == 2) { // not possible
+    }
+    else if (side_col == 0) {
+      moveSideUp  (0, 0); rotateSide2  (2   ); moveSideLeft(2, 1);
+      moveSideDown(0, 0); moveSideRight(2, 1); rotateSide2 (2   );
+    }
+    else if (side_row == 2) {
+      rotateSide(2, false); moveSideRight(0, 2); rotateSide(2, true);
+    }
+    else if (side_row == 0) {
+      rotateSide(2, true); moveSideRight(0, 0); rotateSide(2, false);
+    }
+  }
+  else if (side_num == 1) {
+    if      (side_col == 2) {
+      moveSideDown(1, 2);
+    }
+    else if (side_col == 0) {
+      rotateSide(2, true); rotateSide2(1); rotateSide(2, false); moveSideDown(2, 2);
+    }
+    else if (side_row == 2) { // not possible
+    }
+    else if (side_row == 0) {
+      moveSideRight(1, 0); rotateSide  (2, true); moveSideUp(2, 1);
+      moveSideLeft (1, 0); moveSideDown(2, 1   ); rotateSide(2, false);
+    }
+  }
+  else if (side_num == 3) {
+    if      (side_col == 2) {
+      moveSideUp(3, 2);
+    }
+    else if (side_col == 0) {
+      rotateSide2(2); moveSideUp(3, 0); rotateSide2(2);
+    }
+    else if (side_row == 2) {
+      rotateSide(2, false); rotateSide(3, true); rotateSide(2, true); moveSideUp(2, 2);
+    }
+    else if (side_row == 0) { // not possible
+    }
+  }
+
+  ind = findPiece(2, 4); if (! ind.assertInd("top 4", 2, 1, 1)) return false;
+  ind = findPiece(2, 1); if (! ind.assertInd("top 1", 2, 0, 1)) return false;
+  ind = findPiece(2, 3); if (! ind.assertInd("top 3", 2, 1, 0)) return false;
+  ind = findPiece(2, 5); if (! ind.assertInd("top 5", 2, 1, 2)) return false;
+  ind = findPiece(2, 7); if (! ind.assertInd("top 7", 2, 2, 1)) return false;
+
+  return true;
+}
+
+bool
+CRubikModel::
+solveTopInd0()
+{
+  CRubikPieceInd ind = findPiece(2, 0);
+
+  uint side_num = ind.side_num;
+  uint side_col = ind.side_col;
+  uint side_row = ind.side_row;
+
+  if (side_num == 2 && side_col == 0 && side_row == 0) return true;
+
+  if      (side_num == 0) {
+    if (side_col == 2) {
+      if      (side_row == 0) {
+        moveSideLeft(0, 0); moveSideUp  (0, 0); moveSideRight(0, 0);
+      }
+      else if (side_row == 2) {
+        moveSideLeft(0, 2); moveSideDown(0, 0); moveSideRight(0, 2);
+      }
+
+      side_col = 0;
+    }
+
+    if (side_col == 0) {
+      if      (side_row == 0) {
+        moveSideDown(0, 0); moveSideLeft(0, 0); moveSideUp(0, 0); moveSideRight(2, 0);
+      }
+      else if (side_row == 2) {
+        moveSideLeft(1, 0); moveSideUp  (1, 0); moveSideRight2(1, 0); moveSideDown(1, 0);
+      }
+    }
+  }
+  else if (side_num == 1) {
+    if (side_row == 2) {
+      if      (side_col == 0) {
+        moveSideUp(1, 0); moveSideLeft(1, 0); moveSideDown(1, 0);
+      }
+      else if (side_col == 2) {
+        moveSideUp(1, 2); moveSideRight(1, 0); moveSideDown(1, 2);
+      }
+
+      side_row = 0;
+    }
+
+    if (side_row == 0) {
+      if      (side_col == 0) {
+        moveSideRight(1, 0); moveSideUp(1, 0); moveSideLeft(1, 0); moveSideDown(1, 0);
+      }
+      else if (side_col == 2) {
+        moveSideUp(0, 0); moveSideLeft(0, 0);
+        moveSideUp(0, 0); moveSideUp(0, 0); moveSideRight(0, 0);
+      }
+    }
+  }
+  else if (side_num == 2) {
+    if      (side_col == 0 && side_row == 0) { // done
+    }
+    else if (side_col == 0 && side_row == 2) {
+      moveSideLeft (0, 2); moveSideDown(0, 0);
+      moveSideUp   (1, 0); moveSideRight(1, 0); moveSideRight(1, 0); moveSideDown(1, 0);
+      moveSideRight(0, 2);
+    }
+    else if (side_col == 2 && side_row == 0) {
+      moveSideUp(2, 2); rotateSide(2, true); moveSideDown(2, 0);
+      moveSideRight2(1, 0); moveSideUp(2, 0);
+      rotateSide(2, false); moveSideDown(2, 2);
+    }
+    else if (side_col == 2 && side_row == 2) {
+      moveSideUp(2, 0); moveSideDown(2, 2); moveSideRight2(1, 0);
+      moveSideDown(2, 0); moveSideUp(2, 2);
+    }
+  }
+  else if (side_num == 3) {
+    if (side_row == 0) {
+      if      (side_col == 0) {
+        moveSideDown(3, 0); moveSideLeft (3, 2); moveSideUp(3, 0);
+      }
+      else if (side_col == 2) {
+        moveSideDown(3, 2); moveSideRight(3, 2); moveSideUp(3, 2);
+      }
+
+      side_row = 2;
+    }
+
+    if (side_row == 2) {
+      if      (side_col == 0) {
+        moveSideLeft(0, 0); moveSideUp(0, 0); moveSideRight(0, 0);
+      }
+      else if (side_col == 2) {
+        moveSideUp  (1, 0); moveSideLeft2(1, 0); moveSideDown(1, 0);
+      }
+    }
+  }
+  else if (side_num == 4) {
+    if (side_col == 0) {
+      if      (side_row == 0) {
+        moveSideRight(4, 0); moveSideUp  (4, 2); moveSideLeft(4, 0);
+      }
+      else if (side_row == 2) {
+        moveSideRight(4, 2); moveSideDown(4, 2); moveSideLeft(4, 2);
+      }
+
+      side_col = 2;
+    }
+
+    if (side_col == 2) {
+      if      (side_row == 0) {
+        moveSideUp  (2, 0); moveSideLeft  (1, 0); moveSideDown (2, 0);
+      }
+      else if (side_row == 2) {
+        moveSideLeft(2, 0); moveSideRight2(1, 0); moveSideRight(2, 0);
+      }
+    }
+  }
+  else if (side_num == 5) {
+    // move to 5,0,0
+    if      (side_col == 0 && side_row == 2) rotateSide(5, false);
+    else if (side_col == 2 && side_row == 0) rotateSide(5, true);
+    else if (side_col == 2 && side_row == 2) rotateSide2(5);
+
+    moveSideRight(2, 0); moveSideDown(0, 0); moveSideLeft (2, 0);
+    moveSideLeft (2, 0); moveSideUp  (0, 0); moveSideRight(2, 0);
+  }
+
+  ind = findPiece(2, 4); if (! ind.assertInd("top 4", 2, 1, 1)) return false;
+  ind = findPiece(2, 1); if (! ind.assertInd("top 1", 2, 0, 1)) return false;
+  ind = findPiece(2, 3); if (! ind.assertInd("top 3", 2, 1, 0)) return false;
+  ind = findPiece(2, 5); if (! ind.assertInd("top 5", 2, 1, 2)) return false;
+  ind = findPiece(2, 7); if (! ind.assertInd("top 7", 2, 2, 1)) return false;
+  ind = findPiece(2, 0); if (! ind.assertInd("top 0", 2, 0, 0)) return false;
+
+  return true;
+}
+
+bool
+CRubikModel::
+solveTopInd2()
+{
+  CRubikPieceInd ind = findPiece(2, 2);
+
+  uint side_num = ind.side_num;
+  uint side_col = ind.side_col;
+  uint side_row = ind.side_row;
+
+  if (side_num == 2 && side_col == 0 && side_row == 2) return true;
+
+  if      (side_num == 0) {
+    if (side_col == 2) {
+      if      (side_row == 0) { // not possible
+        moveSideLeft(0, 0); moveSideUp  (0, 0); moveSideRight(0, 0);
+      }
+      else if (side_row == 2) {
+        moveSideLeft(0, 2); moveSideDown(0, 0); moveSideRight(0, 2);
+      }
+
+      side_col = 0;
+    }
+
+    if (side_col == 0) {
+      if      (side_row == 0) {
+        moveSideLeft(3, 2); moveSideDown(3, 0); moveSideRight2(3, 2); moveSideUp   (3, 0);
+      }
+      else if (side_row == 2) {
+        moveSideUp  (0, 0); moveSideLeft(0, 2); moveSideDown  (0, 0); moveSideRight(0, 2);
+      }
+    }
+  }
+  else if (side_num == 1) {
+    if (side_row == 2) {
+      if      (side_col == 0) { // not possible
+      }
+      else if (side_col == 2) {
+        moveSideUp(1, 2); moveSideRight(1, 0); moveSideDown(1, 2);
+      }
+
+      side_row = 0;
+    }
+
+    if (side_row == 0) {
+      if      (side_col == 0) {
+        moveSideLeft(0, 2); moveSideDown(0, 0); moveSideRight(0, 2);
+      }
+      else if (side_col == 2) {
+        moveSideDown(3, 0); moveSideLeft2(3, 2); moveSideUp(3, 0);
+      }
+    }
+  }
+  else if (side_num == 2) {
+    if      (side_col == 0 && side_row == 0) { // not possible
+    }
+    else if (side_col == 0 && side_row == 2) { // done
+    }
+    else if (side_col == 2 && side_row == 0) {
+      moveSideRight(2, 0); moveSideLeft(2, 2);
+      moveSideUp2(0, 0);
+      moveSideRight(2, 2); moveSideLeft(2, 0);
+    }
+    else if (side_col == 2 && side_row == 2) {
+      moveSideDown(3, 2); moveSideRight(3, 2);
+      moveSideLeft(0, 2); moveSideDown2(0, 0); moveSideRight(0, 2); moveSideUp(3, 2);
+    }
+  }
+  else if (side_num == 3) {
+    if (side_row == 0) {
+      if      (side_col == 0) {
+        moveSideDown(3, 0); moveSideLeft (3, 2); moveSideUp(3, 0);
+      }
+      else if (side_col == 2) {
+        moveSideDown(3, 2); moveSideRight(3, 2); moveSideUp(3, 2);
+      }
+
+      side_row = 2;
+    }
+
+    if (side_row == 2) {
+      if      (side_col == 0) {
+        moveSideRight(3, 2); moveSideDown(3, 0); moveSideLeft (3, 2); moveSideUp   (3, 0);
+      }
+      else if (side_col == 2) {
+        moveSideDown (0, 0); moveSideLeft(0, 2); moveSideDown2(0, 0); moveSideRight(0, 2);
+      }
+    }
+  }
+  else if (side_num == 4) {
+    if (side_col == 0) {
+      if      (side_row == 0) {
+        moveSideRight(4, 0); moveSideUp  (4, 2); moveSideLeft(4, 0);
+      }
+      else if (side_row == 2) {
+        moveSideRight(4, 2); moveSideDown(4, 2); moveSideLeft(4, 2);
+      }
+
+      side_col = 2;
+    }
+
+    if (side_col == 2) {
+      if      (side_row == 0) {
+        moveSideLeft(0, 2); moveSideDown2(0, 0); moveSideRight(0, 2);
+      }
+      else if (side_row == 2) {
+        moveSideDown(3, 0); moveSideLeft (3, 2); moveSideUp   (3, 0);
+      }
+    }
+  }
+  else if (side_num == 5) {
+    // move to 5,0,2
+    if      (side_col == 0 && side_row == 0) rotateSide(5, true);
+    else if (side_col == 2 && side_row == 0) rotateSide2(5);
+    else if (side_col == 2 && side_row == 2) rotateSide(5, false);
+
+    moveSideRight(2, 2); moveSideUp  (0, 0); moveSideLeft (2, 2);
+    moveSideLeft (2, 2); moveSideDown(0, 0); moveSideRight(2, 2);
+  }
+
+  ind = findPiece(2, 4); if (! ind.assertInd("top 4", 2, 1, 1)) return false;
+  ind = findPiece(2, 1); if (! ind.assertInd("top 1", 2, 0, 1)) return false;
+  ind = findPiece(2, 3); if (! ind.assertInd("top 3", 2, 1, 0)) return false;
+  ind = findPiece(2, 5); if (! ind.assertInd("top 5", 2, 1, 2)) return false;
+  ind = findPiece(2, 7); if (! ind.assertInd("top 7", 2, 2, 1)) return false;
+  ind = findPiece(2, 0); if (! ind.assertInd("top 0", 2, 0, 0)) return false;
+  ind = findPiece(2, 2); if (! ind.assertInd("top 2", 2, 0, 2)) return false;
+
+  return true;
+}
+
+bool
+CRubikModel::
+solveTopInd6()
+{
+  CRubikPieceInd ind = findPiece(2, 6);
+
+  uint side_num = ind.side_num;
+  uint side_col = ind.side_col;
+  uint side_row = ind.side_row;
+
+  if (side_num == 2 && side_col == 2 && side_row == 0) return true;
+
+  if      (side_num == 0) {
+    if (side_col == 2) {
+      if      (side_row == 0) { // not possible
+      }
+      else if (side_row == 2) { // not possible
+      }
+
+      side_col = 0;
+    }
+
+    if (side_col == 0) {
+      if      (side_row == 0) {
+        moveSideUp(1, 2); moveSideRight(1, 0); moveSideDown(1, 2);
+      }
+      else if (side_row == 2) {
+        moveSideRight(4, 0); moveSideDown2(4, 2); moveSideLeft(4, 0);
+      }
+    }
+  }
+  else if (side_num == 1) {
+    if (side_row == 2) {
+      if      (side_col == 0) { // not possible
+      }
+      else if (side_col == 2) {
+        moveSideUp(1, 2); moveSideRight(1, 0); moveSideDown(1, 2);
+      }
+
+      side_row = 0;
+    }
+
+    if (side_row == 0) {
+      if      (side_col == 0) {
+        moveSideUp  (4, 2); moveSideRight(4, 0); moveSideDown2(4, 2); moveSideLeft(4, 0);
+      }
+      else if (side_col == 2) {
+        moveSideLeft(1, 0); moveSideUp   (1, 2); moveSideRight(1, 0); moveSideDown(1, 2);
+      }
+    }
+  }
+  else if (side_num == 2) {
+    if      (side_col == 0 && side_row == 0) { // not possible
+    }
+    else if (side_col == 0 && side_row == 2) { // done
+    }
+    else if (side_col == 2 && side_row == 0) { // not possible
+    }
+    else if (side_col == 2 && side_row == 2) {
+      moveSideRight(4, 2); moveSideDown  (4, 2);
+      moveSideUp   (1, 2); moveSideRight2(1, 0); moveSideDown(1, 2);
+      moveSideLeft (4, 2);
+    }
+  }
+  else if (side_num == 3) {
+    if (side_row == 0) {
+      if      (side_col == 0) { // not possible
+      }
+      else if (side_col == 2) {
+        moveSideDown(3, 2); moveSideRight(3, 2); moveSideUp(3, 2);
+      }
+
+      side_row = 2;
+    }
+
+    if (side_row == 2) {
+      if      (side_col == 0) {
+        moveSideUp(1, 2); moveSideRight2(1, 0); moveSideDown(1, 2);
+      }
+      else if (side_col == 2) {
+        moveSideRight(4, 0); moveSideUp(4, 2); moveSideLeft(4, 0);
+      }
+    }
+  }
+  else if (side_num == 4) {
+    if (side_col == 0) {
+      if      (side_row == 0) {
+        moveSideRight(4, 0); moveSideUp  (4, 2); moveSideLeft(4, 0);
+      }
+      else if (side_row == 2) {
+        moveSideRight(4, 2); moveSideDown(4, 2); moveSideLeft(4, 2);
+      }
+
+      side_col = 2;
+    }
+
+    if (side_col == 2) {
+      if      (side_row == 0) {
+        moveSideDown(4, 2); moveSideRight(4, 0); moveSideUp(4, 2); moveSideLeft(4, 0);
+      }
+      else if (side_row == 2) {
+        moveSideRight(1, 0); moveSideUp(1, 2); moveSideLeft2(1, 0); moveSideDown(1, 2);
+      }
+    }
+  }
+  else if (side_num == 5) {
+    // move to 5,0,0
+    if      (side_col == 0 && side_row == 2) rotateSide(5, false);
+    else if (side_col == 2 && side_row == 0) rotateSide(5, true);
+    else if (side_col == 2 && side_row == 2) rotateSide2(5);
+
+    moveSideRight(4, 0); moveSideUp    (4, 2); moveSideLeft(4, 0);
+    moveSideUp   (1, 2); moveSideRight2(1, 0); moveSideDown(1, 2);
+  }
+
+  ind = findPiece(2, 4); if (! ind.assertInd("top 4", 2, 1, 1)) return false;
+  ind = findPiece(2, 1); if (! ind.assertInd("top 1", 2, 0, 1)) return false;
+  ind = findPiece(2, 3); if (! ind.assertInd("top 3", 2, 1, 0)) return false;
+  ind = findPiece(2, 5); if (! ind.assertInd("top 5", 2, 1, 2)) return false;
+  ind = findPiece(2, 7); if (! ind.assertInd("top 7", 2, 2, 1)) return false;
+  ind = findPiece(2, 0); if (! ind.assertInd("top 0", 2, 0, 0)) return false;
+  ind = findPiece(2, 2); if (! ind.assertInd("top 2", 2, 0, 2)) return false;
+  ind = findPiece(2, 6); if (! ind.assertInd("top 6", 2, 2, 0)) return false;
+
+  return true;
+}
+
+bool
+CRubikModel::
+solveTopInd8()
+{
+  CRubikPieceInd ind = findPiece(2, 8);
+
+  uint side_num = ind.side_num;
+  uint side_col = ind.side_col;
+  uint side_row = ind.side_row;
+
+  if (side_num == 2 && side_col == 2 && side_row == 2) return true;
+
+  if      (side_num == 0) {
+    if (side_col == 2) {
+      if      (side_row == 0) { // not possible
+      }
+      else if (side_row == 2) { // not possible
+      }
+
+      side_col = 0;
+    }
+
+    if (side_col == 0) {
+      if      (side_row == 0) {
+        moveSideRight(4, 2); moveSideDown2(4, 2); moveSideLeft(4, 2);
+      }
+      else if (side_row == 2) {
+        moveSideDown(3, 2); moveSideRight(3, 2); moveSideUp(3, 2);
+      }
+    }
+  }
+  else if (side_num == 1) {
+    if (side_row == 2) {
+      if      (side_col == 0) { // not possible
+      }
+      else if (side_col == 2) { // not possible
+      }
+
+      side_row = 0;
+    }
+
+    if (side_row == 0) {
+      if      (side_col == 0) {
+        moveSideDown(3, 2); moveSideLeft2(3, 2); moveSideUp(3, 2);
+      }
+      else if (side_col == 2) {
+        moveSideRight(4, 2); moveSideDown(4, 2); moveSideLeft(4, 2);
+      }
+    }
+  }
+  else if (side_num == 2) {
+    if      (side_col == 0 && side_row == 0) { // not possible
+    }
+    else if (side_col == 0 && side_row == 2) { // not possible
+    }
+    else if (side_col == 2 && side_row == 0) { // not possible
+    }
+    else if (side_col == 2 && side_row == 2) { // done
+    }
+  }
+  else if (side_num == 3) {
+    if (side_row == 0) {
+      if      (side_col == 0) { // not possible
+      }
+      else if (side_col == 2) {
+        moveSideDown(3, 2); moveSideRight(3, 2); moveSideUp(3, 2);
+      }
+
+      side_row = 2;
+    }
+
+    if (side_row == 2) {
+      if      (side_col == 0) {
+        moveSideDown(4, 2); moveSideRight(4, 2); moveSideUp2(4, 2); moveSideLeft(4, 2);
+      }
+      else if (side_col == 2) {
+        moveSideLeft(3, 2); moveSideDown(3, 2); moveSideRight(3, 2); moveSideUp(3, 2);
+      }
+    }
+  }
+  else if (side_num == 4) {
+    if (side_col == 0) {
+      if      (side_row == 0) { // not possible
+      }
+      else if (side_row == 2) {
+        moveSideRight(4, 2); moveSideDown(4, 2); moveSideLeft(4, 2);
+      }
+
+      side_col = 2;
+    }
+
+    if (side_col == 2) {
+      if      (side_row == 0) {
+        moveSideRight(3, 2); moveSideDown(3, 2); moveSideLeft2(3, 2); moveSideUp(3, 2);
+      }
+      else if (side_row == 2) {
+        moveSideUp(4, 2); moveSideRight(4, 2); moveSideDown(4, 2); moveSideLeft(4, 2);
+      }
+    }
+  }
+  else if (side_num == 5) {
+    // move to 5,0,2
+    if      (side_col == 0 && side_row == 0) rotateSide(5, true);
+    else if (side_col == 2 && side_row == 0) rotateSide2(5);
+    else if (side_col == 2 && side_row == 2) rotateSide(5, false);
+
+    moveSideRight(4, 2); moveSideDown  (4, 2); moveSideLeft(4, 2);
+    moveSideDown (3, 2); moveSideRight2(3, 2); moveSideUp  (3, 2);
+  }
+
+  ind = findPiece(2, 4); if (! ind.assertInd("top 4", 2, 1, 1)) return false;
+  ind = findPiece(2, 1); if (! ind.assertInd("top 1", 2, 0, 1)) return false;
+  ind = findPiece(2, 3); if (! ind.assertInd("top 3", 2, 1, 0)) return false;
+  ind = findPiece(2, 5); if (! ind.assertInd("top 5", 2, 1, 2)) return false;
+  ind = findPiece(2, 7); if (! ind.assertInd("top 7", 2, 2, 1)) return false;
+  ind = findPiece(2, 0); if (! ind.assertInd("top 0", 2, 0, 0)) return false;
+  ind = findPiece(2, 2); if (! ind.assertInd("top 2", 2, 0, 2)) return false;
+  ind = findPiece(2, 6); if (! ind.assertInd("top 6", 2, 2, 0)) return false;
+  ind = findPiece(2, 8); if (! ind.assertInd("top 8", 2, 2, 2)) return false;
+
+  return true;
+}
+
+bool
+CRubikModel::
+solveMidInd4()
+{
+  CRubikPieceInd ind = findPiece(0, 4);
+
+  uint side_num = ind.side_num;
+
+  if (side_num == 0) return true;
+
+  if      (side_num == 1) moveSideDown(0, 1);
+  else if (side_num == 3) moveSideUp  (0, 1);
+  else if (side_num == 4) moveSideUp2 (0, 1);
+
+  ind = findPiece(2, 4); if (! ind.assertInd("top 4", 2, 1, 1)) return false;
+  ind = findPiece(2, 1); if (! ind.assertInd("top 1", 2, 0, 1)) return false;
+  ind = findPiece(2, 3); if (! ind.assertInd("top 3", 2, 1, 0)) return false;
+  ind = findPiece(2, 5); if (! ind.assertInd("top 5", 2, 1, 2)) return false;
+  ind = findPiece(2, 7); if (! ind.assertInd("top 7", 2, 2, 1)) return false;
+  ind = findPiece(2, 0); if (! ind.assertInd("top 0", 2, 0, 0)) return false;
+  ind = findPiece(2, 2); if (! ind.assertInd("top 2", 2, 0, 2)) return false;
+  ind = findPiece(2, 6); if (! ind.assertInd("top 6", 2, 2, 0)) return false;
+  ind = findPiece(2, 8); if (! ind.assertInd("top 8", 2, 2, 2)) return false;
+  ind = findPiece(0, 4); if (! ind.assertInd("mid 4", 0, 1, 1)) return false;
+
+  return true;
+}
+
+bool
+CRubikModel::
+solveMidLeftInd3()
+{
+  CRubikPieceInd ind = findPiece(0, 3);
+
+  uint side_num = ind.side_num;
+  uint side_col = ind.side_col;
+  uint side_row = ind.side_row;
+
+  if (side_num == 0 && side_col == 1 && side_row == 0) return true;
+
+  if      (side_num == 1) {
+    if      (side_col == 0) {
+      moveSideDown (0, 0); moveSideLeft(0, 0); moveSideUp  (0, 0); moveSideRight(0, 0);
+      moveSideRight(1, 0); moveSideUp  (1, 0); moveSideLeft(1, 0); moveSideDown (1, 0);
+
+      moveSideDown2(0, 0);
+
+      side_num = 0; side_col = 0; side_row = 1;
+    }
+    else if (side_col == 2) {
+      moveSideDown(4, 2); moveSideRight(4, 0); moveSideUp   (4, 2); moveSideLeft(4, 0);
+      moveSideLeft(1, 0); moveSideUp   (1, 2); moveSideRight(1, 0); moveSideDown(1, 2);
+
+      side_num = 0; side_col = 0; side_row = 1;
+    }
+    else if (side_row == 0) {
+      moveSideDown(0, 0);
+
+      side_num = 0; side_col = 0; side_row = 1;
+    }
+    else if (side_row == 2) { // not possible
+    }
+  }
+  else if (side_num == 3) {
+    if      (side_col == 0) {
+      moveSideUp   (0, 0); moveSideLeft(0, 2); moveSideDown(0, 0); moveSideRight(0, 2);
+      moveSideRight(3, 2); moveSideDown(3, 0); moveSideLeft(3, 2); moveSideUp   (3, 0);
+      moveSideUp2  (0, 0);
+
+      side_num = 0; side_col = 0; side_row = 1;
+    }
+    else if (side_col == 2) {
+      moveSideUp  (4, 2); moveSideRight(4, 2); moveSideDown (4, 2); moveSideLeft(4, 2);
+      moveSideLeft(3, 2); moveSideDown (3, 2); moveSideRight(3, 2); moveSideUp  (3, 2);
+
+      side_num = 0; side_col = 0; side_row = 1;
+    }
+    else if (side_row == 0) { // not possible
+    }
+    else if (side_row == 2) {
+      moveSideUp(0, 0);
+
+      side_num = 0; side_col = 0; side_row = 1;
+    }
+  }
+  else if (side_num == 4) {
+    if      (side_col == 0) { // not possible
+    }
+    else if (side_col == 2) {
+      moveSideDown2(0, 0);
+
+      side_num = 0; side_col = 0; side_row = 1;
+    }
+    else if (side_row == 0) {
+      moveSideLeft(1, 0); moveSideUp   (1, 2); moveSideRight(1, 0); moveSideDown(1, 2);
+      moveSideDown(4, 2); moveSideRight(4, 0); moveSideUp   (4, 2); moveSideLeft(4, 0);
+
+      moveSideUp(0, 0);
+
+      side_num = 0; side_col = 0; side_row = 1;
+    }
+    else if (side_row == 2) {
+      moveSideLeft(3, 2); moveSideDown (3, 2); moveSideRight(3, 2); moveSideUp  (3, 2);
+      moveSideUp  (4, 2); moveSideRight(4, 2); moveSideDown (4, 2); moveSideLeft(4, 2);
+
+      moveSideDown(0, 0);
+
+      side_num = 0; side_col = 0; side_row = 1;
+    }
+  }
+
+  if      (side_num == 0) {
+    if (side_row == 2) {
+      moveSideRight(3, 2); moveSideDown(3, 0); moveSideLeft(3, 2); moveSideUp   (3, 0);
+      moveSideUp   (0, 0); moveSideLeft(0, 2); moveSideDown(0, 0); moveSideRight(0, 2);
+
+      moveSideDown(0, 0);
+
+      side_col = 0; side_row = 1;
+    }
+
+    if      (side_col == 0) {
+      moveSideDown (0, 0); moveSideLeft(0, 0); moveSideUp  (0, 0); moveSideRight(0, 0);
+      moveSideRight(1, 0); moveSideUp  (1, 0); moveSideLeft(1, 0); moveSideDown (1, 0);
+    }
+    else if (side_col == 2) { // not possible
+    }
+    else if (side_row == 0) { // done
+    }
+  }
+  else if (side_num == 5) {
+    // move to side_row 0
+    if      (side_col == 0) {
+      rotateSide(5, false);
+    }
+    else if (side_col == 2) {
+      rotateSide(5, true);
+    }
+    else if (side_row == 2) {
+      rotateSide2(5);
+    }
+
+    moveSideRight(1, 0); moveSideUp  (1, 0); moveSideLeft(1, 0); moveSideDown (1, 0);
+    moveSideDown (0, 0); moveSideLeft(0, 0); moveSideUp  (0, 0); moveSideRight(0, 0);
+  }
+
+  ind = findPiece(2, 4); if (! ind.assertInd("top 4", 2, 1, 1)) return false;
+  ind = findPiece(2, 1); if (! ind.assertInd("top 1", 2, 0, 1)) return false;
+  ind = findPiece(2, 3); if (! ind.assertInd("top 3", 2, 1, 0)) return false;
+  ind = findPiece(2, 5); if (! ind.assertInd("top 5", 2, 1, 2)) return false;
+  ind = findPiece(2, 7); if (! ind.assertInd("top 7", 2, 2, 1)) return false;
+  ind = findPiece(2, 0); if (! ind.assertInd("top 0", 2, 0, 0)) return false;
+  ind = findPiece(2, 2); if (! ind.assertInd("top 2", 2, 0, 2)) return false;
+  ind = findPiece(2, 6); if (! ind.assertInd("top 6", 2, 2, 0)) return false;
+  ind = findPiece(2, 8); if (! ind.assertInd("top 8", 2, 2, 2)) return false;
+  ind = findPiece(0, 4); if (! ind.assertInd("mid 4", 0, 1, 1)) return false;
+
+  ind = findPiece(0, 3); if (! ind.assertInd("mid left 3", 0, 1, 0)) return false;
+
+  return true;
+}
+
+bool
+CRubikModel::
+solveMidLeftInd5()
+{
+  CRubikPieceInd ind = findPiece(0, 5);
+
+  uint side_num = ind.side_num;
+  uint side_col = ind.side_col;
+  uint side_row = ind.side_row;
+
+  if (side_num == 0 && side_col == 1 && side_row == 2) return true;
+
+  if      (side_num == 1) {
+    if      (side_col == 0) {
+      moveSideDown (0, 0); moveSideLeft(0, 0); moveSideUp  (0, 0); moveSideRight(0, 0);
+      moveSideRight(1, 0); moveSideUp  (1, 0); moveSideLeft(1, 0); moveSideDown (1, 0);
+
+      moveSideDown2(0, 0);
+
+      side_num = 0; side_col = 0; side_row = 1;
+    }
+    else if (side_col == 2) {
+      moveSideDown(4, 2); moveSideRight(4, 0); moveSideUp   (4, 2); moveSideLeft(4, 0);
+      moveSideLeft(1, 0); moveSideUp   (1, 2); moveSideRight(1, 0); moveSideDown(1, 2);
+
+      side_num = 0; side_col = 0; side_row = 1;
+    }
+    else if (side_row == 0) {
+      moveSideDown(0, 0);
+
+      side_num = 0; side_col = 0; side_row = 1;
+    }
+    else if (side_row == 2) { // not possible
+    }
+  }
+  else if (side_num == 3) {
+    if      (side_col == 0) {
+      moveSideUp   (0, 0); moveSideLeft(0, 2); moveSideDown(0, 0); moveSideRight(0, 2);
+      moveSideRight(3, 2); moveSideDown(3, 0); moveSideLeft(3, 2); moveSideUp   (3, 0);
+      moveSideUp2  (0, 0);
+
+      side_num = 0; side_col = 0; side_row = 1;
+    }
+    else if (side_col == 2) {
+      moveSideUp  (4, 2); moveSideRight(4, 2); moveSideDown (4, 2); moveSideLeft(4, 2);
+      moveSideLeft(3, 2); moveSideDown (3, 2); moveSideRight(3, 2); moveSideUp  (3, 2);
+
+      side_num = 0; side_col = 0; side_row = 1;
+    }
+    else if (side_row == 0) { // not possible
+    }
+    else if (side_row == 2) {
+      moveSideUp(0, 0);
+
+      side_num = 0; side_col = 0; side_row = 1;
+    }
+  }
+  else if (side_num == 4) {
+    if      (side_col == 0) { // not possible
+    }
+    else if (side_col == 2) {
+      moveSideUp2(0, 0);
+
+      side_num = 0; side_col = 0; side_row = 1;
+    }
+    else if (side_row == 0) {
+      moveSideLeft(1, 0); moveSideUp   (1, 2); moveSideRight(1, 0); moveSideDown(1, 2);
+      moveSideDown(4, 2); moveSideRight(4, 0); moveSideUp   (4, 2); moveSideLeft(4, 0);
+
+      moveSideUp(0, 0);
+
+      side_num = 0; side_col = 0; side_row = 1;
+    }
+    else if (side_row == 2) {
+      moveSideLeft(3, 2); moveSideDown (3, 2); moveSideRight(3, 2); moveSideUp  (3, 2);
+      moveSideUp  (4, 2); moveSideRight(4, 2); moveSideDown (4, 2); moveSideLeft(4, 2);
+
+      moveSideDown(0, 0);
+
+      side_num = 0; side_col = 0; side_row = 1;
+    }
+  }
+
+  if      (side_num == 0) {
+    if (side_row == 0) {
+    }
+
+    if      (side_col == 0) {
+      moveSideUp   (0, 0); moveSideLeft(0, 2); moveSideDown(0, 0); moveSideRight(0, 2);
+      moveSideRight(3, 2); moveSideDown(3, 0); moveSideLeft(3, 2); moveSideUp   (3, 0);
+    }
+    else if (side_col == 2) { // not possible
+    }
+    else if (side_row == 2) { // done
+    }
+  }
+  else if (side_num == 5) {
+    // move to side_row 2
+    if      (side_col == 0) {
+      rotateSide(5, true);
+    }
+    else if (side_col == 2) {
+      rotateSide(5, false);
+    }
+    else if (side_row == 0) {
+      rotateSide2(5);
+    }
+
+    moveSideRight(3, 2); moveSideDown(3, 0); moveSideLeft(3, 2); moveSideUp   (3, 0);
+    moveSideUp   (0, 0); moveSideLeft(0, 2); moveSideDown(0, 0); moveSideRight(0, 2);
+  }
+
+  ind = findPiece(2, 4); if (! ind.assertInd("top 4", 2, 1, 1)) return false;
+  ind = findPiece(2, 1); if (! ind.assertInd("top 1", 2, 0, 1)) return false;
+  ind = findPiece(2, 3); if (! ind.assertInd("top 3", 2, 1, 0)) return false;
+  ind = findPiece(2, 5); if (! ind.assertInd("top 5", 2, 1, 2)) return false;
+  ind = findPiece(2, 7); if (! ind.assertInd("top 7", 2, 2, 1)) return false;
+  ind = findPiece(2, 0); if (! ind.assertInd("top 0", 2, 0, 0)) return false;
+  ind = findPiece(2, 2); if (! ind.assertInd("top 2", 2, 0, 2)) return false;
+  ind = findPiece(2, 6); if (! ind.assertInd("top 6", 2, 2, 0)) return false;
+  ind = findPiece(2, 8); if (! ind.assertInd("top 8", 2, 2, 2)) return false;
+  ind = findPiece(0, 4); if (! ind.assertInd("mid 4", 0, 1, 1)) return false;
+
+  ind = findPiece(0, 3); if (! ind.assertInd("mid left 3", 0, 1, 0)) return false;
+  ind = findPiece(0, 5); if (! ind.assertInd("mid left 5", 0, 1, 2)) return false;
+
+  return true;
+}
+
+bool
+CRubikModel::
+solveMidRightInd3()
+{
+  CRubikPieceInd ind = findPiece(4, 3);
+
+  uint side_num = ind.side_num;
+  uint side_col = ind.side_col;
+  uint side_row = ind.side_row;
+
+  if (side_num == 4 && side_col == 1 && side_row == 0) return true;
+
+  if      (side_num == 0) {
+    if      (side_col == 0) {
+      moveSideUp2(0, 0);
+
+      side_num = 4; side_col = 2; side_row = 1;
+    }
+    else if (side_col == 2) { // not possible
+    }
+    else if (side_row == 0) { // not possible
+    }
+    else if (side_row == 2) { // not possible
+    }
+  }
+  else if (side_num == 1) {
+    if      (side_col == 0) { // not possible
+    }
+    else if (side_col == 2) {
+      moveSideDown(4, 2); moveSideRight(4, 0); moveSideUp   (4, 2); moveSideLeft(4, 0);
+      moveSideLeft(1, 0); moveSideUp   (1, 2); moveSideRight(1, 0); moveSideDown(1, 2);
+
+      moveSideUp2(0, 0);
+
+      side_num = 4; side_col = 2; side_row = 1;
+    }
+    else if (side_row == 0) {
+      moveSideUp(0, 0);
+
+      side_num = 4; side_col = 2; side_row = 1;
+    }
+    else if (side_row == 2) { // not possible
+    }
+  }
+  else if (side_num == 3) {
+    if      (side_col == 0) { // not possible
+    }
+    else if (side_col == 2) {
+      moveSideUp  (4, 2); moveSideRight(4, 2); moveSideDown (4, 2); moveSideLeft(4, 2);
+      moveSideLeft(3, 2); moveSideDown (3, 2); moveSideRight(3, 2); moveSideUp  (3, 2);
+
+      moveSideUp2(0, 0);
+
+      side_num = 4; side_col = 2; side_row = 1;
+    }
+    else if (side_row == 0) { // not possible
+    }
+    else if (side_row == 2) {
+      moveSideDown(0, 0);
+
+      side_num = 4; side_col = 2; side_row = 1;
+    }
+  }
+
+  if      (side_num == 4) {
+    if      (side_col == 0) { // not possible
+    }
+    else if (side_row == 0) { // done
+    }
+    else if (side_row == 2) {
+      moveSideLeft(3, 2); moveSideDown (3, 2); moveSideRight(3, 2); moveSideUp  (3, 2);
+      moveSideUp  (4, 2); moveSideRight(4, 2); moveSideDown (4, 2); moveSideLeft(4, 2);
+
+      moveSideUp(0, 0);
+
+      side_num = 4; side_col = 2; side_row = 1;
+    }
+
+    if (side_col == 2) {
+      moveSideDown(4, 2); moveSideRight(4, 0); moveSideUp   (4, 2); moveSideLeft(4, 0);
+      moveSideLeft(1, 0); moveSideUp   (1, 2); moveSideRight(1, 0); moveSideDown(1, 2);
+    }
+  }
+  else if (side_num == 5) {
+    // move to side_row 0
+    if      (side_col == 0) {
+      rotateSide(5, false);
+    }
+    else if (side_col == 2) {
+      rotateSide(5, true);
+    }
+    else if (side_row == 2) {
+      rotateSide2(5);
+    }
+
+    moveSideLeft(1, 0); moveSideUp   (1, 2); moveSideRight(1, 0); moveSideDown(1, 2);
+    moveSideDown(4, 2); moveSideRight(4, 0); moveSideUp   (4, 2); moveSideLeft(4, 0);
+  }
+
+  ind = findPiece(2, 4); if (! ind.assertInd("top 4", 2, 1, 1)) return false;
+  ind = findPiece(2, 1); if (! ind.assertInd("top 1", 2, 0, 1)) return false;
+  ind = findPiece(2, 3); if (! ind.assertInd("top 3", 2, 1, 0)) return false;
+  ind = findPiece(2, 5); if (! ind.assertInd("top 5", 2, 1, 2)) return false;
+  ind = findPiece(2, 7); if (! ind.assertInd("top 7", 2, 2, 1)) return false;
+  ind = findPiece(2, 0); if (! ind.assertInd("top 0", 2, 0, 0)) return false;
+  ind = findPiece(2, 2); if (! ind.assertInd("top 2", 2, 0, 2)) return false;
+  ind = findPiece(2, 6); if (! ind.assertInd("top 6", 2, 2, 0)) return false;
+  ind = findPiece(2, 8); if (! ind.assertInd("top 8", 2, 2, 2)) return false;
+  ind = findPiece(0, 4); if (! ind.assertInd("mid 4", 0, 1, 1)) return false;
+
+  ind = findPiece(0, 3); if (! ind.assertInd("mid left 3", 0, 1, 0)) return false;
+  ind = findPiece(0, 5); if (! ind.assertInd("mid left 5", 0, 1, 2)) return false;
+
+  ind = findPiece(4, 3); if (! ind.assertInd("mid right 3", 4, 1, 0)) return false;
+
+  return true;
+}
+
+bool
+CRubikModel::
+solveMidRightInd5()
+{
+  CRubikPieceInd ind = findPiece(4, 5);
+
+  uint side_num = ind.side_num;
+  uint side_col = ind.side_col;
+  uint side_row = ind.side_row;
+
+  if (side_num == 4 && side_col == 1 && side_row == 2) return true;
+
+  if      (side_num == 0) {
+    if      (side_col == 0) {
+      moveSideUp2(0, 0);
+
+      side_num = 4; side_col = 2; side_row = 1;
+    }
+    else if (side_col == 2) { // not possible
+    }
+    else if (side_row == 0) { // not possible
+    }
+    else if (side_row == 2) { // not possible
+    }
+  }
+  else if (side_num == 1) {
+    if      (side_col == 0) { // not possible
+    }
+    else if (side_col == 2) { // not possible
+    }
+    else if (side_row == 0) {
+      moveSideUp(0, 0);
+
+      side_num = 4; side_col = 2; side_row = 1;
+    }
+    else if (side_row == 2) { // not possible
+    }
+  }
+  else if (side_num == 3) {
+    if      (side_col == 0) { // not possible
+    }
+    else if (side_col == 2) {
+      moveSideUp  (4, 2); moveSideRight(4, 2); moveSideDown (4, 2); moveSideLeft(4, 2);
+      moveSideLeft(3, 2); moveSideDown (3, 2); moveSideRight(3, 2); moveSideUp  (3, 2);
+
+      moveSideUp2(0, 0);
+
+      side_num = 4; side_col = 2; side_row = 1;
+    }
+    else if (side_row == 0) { // not possible
+    }
+    else if (side_row == 2) {
+      moveSideDown(0, 0);
+
+      side_num = 4; side_col = 2; side_row = 1;
+    }
+  }
+
+  if      (side_num == 4) {
+    if      (side_col == 0) { // not possible
+    }
+    else if (side_row == 0) { // not possible
+    }
+    else if (side_row == 2) { // done
+    }
+
+    if (side_col == 2) {
+      moveSideUp  (4, 2); moveSideRight(4, 2); moveSideDown (4, 2); moveSideLeft(4, 2);
+      moveSideLeft(3, 2); moveSideDown (3, 2); moveSideRight(3, 2); moveSideUp  (3, 2);
+    }
+  }
+  else if (side_num == 5) {
+    // move to side_row 2
+    if      (side_col == 0) {
+      rotateSide(5, true);
+    }
+    else if (side_col == 2) {
+      rotateSide(5, false);
+    }
+    else if (side_row == 0) {
+      rotateSide2(5);
+    }
+
+    moveSideLeft(3, 2); moveSideDown (3, 2); moveSideRight(3, 2); moveSideUp  (3, 2);
+    moveSideUp  (4, 2); moveSideRight(4, 2); moveSideDown (4, 2); moveSideLeft(4, 2);
+  }
+
+  ind = findPiece(2, 4); if (! ind.assertInd("top 4", 2, 1, 1)) return false;
+  ind = findPiece(2, 1); if (! ind.assertInd("top 1", 2, 0, 1)) return false;
+  ind = findPiece(2, 3); if (! ind.assertInd("top 3", 2, 1, 0)) return false;
+  ind = findPiece(2, 5); if (! ind.assertInd("top 5", 2, 1, 2)) return false;
+  ind = findPiece(2, 7); if (! ind.assertInd("top 7", 2, 2, 1)) return false;
+  ind = findPiece(2, 0); if (! ind.assertInd("top 0", 2, 0, 0)) return false;
+  ind = findPiece(2, 2); if (! ind.assertInd("top 2", 2, 0, 2)) return false;
+  ind = findPiece(2, 6); if (! ind.assertInd("top 6", 2, 2, 0)) return false;
+  ind = findPiece(2, 8); if (! ind.assertInd("top 8", 2, 2, 2)) return false;
+  ind = findPiece(0, 4); if (! ind.assertInd("mid 4", 0, 1, 1)) return false;
+
+  ind = findPiece(0, 3); if (! ind.assertInd("mid left 3", 0, 1, 0)) return false;
+  ind = findPiece(0, 5); if (! ind.assertInd("mid left 5", 0, 1, 2)) return false;
+
+  ind = findPiece(4, 3); if (! ind.assertInd("mid right 3", 4, 1, 0)) return false;
+  ind = findPiece(4, 5); if (! ind.assertInd("mid right 5", 4, 1, 2)) return false;
+
+  return true;
+}
+
+bool
+CRubikModel::
+solveBottomCross()
+{
+  CRubikSide &side = sides_[2];
+
+  CRubikPiece &piece1 = side.pieces[0][1];
+  CRubikPiece &piece3 = side.pieces[1][0];
+  CRubikPiece &piece5 = side.pieces[1][2];
+  CRubikPiece &piece7 = side.pieces[2][1];
+
+  if (piece1.side == 5 && piece3.side == 5 &&
+      piece5.side == 5 && piece7.side == 5) {
+    return true;
+  }
+
+  if      ((piece1.side != 5 && piece7.side != 5 &&
+            piece3.side == 5 && piece5.side == 5) ||
+           (piece1.side == 5 && piece7.side == 5 &&
+            piece3.side != 5 && piece5.side != 5)) {
+    if (piece1.side != 5)
+      rotateSide(2, false);
+
+    rotateSide(3, false); rotateSide(4, false); rotateSide(2, false);
+    rotateSide(4, true ); rotateSide(2, true ); rotateSide(3, true );
+  }
+  else if (piece1.side != 5 && piece3.side != 5 &&
+           piece5.side != 5 && piece7.side != 5) {
+    rotateSide(3, false); rotateSide(4, false); rotateSide(2, false);
+    rotateSide(4, true ); rotateSide(2, true ); rotateSide(3, true );
+
+    CRubikPiece &piece1 = side.pieces[0][1];
+    CRubikPiece &piece3 = side.pieces[1][0];
+    CRubikPiece &piece5 = side.pieces[1][2];
+    CRubikPiece &piece7 = side.pieces[2][1];
+
+    if      ((piece1.side != 5 && piece7.side != 5 &&
+             piece3.side == 5 && piece5.side == 5) ||
+            (piece1.side == 5 && piece7.side == 5 &&
+             piece3.side != 5 && piece5.side != 5)) {
+      // State 3
+
+      if (piece1.side != 5)
+        rotateSide(2, false);
+
+      rotateSide(3, false); rotateSide(4, false); rotateSide(2, false);
+      rotateSide(4, true ); rotateSide(2, true ); rotateSide(3, true );
+    }
+    else {
+      // State 2
+      if      (piece1.side != 5 && piece3.side != 5)
+        rotateSide2(2);
+      else if (piece1.side == 5 && piece3.side != 5)
+        rotateSide(2, false);
+      else if (piece1.side != 5 && piece3.side == 5)
+        rotateSide(2, true);
+
+      rotateSide(3, false); rotateSide(2, false); rotateSide(4, false);
+      rotateSide(2, true ); rotateSide(4, true ); rotateSide(3, true );
+    }
+  }
+  else {
+    if      (piece1.side != 5 && piece3.side != 5)
+      rotateSide2(2);
+    else if (piece1.side == 5 && piece3.side != 5)
+      rotateSide(2, false);
+    else if (piece1.side != 5 && piece3.side == 5)
+      rotateSide(2, true);
+
+    rotateSide(3, false); rotateSide(2, false); rotateSide(4, false);
+    rotateSide(2, true ); rotateSide(4, true ); rotateSide(3, true );
+  }
+
+  {
+    CRubikPiece &piece1 = side.pieces[0][1];
+    CRubikPiece &piece3 = side.pieces[1][0];
+    CRubikPiece &piece5 = side.pieces[1][2];
+    CRubikPiece &piece7 = side.pieces[2][1];
+
+    if (piece1.side != 5 || piece3.side != 5 || piece5.side != 5 || piece7.side != 5)
+      return false;
+  }
+
+  return true;
+}
+
+bool
+CRubikModel::
+solveBottomCornerOrder()
+{
+  solveBottomCornerOrder1();
+
+  return solveBottomCornerOrder1(true);
+}
+
+bool
+CRubikModel::
+solveBottomCornerOrder1(bool check)
+{
+  CRubikSide &side = sides_[2];
+
+  const CRubikPiece &piece0 = side.pieces[0][0];
+  const CRubikPiece &piece2 = side.pieces[0][2];
+  const CRubikPiece &piece6 = side.pieces[2][0];
+  const CRubikPiece &piece8 = side.pieces[2][2];
+
+  uint corner0, corner2, corner6, corner8;
+
+  if (piece0.side == 5)
+    corner0 = piece0.id;
+  else {
+    const CRubikPiece &piece0 = getPieceLeft(2, 0, 0);
+
+    if (piece0.side == 5)
+      corner0 = piece0.id;
+    else {
+      const CRubikPiece &piece0 = getPieceUp(2, 0, 0);
+
+      corner0 = piece0.id;
+    }
+  }
+
+  if (piece2.side == 5)
+    corner2 = piece2.id;
+  else {
+    const CRubikPiece &piece2 = getPieceLeft(2, 0, 2);
+
+    if (piece2.side == 5)
+      corner2 = piece2.id;
+    else {
+      const CRubikPiece &piece2 = getPieceDown(2, 0, 2);
+
+      corner2 = piece2.id;
+    }
+  }
+
+  if (piece6.side == 5)
+    corner6 = piece6.id;
+  else {
+    const CRubikPiece &piece6 = getPieceRight(2, 2, 0);
+
+    if (piece6.side == 5)
+      corner6 = piece6.id;
+    else {
+      const CRubikPiece &piece6 = getPieceUp(2, 2, 0);
+
+      corner6 = piece6.id;
+    }
+  }
+
+  if (piece8.side == 5)
+    corner8 = piece8.id;
+  else {
+    const CRubikPiece &piece8 = getPieceRight(2, 2, 2);
+
+    if (piece8.side == 5)
+      corner8 = piece8.id;
+    else {
+      const CRubikPiece &piece8 = getPieceDown(2, 2, 2);
+
+      corner8 = piece8.id;
+    }
+  }
+
+  if      (corner2 == 0) {
+    rotateSide(2, false);
+
+    uint t = corner0; corner0 = corner2; corner2 = corner8; corner8 = corner6; corner6 = t;
+  }
+  else if (corner6 == 0) {
+    rotateSide(2, true);
+
+    uint t = corner0; corner0 = corner6; corner6 = corner8; corner8 = corner2; corner2 = t;
+  }
+  else if (corner8 == 0) {
+    rotateSide2(2);
+
+    uint t1 = corner0; corner0 = corner8; corner8 = t1;
+    uint t2 = corner2; corner2 = corner6; corner6 = t2;
+  }
+
+  if (check) {
+    return (corner2 == 2 && corner6 == 6);
+  }
+
+  //-----
+
+  if      (corner2 == 2) {
+    if   (corner6 == 6) { // 0 2 6 8
+      // done
+    }
+    else { // 0 2 8 6
+      // adjacent 6/8
+      rotateSide(0, false); rotateSide(2, true); rotateSide(4, true ); rotateSide (2, false);
+      rotateSide(0, true ); rotateSide(2, true); rotateSide(4, false); rotateSide2(2);
+    }
+  }
+  else if (corner2 == 6) {
+    if   (corner6 == 2) { // 0 6 2 8
+      // swap 2/6
+
+      rotateSide(0, false); rotateSide(2, true); rotateSide(4, true ); rotateSide (2, false);
+      rotateSide(0, true ); rotateSide(2, true); rotateSide(4, false); rotateSide2(2);
+
+      solveBottomCornerOrder1();
+    }
+    else { // 0 6 8 2
+      // swap 0/6
+      rotateSide2(2);
+
+      rotateSide(0, false); rotateSide(2, true); rotateSide(4, true ); rotateSide (2, false);
+      rotateSide(0, true ); rotateSide(2, true); rotateSide(4, false); rotateSide2(2);
+    }
+  }
+  else {
+    if   (corner6 == 2) { // 0 8 2 6
+      rotateSide(2, false);
+
+      // adjacent 0/8
+      rotateSide(0, false); rotateSide(2, true); rotateSide(4, true ); rotateSide (2, false);
+      rotateSide(0, true ); rotateSide(2, true); rotateSide(4, false); rotateSide2(2);
+    }
+    else { // 0 8 6 2
+      rotateSide(2, true);
+
+      // adjacent 2/8
+      rotateSide(0, false); rotateSide(2, true); rotateSide(4, true ); rotateSide (2, false);
+      rotateSide(0, true ); rotateSide(2, true); rotateSide(4, false); rotateSide2(2);
+    }
+  }
+
+  return true;
+}
+
+bool
+CRubikModel::
+solveBottomCornerOrient(bool check)
+{
+  CRubikSide &side = sides_[2];
+
+  const CRubikPiece &piece0 = side.pieces[0][0];
+  const CRubikPiece &piece2 = side.pieces[0][2];
+  const CRubikPiece &piece6 = side.pieces[2][0];
+  const CRubikPiece &piece8 = side.pieces[2][2];
+
+  uint num = 0;
+
+  if (piece0.side == 5) ++num;
+  if (piece2.side == 5) ++num;
+  if (piece6.side == 5) ++num;
+  if (piece8.side == 5) ++num;
+
+  if (check) return (num == 4);
+
+  if (num == 4) return true;
+
+  uint state = 0;
+
+  if      (num == 0) {
+    const CRubikPiece &upiece1 = getPieceUp  (2, 0, 0);
+    const CRubikPiece &upiece2 = getPieceUp  (2, 2, 0);
+    const CRubikPiece &dpiece1 = getPieceDown(2, 0, 2);
+    const CRubikPiece &dpiece2 = getPieceDown(2, 2, 2);
+
+    if ((upiece1.side != 5 && upiece2.side != 5 && dpiece1.side != 5 && dpiece2.side != 5) ||
+       (upiece1.side == upiece2.side && dpiece1.side == dpiece2.side)) {
+      if (upiece1.side != 5)
+        rotateSide(2, false);
+
+      state = 7;
+
+      rotateSide(2, false);
+
+      solveBottomCornerOrient2();
+
+      rotateSide2(2);
+
+      solveBottomCornerOrient2();
+    }
+    else {
+      if      (upiece1.side != 5 && upiece2.side != 5)
+        rotateSide(2, false);
+      else if (upiece1.side == 5 && upiece2.side != 5)
+        rotateSide2(2);
+      else if (upiece1.side == 5 && upiece2.side == 5)
+        rotateSide(2, true);
+
+      state = 6;
+
+      solveBottomCornerOrient2();
+
+      rotateSide(2, false);
+
+      solveBottomCornerOrient2();
+    }
+  }
+  else if (num == 1) {
+    if (piece2.side == 5) rotateSide (2, false);
+    if (piece6.side == 5) rotateSide (2, true);
+    if (piece8.side == 5) rotateSide2(2);
+
+    const CRubikPiece &upiece = getPieceUp(2, 2, 0);
+
+    if (upiece.side == 5) {
+      // State 1
+      state = 1;
+
+      solveBottomCornerOrient1();
+    }
+    else {
+      rotateSide(2, true);
+
+      // State 2
+      state = 2;
+
+      solveBottomCornerOrient2();
+    }
+  }
+  else if (num == 2) {
+    if (piece0.side != piece8.side && piece2.side != piece6.side) {
+      if      (piece0.side != 5 && piece2.side != 5) rotateSide2(2);
+      else if (piece0.side != 5) rotateSide(2, false);
+      else if (piece2.side != 5) rotateSide(2, true);
+
+      const CRubikPiece &upiece = getPieceUp(2, 2, 0);
+
+      if (upiece.side == 5) {
+        // State 4
+        state = 4;
+
+        rotateSide2(2);
+
+        solveBottomCornerOrient1();
+
+        solveBottomCornerOrient2();
+      }
+      else {
+        // State 3
+        state = 3;
+
+        rotateSide(2, false);
+
+        solveBottomCornerOrient2();
+
+        rotateSide2(2);
+
+        solveBottomCornerOrient1();
+      }
+    }
+    else {
+      state = 5;
+
+      if (piece0.side != 5) rotateSide(2, false);
+
+      const CRubikPiece &upiece = getPieceUp(2, 2, 0);
+
+      if (upiece.side != 5) rotateSide2(2);
+
+      rotateSide(2, false);
+
+      solveBottomCornerOrient1();
+
+      rotateSide(2, false);
+
+      solveBottomCornerOrient2();
+    }
+  }
+
+  if (side.pieces[0][0].id != 0) rotateSide(2, false);
+  if (side.pieces[0][0].id != 0) rotateSide(2, false);
+  if (side.pieces[0][0].id != 0) rotateSide(2, false);
+
+  if (! solveBottomCornerOrient(true)) {
+    std::cerr << "State " << state << "(" << num << ")" << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+bool
+CRubikModel::
+solveBottomMiddles()
+{
+  CRubikSide &side = sides_[2];
+
+  CRubikPiece &piece1 = side.pieces[0][1];
+  CRubikPiece &piece3 = side.pieces[1][0];
+  CRubikPiece &piece5 = side.pieces[1][2];
+  CRubikPiece &piece7 = side.pieces[2][1];
+
+  if (piece1.id == 1 && piece3.id == 3 && piece5.id == 5 && piece7.id == 7)
+    return true;
+
+  solveBottomMiddlesSub();
+
+  return (piece1.id == 1 && piece3.id == 3 && piece5.id == 5 && piece7.id == 7);
+}
+
+void
+CRubikModel::
+solveBottomMiddlesSub()
+{
+  CRubikSide &side = sides_[2];
+
+  CRubikPiece &piece1 = side.pieces[0][1];
+  CRubikPiece &piece3 = side.pieces[1][0];
+  CRubikPiece &piece5 = side.pieces[1][2];
+  CRubikPiece &piece7 = side.pieces[2][1];
+
+  if (piece1.id == 1 && piece3.id == 3 && piece5.id == 5 && piece7.id == 7) return;
+
+  if      (piece1.id == 1) { // L Side Correct
+    if      (piece3.id == 3) {
+      if (piece5.id == 5) {
+      }
+      else { // 7
+      }
+    }
+    else if (piece3.id == 5) {
+      if (piece5.id == 3) {
+      }
+      else { // 7
+        // State 2
+        solveBottomMiddles2();
+      }
+    }
+    else { // 7
+      if (piece5.id == 3) {
+        // State 1
+        solveBottomMiddles1();
+      }
+      else { // 5
+      }
+    }
+  }
+  else if (piece3.id == 3) { // T Side Correct
+    rotateSide(2, true);
+
+    if      (piece3.id == 1) {
+      if (piece5.id == 5) {
+        // State 2
+        solveBottomMiddles2();
+      }
+      else { // 7
+      }
+    }
+    else if (piece3.id == 5) {
+      if (piece5.id == 3) {
+      }
+      else { // 7
+        // State 1
+        solveBottomMiddles1();
+      }
+    }
+    else { // 7
+      if (piece5.id == 1) {
+      }
+      else { // 5
+      }
+    }
+
+    rotateSide(2, false);
+  }
+  else if (piece5.id == 5) { // B Side Correct
+    rotateSide(2, false);
+
+    if      (piece3.id == 1) {
+      if (piece5.id == 3) {
+      }
+      else { // 7
+      }
+    }
+    else if (piece3.id == 3) {
+      if (piece5.id == 1) {
+        // State 1
+        solveBottomMiddles1();
+      }
+      else { // 7
+      }
+    }
+    else { // 7
+      if (piece5.id == 1) {
+      }
+      else { // 3
+        // State 2
+        solveBottomMiddles2();
+      }
+    }
+
+    rotateSide(2, true);
+  }
+  else if (piece7.id == 7) { // R Side Correct
+    rotateSide2(2);
+
+    if      (piece3.id == 1) {
+      if (piece5.id == 3) {
+      }
+      else { // 5
+        // State 1
+        solveBottomMiddles1();
+      }
+    }
+    else if (piece3.id == 3) {
+      if (piece5.id == 1) {
+        // State 1
+        solveBottomMiddles2();
+      }
+      else { // 5
+      }
+    }
+    else { // 5
+      if (piece5.id == 1) {
+      }
+      else { // 3
+      }
+    }
+
+    rotateSide2(2);
+  }
+  else { // No Sides Correct
+    if ((piece1.side == 7 && piece7.side == 1) ||
+        (piece1.side == 3 && piece7.side == 5) ||
+        (piece1.side == 5 && piece7.side == 3)) {
+      solveBottomMiddles1();
+
+      solveBottomMiddlesSub();
+    }
+    else {
+      solveBottomMiddles1();
+
+      solveBottomMiddlesSub();
+    }
+  }
+}
+
+void
+CRubikModel::
+solveBottomMiddles1()
+{
+  execute(CRubikAlgorithms::LBL_MIDDLES1);
+}
+
+void
+CRubikModel::
+solveBottomMiddles2()
+{
+  execute(CRubikAlgorithms::LBL_MIDDLES2);
+}
+
+void
+CRubikModel::
+solveBottomCornerOrient1()
+{
+  execute(CRubikAlgorithms::LBL_CORNER_ORIENT1);
+}
+
+void
+CRubikModel::
+solveBottomCornerOrient2()
+{
+  execute(CRubikAlgorithms::LBL_CORNER_ORIENT2);
+}
+
+CRubikPieceInd
+CRubikModel::
+findPiece(uint side_num, uint id) const
+{
+  uint f = positions_[side_num*SIDE_PIECES + id];
+
+  return CRubikPieceInd(f/SIDE_PIECES, (f % SIDE_PIECES)/SIDE_ROWS, f % SIDE_ROWS);
+}
+
+// rebuild piece positions from sides
+void
+CRubikModel::
+updatePositions()
+{
+  for (uint i = 0, f = 0; i < CUBE_SIDES; ++i) {
+    const CRubikSide &side = sides_[i];
+
+    for (uint k = 0; k < SIDE_COLS; ++k)
+      for (uint j = 0; j < SIDE_ROWS; ++j, ++f)
+        positions_[side.pieces[k][j].side*SIDE_PIECES + side.pieces[k][j].id] = uint8_t(f);
+  }
+}
+
+void
+CRubikModel::
+getFacelets(uint8_t *facelets) const
+{
+  for (uint i = 0, f = 0; i < CUBE_SIDES; ++i) {
+    const CRubikSide &side = sides_[i];
+
+    for (uint k = 0; k < SIDE_COLS; ++k)
+      for (uint j = 0; j < SIDE_ROWS; ++j, ++f)
+        facelets[f] = uint8_t(side.pieces[k][j].side*SIDE_PIECES + side.pieces[k][j].id);
+  }
+}
+
+bool
+CRubikModel::
+setFacelets(const uint8_t *facelets)
+{
+  CRubikCubie cubie;
+
+  if (! cubie.fromFacelets(facelets))
+    return false;
+
+  for (uint i = 0, f = 0; i < CUBE_SIDES; ++i) {
+    CRubikSide &side = sides_[i];
+
+    for (uint k = 0; k < SIDE_COLS; ++k)
+      for (uint j = 0; j < SIDE_ROWS; ++j, ++f)
+        side.pieces[k][j] = CRubikPiece(facelets[f]/SIDE_PIECES, facelets[f] % SIDE_PIECES);
+  }
+
+  updatePositions();
+
+  cubie_ = cubie;
+
+  initValidity();
+
+  return true;
+}
+
+bool
+CRubikModel::
+getCubie(CRubikCubie &cubie) const
+{
+  // cubie state is updated by each move and edit (invalid if a sticker edit left
+  // colors which do not make a cubie)
+  if (! cubieValid_)
+    return false;
+
+  cubie = cubie_;
+
+  return true;
+}
+
+bool
+CRubikModel::
+setCubie(const CRubikCubie &cubie)
+{
+  uint8_t facelets[CRubikCubie::NUM_FACELETS];
+
+  cubie.toFacelets(facelets);
+
+  return setFacelets(facelets);
+}
+
+// facelet index for each position in facelet string order
+static const uint8_t *
+stringFacelets()
+{
+  struct StringFacelets {
+    uint8_t facelets[CRubikCubie::NUM_FACELETS];
+
+    StringFacelets() {
+      // string positions of corners and edges (U/D or F/B facelet first, as CRubikCubie)
+      static const uint8_t cornerPos[CRubikCubie::NUM_CORNERS][3] = {
+        {  8,  9, 20 }, {  6, 18, 38 }, {  0, 36, 47 }, {  2, 45, 11 },
+        { 29, 26, 15 }, { 27, 44, 24 }, { 33, 53, 42 }, { 35, 17, 51 },
+      };
+
+      static const uint8_t edgePos[CRubikCubie::NUM_EDGES][2] = {
+        {  5, 10 }, {  7, 19 }, {  3, 37 }, {  1, 46 }, { 32, 16 }, { 28, 25 },
+        { 30, 43 }, { 34, 52 }, { 23, 12 }, { 21, 41 }, { 50, 39 }, { 48, 14 },
+      };
+
+      // string face order U R F D L B as side numbers
+      static const uint faceSides[] = { 1, 4, 2, 3, 0, 5 };
+
+      for (uint i = 0; i < CRubikCubie::NUM_CORNERS; ++i)
+        for (uint n = 0; n < 3; ++n)
+          facelets[cornerPos[i][n]] = CRubikCubie::cornerFacelets[i][n];
+
+      for (uint i = 0; i < CRubikCubie::NUM_EDGES; ++i)
+        for (uint n = 0; n < 2; ++n)
+          facelets[edgePos[i][n]] = CRubikCubie::edgeFacelets[i][n];
+
+      for (uint i = 0; i < CRubikCubie::NUM_CENTERS; ++i)
+        facelets[i*9 + 4] = uint8_t(faceSides[i]*9 + 4);
+    }
+  };
+
+  static StringFacelets stringFacelets;
+
+  return stringFacelets.facelets;
+}
+
+std::string
+CRubikModel::
+getFaceletString() const
+{
+  const uint8_t *map = stringFacelets();
+
+  uint8_t facelets[CRubikCubie::NUM_FACELETS];
+
+  getFacelets(facelets);
+
+  std::string str(CRubikCubie::NUM_FACELETS, ' ');
+
+  for (uint i = 0; i < CRubikCubie::NUM_FACELETS; ++i)
+    encodeSideChar(facelets[map[i]]/SIDE_PIECES, str[i]);
+
+  return str;
+}
+
+bool
+CRubikModel::
+setFaceletString(const std::string &str)
+{
+  if (str.size() != CRubikCubie::NUM_FACELETS)
+    return false;
+
+  const uint8_t *map = stringFacelets();
+
+  uint8_t colors[CRubikCubie::NUM_FACELETS];
+
+  for (uint i = 0; i < CRubikCubie::NUM_FACELETS; ++i) {
+    uint side;
+
+    if (! decodeSideChar(str[i], side))
+      return false;
+
+    colors[map[i]] = uint8_t(side);
+  }
+
+  CRubikCubie cubie;
+
+  if (! cubie.fromColors(colors))
+    return false;
+
+  return setCubie(cubie);
+}
+
+bool
+CRubikModel::
+getCubieBytes(uint8_t *bytes) const
+{
+  CRubikCubie cubie;
+
+  if (! getCubie(cubie))
+    return false;
+
+  cubie.toBytes(bytes);
+
+  return true;
+}
+
+bool
+CRubikModel::
+setCubieBytes(const uint8_t *bytes)
+{
+  CRubikCubie cubie;
+
+  if (! cubie.fromBytes(bytes))
+    return false;
+
+  return setCubie(cubie);
+}
+
+const CRubikPiece &
+CRubikModel::
+getPieceLeft(uint side_num, uint side_col, uint side_row) const
+{
+  uint side_num1, side_col1, side_row1;
+  int  dir1;
+
+  getPosLeft(side_num, side_col, side_row, 0, side_num1, side_col1, side_row1, dir1);
+
+  return sides_[side_num1].pieces[side_col1][side_row1];
+}
+
+const CRubikPiece &
+CRubikModel::
+getPieceRight(uint side_num, uint side_col, uint side_row) const
+{
+  uint side_num1, side_col1, side_row1;
+  int  dir1;
+
+  getPosRight(side_num, side_col, side_row, 0, side_num1, side_col1, side_row1, dir1);
+
+  return sides_[side_num1].pieces[side_col1][side_row1];
+}
+
+const CRubikPiece &
+CRubikModel::
+getPieceDown(uint side_num, uint side_col, uint side_row) const
+{
+  uint side_num1, side_col1, side_row1;
+  int  dir1;
+
+  getPosDown(side_num, side_col, side_row, 0, side_num1, side_col1, side_row1, dir1);
+
+  return sides_[side_num1].pieces[side_col1][side_row1];
+}
+
+const CRubikPiece &
+CRubikModel::
+getPieceUp(uint side_num, uint side_col, uint side_row) const
+{
+  uint side_num1, side_col1, side_row1;
+  int  dir1;
+
+  getPosUp(side_num, side_col, side_row, 0, side_num1, side_col1, side_row1, dir1);
+
+  return sides_[side_num1].pieces[side_col1][side_row1];
+}
+
+void
+CRubikModel::
+getPosLeft(uint side_num, uint side_col, uint side_row, int dir,
+           uint &side_num1, uint &side_col1, uint &side_row1, int &dir1) const
+{
+  side_num1 = side_num;
+  side_col1 = side_col;
+  side_row1 = side_row;
+  dir1      = dir;
+
+  const CRubikSideData &side = getSideData(side_num1);
+
+  if (side_col1 > 0)
+    --side_col1;
+  else {
+    side_num1 = side.side_l.side;
+
+    dir1 += side.side_l.rotate;
+
+    if (dir1 <= -180) dir1 += 360; else if (dir1 > 180) dir1 -= 360;
+
+    if      (dir1 ==   0)   side_col1 = 2;
+    else if (dir1 == 180) { side_col1 = 0; side_row1 = 2 - side_row1; }
+    else if (dir1 ==  90) { side_col1 = side_row1    ; side_row1 = 0; }
+    else if (dir1 == -90) { side_col1 = 2 - side_row1; side_row1 = 2; }
+  }
+
+  dir1 = 0;
+}
+
+void
+CRubikModel::
+getPosRight(uint side_num, uint side_col, uint side_row, int dir,
+            uint &side_num1, uint &side_col1, uint &side_row1, int &dir1) const
+{
+  side_num1 = side_num;
+  side_col1 = side_col;
+  side_row1 = side_row;
+  dir1      = dir;
+
+  const CRubikSideData &side = getSideData(side_num1);
+
+  if (side_col1 < 2)
+    ++side_col1;
+  else {
+    side_num1 = side.side_r.side;
+
+    dir1 += side.side_r.rotate;
+
+    if (dir1 <= -180) dir1 += 360; else if (dir1 > 180) dir1 -= 360;
+
+    if      (dir1 ==   0)   side_col1 = 0;
+    else if (dir1 == 180) { side_col1 = 2; side_row1 = 2 - side_row1; }
+    else if (dir1 ==  90) { side_col1 = side_row1    ; side_row1 = 2; }
+    else if (dir1 == -90) { side_col1 = 2 - side_row1; side_row1 = 0; }
+  }
+
+  dir1 = 0;
+}
+
+void
+CRubikModel::
+getPosDown(uint side_num, uint side_col, uint side_row, int dir,
+           uint &side_num1, uint &side_col1, uint &side_row1, int &dir1) const
+{
+  side_num1 = side_num;
+  side_col1 = side_col;
+  side_row1 = side_row;
+  dir1      = dir;
+
+  const CRubikSideData &side = getSideData(side_num1);
+
+  if      (dir1 == 0) {
+    if (side_row1 < 2)
+      ++side_row1;
+    else {
+      side_num1 = side.side_d.side;
+
+      dir1 += side.side_d.rotate;
+
+      if (dir1 <= -180) dir1 += 360; else if (dir1 > 180) dir1 -= 360;
+
+      if      (dir1 ==   0)   side_row1 = 0;
+      else if (dir1 == 180) { side_row1 = 2; side_col1 = 2 - side_col1; }
+      else if (dir1 ==  90) { side_row1 = 2 - side_col1; side_col1 = 0; }
+      else if (dir1 == -90) { side_row1 = side_col1    ; side_col1 = 2; }
+    }
+  }
+  else if (dir1 == 180) {
+    if (side_row1 > 0)
+      --side_row1;
+    else {
+      side_num1 = side.side_u.side;
+
+      dir1 += side.side_u.rotate;
+
+      if (dir1 <= -180) dir1 += 360; else if (dir1 > 180) dir1 -= 360;
+
+      if      (dir1 ==   0) { side_row1 = 0; side_col1 = 2 - side_col1; }
+      else if (dir1 == 180)   side_row1 = 2;
+      else if (dir1 ==  90) { side_row1 =     side_col1; side_col1 = 0; }
+      else if (dir1 == -90) { side_row1 = 2 - side_col1; side_col1 = 2; }
+    }
+  }
+  else if (dir1 == 90) {
+    if (side_col1 < 2)
+      ++side_col1;
+    else {
+      side_num1 = side.side_r.side;
+
+      dir1 += side.side_r.rotate;
+
+      if (dir1 <= -180) dir1 += 360; else if (dir1 > 180) dir1 -= 360;
+
+      if      (dir1 ==  90)   side_col1 = 0;
+      else if (dir1 == -90)   side_col1 = 2;
+      else if (dir1 ==   0) { side_col1 = 2 - side_row1; side_row1 = 0; }
+      else if (dir1 == 180) { side_col1 =     side_row1; side_row1 = 2; }
+    }
+  }
+  else if (dir1 == -90) {
+    if (side_col1 > 0)
+      --side_col1;
+    else {
+      side_num1 = side.side_l.side;
+
+      dir1 += side.side_l.rotate;
+
+      if (dir1 <= -180) dir1 += 360; else if (dir1 > 180) dir1 -= 360;
+
+      if      (dir1 ==  90)   side_col1 = 0;
+      else if (dir1 == -90)   side_col1 = 2;
+      else if (dir1 ==   0) { side_col1 =     side_row1; side_row1 = 0; }
+      else if (dir1 == 180) { side_col1 = 2 - side_row1; side_row1 = 2; }
+    }
+  }
+}
+
+void
+CRubikModel::
+getPosUp(uint side_num, uint side_col, uint side_row, int dir,
+         uint &side_num1, uint &side_col1, uint &side_row1, int &dir1) const
+{
+  side_num1 = side_num;
+  side_col1 = side_col;
+  side_row1 = side_row;
+  dir1      = dir;
+
+  const CRubikSideData &side = getSideData(side_num1);
+
+  if      (dir1 == 0) {
+    if (side_row1 > 0)
+      --side_row1;
+    else {
+      side_num1 = side.side_u.side;
+
+      dir1 += side.side_u.rotate;
+
+      if  (dir1 <= -180) dir1 += 360; else if (dir1 > 180) dir1 -= 360;
+
+      if      (dir1 ==   0)   side_row1 = 2;
+      else if (dir1 == 180) { side_row1 = 0; side_col1 = 2 - side_col1; }
+      else if (dir1 ==  90) { side_row1 = 2 - side_col1; side_col1 = 2; }
+      else if (dir1 == -90) { side_row1 =     side_col1; side_col1 = 0; }
+    }
+  }
+  else if (dir1 == 180) {
+    if (side_row1 < 2)
+      ++side_row1;
+    else {
+      side_num1 = side.side_d.side;
+
+      dir1 += side.side_d.rotate;
+
+      if (dir1 <= -180) dir1 += 360; else if (dir1 > 180) dir1 -= 360;
+
+      if      (dir1 ==   0) { side_row1 = 2; side_col1 = 2 - side_col1; }
+      else if (dir1 == 180)   side_row1 = 0;
+      else if (dir1 ==  90) { side_row1 =     side_col1; side_col1 = 2; }
+      else if (dir1 == -90) { side_row1 = 2 - side_col1; side_col1 = 0; }
+    }
+  }
+  else if (dir1 == 90) {
+    if (side_col1 > 0)
+      --side_col1;
+    else {
+      side_num1 = side.side_l.side;
+
+      dir1 += side.side_l.rotate;
+
+      if (dir1 <= -180) dir1 += 360; else if (dir1 > 180) dir1 -= 360;
+
+      if      (dir1 ==  90)   side_col1 = 2;
+      else if (dir1 == -90)   side_col1 = 0;
+      else if (dir1 ==   0) { side_col1 = 2 - side_row1; side_row1 = 2; }
+      else if (dir1 == 180) { side_col1 =     side_row1; side_row1 = 0; }
+    }
+  }
+  else if (dir1 == -90) {
+    if (side_col1 < 2)
+      ++side_col1;
+    else {
+      side_num1 = side.side_r.side;
+
+      dir1 += side.side_r.rotate;
+
+      if (dir1 <= -180) dir1 += 360; else if (dir1 > 180) dir1 -= 360;
+
+      if      (dir1 ==  90)   side_col1 = 2;
+      else if (dir1 == -90)   side_col1 = 0;
+      else if (dir1 ==   0) { side_col1 =     side_row1; side_row1 = 2; }
+      else if (dir1 == 180) { side_col1 = 2 - side_row1; side_row1 = 0; }
+    }
+  }
+}
+
+bool
+CRubikModel::
+execute(const std::string &moveStr)
+{
+  // syntax : see CRubikProgram
+  CRubikProgram program;
+
+  if (! program.compile(moveStr))
+    return false;
+
+  execute(program);
+
+  return true;
+}
+
+void
+CRubikModel::
+execute(const CRubikProgram &program)
+{
+  // listener needs each move and unknown cubies are moved one move at a time
+  if (listener_ || unknownCorners_ || unknownEdges_) {
+    for (uint i = 0; i < program.size(); ++i)
+      applyMove(program.move(i));
+
+    return;
+  }
+
+  // otherwise apply the net effect in one go
+  program.apply(reinterpret_cast<CRubikPiece *>(sides_));
+
+  updatePositions();
+
+  program.apply(cubie_);
+
+  if (moves_)
+    moves_->insert(moves_->end(), program.code().begin(), program.code().end());
+}
+
+bool
+CRubikModel::
+execute(CRubikAlgorithms::LBL id)
+{
+  const CRubikAlgorithms::Algorithm *algorithm = CRubikAlgorithms::instance().lookup("LBL", id);
+
+  if (! algorithm)
+    return false;
+
+  execute(algorithm->program);
+
+  return true;
+}
+
+bool
+CRubikModel::
+decodeSideChar(char c, uint &n)
+{
+  static std::string sides = "LUFDRB";
+
+  std::string::size_type iside = sides.find(c);
+
+  if (iside == std::string::npos) return false;
+
+  n = iside;
+
+  return true;
+}
+
+bool
+CRubikModel::
+encodeSideChar(uint n, char &c)
+{
+  static std::string sides = "LUFDRB";
+
+  if (n >= 6) return false;
+
+  c = sides[n];
+
+  return true;
+}
+
+void
+CRubikModel::
+moveSideLeft2(uint side_num, uint side_row)
+{
+  moveSideLeft(side_num, side_row);
+  moveSideLeft(side_num, side_row);
+}
+
+void
+CRubikModel::
+moveSideRight2(uint side_num, uint side_row)
+{
+  moveSideRight(side_num, side_row);
+  moveSideRight(side_num, side_row);
+}
+
+void
+CRubikModel::
+moveSideDown2(uint side_num, uint side_row)
+{
+  moveSideDown(side_num, side_row);
+  moveSideDown(side_num, side_row);
+}
+
+void
+CRubikModel::
+moveSideUp2(uint side_num, uint side_row)
+{
+  moveSideUp(side_num, side_row);
+  moveSideUp(side_num, side_row);
+}
+
+void
+CRubikModel::
+moveSideLeft(uint side_num, uint side_row)
+{
+  int side_num1 = side_num;
+
+  const CRubikSideData &side1 = getSideData(side_num1);
+
+  if      (side_row == 0) {
+    int tside_num = side1.side_u.side;
+
+    rotateSide(tside_num, false);
+  }
+  else if (side_row == 1) {
+    applyMove(CRubikMove::sliceMove(side_num, 'L'));
+  }
+  else if (side_row == 2) {
+    int bside_num = side1.side_d.side;
+
+    rotateSide(bside_num, true);
+  }
+}
+
+void
+CRubikModel::
+moveSideRight(uint side_num, uint side_row)
+{
+  int side_num1 = side_num;
+
+  const CRubikSideData &side1 = getSideData(side_num1);
+
+  if      (side_row == 0) {
+    int tside_num = side1.side_u.side;
+
+    rotateSide(tside_num, true);
+  }
+  else if (side_row == 1) {
+    applyMove(CRubikMove::sliceMove(side_num, 'R'));
+  }
+  else if (side_row == 2) {
+    int bside_num = side1.side_d.side;
+
+    rotateSide(bside_num, false);
+  }
+}
+
+void
+CRubikModel::
+moveSideDown(uint side_num, uint side_col)
+{
+  int side_num1 = side_num;
+
+  const CRubikSideData &side1 = getSideData(side_num1);
+
+  if      (side_col == 0) {
+    uint lside_num = side1.side_l.side;
+
+    rotateSide(lside_num, false);
+  }
+  else if (side_col == 1) {
+    applyMove(CRubikMove::sliceMove(side_num, 'D'));
+  }
+  else if (side_col == 2) {
+    uint rside_num = side1.side_r.side;
+
+    rotateSide(rside_num, true);
+  }
+}
+
+void
+CRubikModel::
+moveSideUp(uint side_num, uint side_col)
+{
+  int side_num1 = side_num;
+
+  const CRubikSideData &side1 = getSideData(side_num1);
+
+  if      (side_col == 0) {
+    uint lside_num = side1.side_l.side;
+
+    rotateSide(lside_num, true);
+  }
+  else if (side_col == 1) {
+    applyMove(CRubikMove::sliceMove(side_num, 'U'));
+  }
+  else if (side_col == 2) {
+    uint rside_num = side1.side_r.side;
+
+    rotateSide(rside_num, false);
+  }
+}
+
+void
+CRubikModel::
+rotateSide2(uint side_num)
+{
+  rotateSide(side_num, true);
+  rotateSide(side_num, true);
+}
+
+void
+CRubikModel::
+rotateSide(uint side_num, bool clockwise)
+{
+  applyMove(CRubikMove::faceMove(side_num, clockwise));
+}
+
+void
+CRubikModel::
+moveSidesLeft()
+{
+  // whole cube rotation (all rows of front)
+  applyMove(CRubikMove::move(CRubikMove::BASE_Y, CRubikMove::TURN_CW));
+}
+
+void
+CRubikModel::
+moveSidesRight()
+{
+  // whole cube rotation (all rows of front)
+  applyMove(CRubikMove::move(CRubikMove::BASE_Y, CRubikMove::TURN_CCW));
+}
+
+void
+CRubikModel::
+moveSidesDown()
+{
+  // whole cube rotation (all rows of front)
+  applyMove(CRubikMove::move(CRubikMove::BASE_X, CRubikMove::TURN_CCW));
+}
+
+void
+CRubikModel::
+moveSidesUp()
+{
+  // whole cube rotation (all rows of front)
+  applyMove(CRubikMove::move(CRubikMove::BASE_X, CRubikMove::TURN_CW));
+}
+
+void
+CRubikModel::
+applyMove(uint move)
+{
+  // sides are packed so the move is a single gather over all the pieces
+  CRubikMove::apply(move, reinterpret_cast<CRubikPiece *>(sides_));
+
+  // piece at position f moves to the position the inverse move takes from f
+  const uint8_t *iperm = CRubikMove::perm(CRubikMove::inverse(move));
+
+  for (uint i = 0; i < CUBE_SIDES*SIDE_PIECES; ++i)
+    positions_[i] = iperm[positions_[i]];
+
+  const CRubikCubie &moveCubie = CRubikMove::cubie(move);
+
+  cubie_.multiply(moveCubie);
+
+  // moves keep all the validity checks unchanged but move the unknown cubies
+  if (unknownCorners_ || unknownEdges_) {
+    uint unknownCorners = 0, unknownEdges = 0;
+
+    for (uint i = 0; i < CRubikCubie::NUM_CORNERS; ++i)
+      if (unknownCorners_ & (1u << moveCubie.cornerPerm(i)))
+        unknownCorners |= 1u << i;
+
+    for (uint i = 0; i < CRubikCubie::NUM_EDGES; ++i)
+      if (unknownEdges_ & (1u << moveCubie.edgePerm(i)))
+        unknownEdges |= 1u << i;
+
+    unknownCorners_ = unknownCorners;
+    unknownEdges_   = unknownEdges;
+
+    updateValidity();
+  }
+
+  if (moves_)
+    moves_->push_back(move);
+
+  if (listener_)
+    listener_->moveApplied(move);
+}
+
+bool
+CRubikModel::
+setPieceColor(uint side_num, uint side_col, uint side_row, uint color)
+{
+  if (side_num >= CUBE_SIDES || side_col >= SIDE_COLS || side_row >= SIDE_ROWS ||
+      color >= CUBE_SIDES)
+    return false;
+
+  CRubikPiece &piece = sides_[side_num].pieces[side_col][side_row];
+
+  if (piece.side == color)
+    return true;
+
+  --colorCounts_[piece.side];
+  ++colorCounts_[color];
+
+  piece.side = uint8_t(color);
+
+  // only the cubie holding the sticker needs to be matched again
+  CRubikPiece *pieces = reinterpret_cast<CRubikPiece *>(sides_);
+
+  uint8_t colors[CRubikCubie::NUM_FACELETS];
+
+  for (uint f = 0; f < CRubikCubie::NUM_FACELETS; ++f)
+    colors[f] = pieces[f].side;
+
+  uint f = side_num*SIDE_PIECES + side_col*SIDE_ROWS + side_row;
+
+  uint i, perm, ori;
+
+  if      (CRubikCubie::faceletCorner(f, i)) {
+    if (CRubikCubie::cornerFromColors(i, colors, perm, ori)) {
+      for (uint n = 0; n < 3; ++n) {
+        uint f1 = CRubikCubie::cornerFacelets[perm][n];
+
+        pieces[CRubikCubie::cornerFacelets[i][(n + ori) % 3]] =
+          CRubikPiece(f1/SIDE_PIECES, f1 % SIDE_PIECES);
+      }
+
+      cubie_.setCorner(i, perm, ori);
+
+      unknownCorners_ &= ~(1u << i);
+    }
+    else
+      unknownCorners_ |= 1u << i;
+  }
+  else if (CRubikCubie::faceletEdge(f, i)) {
+    if (CRubikCubie::edgeFromColors(i, colors, perm, ori)) {
+      uint f1 = CRubikCubie::edgeFacelets[perm][0];
+      uint f2 = CRubikCubie::edgeFacelets[perm][1];
+
+      pieces[CRubikCubie::edgeFacelets[i][ori    ]] = CRubikPiece(f1/SIDE_PIECES, f1 % SIDE_PIECES);
+      pieces[CRubikCubie::edgeFacelets[i][1 - ori]] = CRubikPiece(f2/SIDE_PIECES, f2 % SIDE_PIECES);
+
+      cubie_.setEdge(i, perm, ori);
+
+      unknownEdges_ &= ~(1u << i);
+    }
+    else
+      unknownEdges_ |= 1u << i;
+  }
+  else {
+    piece.id = 4;
+
+    cubie_.centers[side_num] = uint8_t(color);
+  }
+
+  updatePositions();
+
+  updateValidity();
+
+  return true;
+}
+
+void
+CRubikModel::
+initValidity()
+{
+  // sides and cubie state set from a full state (all cubies known)
+  for (uint i = 0; i < CUBE_SIDES; ++i)
+    colorCounts_[i] = SIDE_PIECES;
+
+  unknownCorners_ = 0;
+  unknownEdges_   = 0;
+
+  updateValidity();
+}
+
+void
+CRubikModel::
+updateValidity()
+{
+  validity_ = cubie_.checkValidity(unknownCorners_, unknownEdges_);
+
+  validity_.stickers = true;
+
+  for (uint i = 0; i < CUBE_SIDES; ++i)
+    if (colorCounts_[i] != SIDE_PIECES)
+      validity_.stickers = false;
+
+  cubieValid_ = (unknownCorners_ == 0 && unknownEdges_ == 0);
+}
+
+bool
+CRubikModel::
+validate() const
+{
+  CRubikCubie::Validity validity;
+
+  return validate(validity);
+}
+
+bool
+CRubikModel::
+validate(CRubikCubie::Validity &validity) const
+{
+  // cubie state is kept up to date by applyMove so this is a fixed size check
+  CRubikCubie cubie;
+
+  if (! getCubie(cubie))
+    validity = CRubikCubie::Validity::BAD_FACELETS;
+  else
+    validity = cubie.validity();
+
+  return (validity == CRubikCubie::Validity::VALID);
+}
@@ -0,0 +1,282 @@
+#ifndef CRUBIK_MODEL_H
+#define CRUBIK_MODEL_H
+
+#include <CRubikAlgorithms.h>
+#include <CRubikKociemba.h>
+#include <CRubikOptimal.h>
+#include <CRubikRandom.h>
+
+#include <functional>
+#include <iostream>
+
+struct CRubikSideConnect {
+  uint side;
+  int  rotate;
+
+  CRubikSideConnect(uint side1=0, int rotate1=0) :
+   side(side1), rotate(rotate1) {
+  }
+};
+
+struct CRubikPieceInd {
+  uint side_num;
+  uint side_col;
+  uint side_row;
+
+  CRubikPieceInd(uint side_num1=0, uint side_col1=0, uint side_row1=0) :
+   side_num(side_num1), side_col(side_col1), side_row(side_row1) {
+  }
+
+  bool assertInd(const char *msg, uint side_num1, uint side_col1, uint side_row1) {
+    if (side_num != side_num1 || side_col != side_col1 || side_row != side_row1) {
+      std::cerr << msg << "# ";
+
+      print(std::cerr);
+
+      std::cerr << std::endl;
+
+      return false;
+    }
+
+    return true;
+  }
+
+  void print(std::ostream &os=std::cout) {
+    os << side_num << ": " << side_col << ", " << side_row;
+  }
+};
+
+struct CRubikPiece {
+  uint8_t side;
+  uint8_t id;
+
+  CRubikPiece(uint side1=0, uint id1=0) :
+   side(uint8_t(side1)), id(uint8_t(id1)) {
+  }
+};
+
+struct CRubikSide {
+  enum { SIDE_ROWS = 3 };
+  enum { SIDE_COLS = 3 };
+
+  CRubikPiece pieces[SIDE_COLS][SIDE_ROWS];
+
+  CRubikSide() { }
+};
+
+// sides are packed so all 54 pieces can be permuted as one flat array
+static_assert(sizeof(CRubikSide) == CRubikSide::SIDE_COLS*CRubikSide::SIDE_ROWS*sizeof(CRubikPiece),
+              "CRubikSide must be packed");
+
+struct CRubikSideData {
+  const char        *name;
+  CRubikSideConnect  side_l, side_r, side_u, side_d;
+};
+
+// notification of moves applied to the model (e.g. to record undo)
+class CRubikModelListener {
+ public:
+  virtual ~CRubikModelListener() { }
+
+  virtual void moveApplied(uint move) = 0;
+};
+
+// Cube state, moves and layer solver (no GUI dependencies)
+//
+// All moves go through applyMove which reports them to the listener. Internal callers
+// (randomize and solve) detach the listener so they only change the state.
+class CRubikModel {
+ public:
+  enum { CUBE_SIDES   = 6 };
+  enum { SIDE_LENGTH  = 3 };
+  enum { SIDE_PIECES  = 9 };
+  enum { SIDE_ROWS    = 3 };
+  enum { SIDE_COLS    = 3 };
+
+ public:
+  enum class SolveMethod {
+    LAYER,
+    TWO_PHASE,
+    OPTIMAL
+  };
+
+  // solve progress message (called from the solving thread)
+  using ProgressProc = std::function<void (const std::string &msg)>;
+
+ public:
+  CRubikModel();
+
+  SolveMethod getSolveMethod() const { return solveMethod_; }
+  void setSolveMethod(SolveMethod method) { solveMethod_ = method; }
+
+  CRubikKociemba &getKociemba() { return kociemba_; }
+
+  CRubikOptimal &getOptimal() { return optimal_; }
+
+  // maximum solution length searched by the optimal solver
+  uint getOptimalDepth() const { return optimalDepth_; }
+  void setOptimalDepth(uint depth) { optimalDepth_ = depth; }
+
+  void setProgressProc(const ProgressProc &proc) { progressProc_ = proc; }
+
+  CRubikModelListener *listener() const { return listener_; }
+  void setListener(CRubikModelListener *listener) { listener_ = listener; }
+
+  // random state generator used by randomize (seed for reproducible states)
+  CRubikRandom &getRandom() { return random_; }
+
+  void reset();
+
+  // set uniform random state
+  void randomize();
+
+  bool solve();
+
+  // solve and return the moves used
+  bool solve(std::vector<uint> &moves);
+
+  // stop running solve (thread safe), later solves fail until cancel is cleared
+  void cancelSolve();
+
+  void clearCancelSolve();
+
+  // apply moves in notation (see CRubikProgram)
+  bool execute(const std::string &str);
+  void execute(const CRubikProgram &program);
+
+  // apply layer solver algorithm (see CRubikAlgorithms), false if not found
+  bool execute(CRubikAlgorithms::LBL id);
+
+  void moveSideLeft2 (uint side_num, uint side_row);
+  void moveSideRight2(uint side_num, uint side_row);
+  void moveSideDown2 (uint side_num, uint side_col);
+  void moveSideUp2   (uint side_num, uint side_col);
+
+  void moveSideLeft (uint side_num, uint side_row);
+  void moveSideRight(uint side_num, uint side_row);
+  void moveSideDown (uint side_num, uint side_col);
+  void moveSideUp   (uint side_num, uint side_col);
+
+  void rotateSide2(uint side_num);
+
+  // clockwise is counter clockwise looking at the face (i.e. clockwise is R' for R side)
+  void rotateSide(uint side_num, bool clockwise);
+
+  void moveSidesLeft ();
+  void moveSidesRight();
+  void moveSidesDown ();
+  void moveSidesUp   ();
+
+  void applyMove(uint move);
+
+  // current position of piece (original side and id)
+  CRubikPieceInd findPiece(uint side_num, uint id) const;
+
+  const CRubikSide &getSide(uint i) const { return sides_[i]; }
+
+  static const CRubikSideData &getSideData(uint i);
+
+  void getFacelets(uint8_t *facelets) const;
+  bool setFacelets(const uint8_t *facelets);
+
+  bool getCubie(CRubikCubie &cubie) const;
+  bool setCubie(const CRubikCubie &cubie);
+
+  // 54 character facelet string (face letters for each facelet color) with faces in
+  // U R F D L B order, each read in rows from the top left as seen with U (or F for
+  // U and B for D) at the top
+  std::string getFaceletString() const;
+  bool setFaceletString(const std::string &str);
+
+  // CRubikCubie::NUM_BYTES binary encoding
+  bool getCubieBytes(uint8_t *bytes) const;
+  bool setCubieBytes(const uint8_t *bytes);
+
+  const CRubikPiece &getPieceLeft (uint side_num, uint side_col, uint side_row) const;
+  const CRubikPiece &getPieceRight(uint side_num, uint side_col, uint side_row) const;
+  const CRubikPiece &getPieceUp   (uint side_num, uint side_col, uint side_row) const;
+  const CRubikPiece &getPieceDown (uint side_num, uint side_col, uint side_row) const;
+
+  void getPosLeft (uint side_num, uint side_col, uint side_row, int dir,
+                   uint &side_num1, uint &side_col1, uint &side_row1, int &dir1) const;
+  void getPosRight(uint side_num, uint side_col, uint side_row, int dir,
+                   uint &side_num1, uint &side_col1, uint &side_row1, int &dir1) const;
+  void getPosUp   (uint side_num, uint side_col, uint side_row, int dir,
+                   uint &side_num1, uint &side_col1, uint &side_row1, int &dir1) const;
+  void getPosDown (uint side_num, uint side_col, uint side_row, int dir,
+                   uint &side_num1, uint &side_col1, uint &side_row1, int &dir1) const;
+
+  // set sticker color (side number) at a position, the piece ids of the cubie are updated
+  // if the new colors match a cubie
+  bool setPieceColor(uint side_num, uint side_col, uint side_row, uint color);
+
+  // validity flags kept up to date by moves and sticker edits (no check is run)
+  const CRubikValidity &getValidity() const { return validity_; }
+
+  // check cube is reachable from solved (reason in validity when not)
+  bool validate() const;
+  bool validate(CRubikCubie::Validity &validity) const;
+
+  static bool decodeSideChar(char c, uint &n);
+  static bool encodeSideChar(uint n, char &c);
+
+ private:
+  bool solve1();
+
+  bool solveCubie();
+
+  void progress(const std::string &msg) const;
+
+  void updatePositions();
+
+  void initValidity();
+  void updateValidity();
+
+  bool solveTopInd4();
+  bool solveTopInd1();
+  bool solveTopInd3();
+  bool solveTopInd5();
+  bool solveTopInd7();
+  bool solveTopInd0();
+  bool solveTopInd2();
+  bool solveTopInd6();
+  bool solveTopInd8();
+  bool solveMidInd4();
+
+  bool solveMidLeftInd3();
+  bool solveMidLeftInd5();
+
+  bool solveMidRightInd3();
+  bool solveMidRightInd5();
+
+  bool solveBottomCross();
+  bool solveBottomCornerOrder();
+  bool solveBottomCornerOrder1(bool check=false);
+  bool solveBottomCornerOrient(bool check=false);
+  void solveBottomCornerOrient1();
+  void solveBottomCornerOrient2();
+  bool solveBottomMiddles();
+  void solveBottomMiddlesSub();
+  void solveBottomMiddles1();
+  void solveBottomMiddles2();
+
+ private:
+  CRubikSide           sides_[CUBE_SIDES];
+  uint8_t              positions_[CUBE_SIDES*SIDE_PIECES]; // facelet index of each piece
+  CRubikCubie          cubie_;
+  bool                 cubieValid_ { false };
+  CRubikValidity       validity_;
+  uint8_t              colorCounts_[CUBE_SIDES];     // stickers of each color
+  uint                 unknownCorners_ { 0 };        // corner positions not matching a cubie
+  uint                 unknownEdges_   { 0 };        // edge positions not matching a cubie
+  CRubikModelListener* listener_   { nullptr };
+  std::vector<uint>*   moves_      { nullptr };
+  SolveMethod          solveMethod_ { SolveMethod::LAYER };
+  CRubikKociemba       kociemba_;
+  CRubikOptimal        optimal_;
+  CRubikRandom         random_;
+  uint                 optimalDepth_ { CRubikOptimal::MAX_DEPTH };
+  ProgressProc         progressProc_;
+};
+
+#endif
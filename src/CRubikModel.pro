@@ -0,0 +1,46 @@
+TEMPLATE = lib
+
+TARGET = CRubikModel
+
+CONFIG += staticlib
+CONFIG -= qt
+
+QMAKE_CXXFLAGS += -std=c++17
+
+#CONFIG += debug
+
+# Input
+SOURCES += \
+CRubikModel.cpp \
+CRubikAlgorithms.cpp \
+CRubikKociemba.cpp \
+CRubikOptimal.cpp \
+CRubikCubie.cpp \
+CRubikMove.cpp \
+CRubikPerm.cpp \
+CRubikProgram.cpp \
+CRubikShuffle.cpp \
+CRubikRandom.cpp \
+CRubikScramble.cpp \
+CRubikUndoLog.cpp \
+
+HEADERS += \
+CRubikModel.h \
+CRubikAlgorithms.h \
+CRubikKociemba.h \
+CRubikOptimal.h \
+CRubikCubie.h \
+CRubikMove.h \
+CRubikPerm.h \
+CRubikProgram.h \
+CRubikShuffle.h \
+CRubikRandom.h \
+CRubikScramble.h \
+CRubikUndoLog.h \
+
+DESTDIR     = ../lib
+OBJECTS_DIR = ../obj
+
+INCLUDEPATH += \
+../include \
+.
@@ -0,0 +1,534 @@
+#include <CRubikMove.h>
+#include <CRubikProgram.h>
+#include <cstring>
+
+// facelet permutations (generated from the original side walking move code)
+const uint8_t CRubikMove::perms_[NUM_MOVES][NUM_FACELETS] = {
+  { // L
+     2,  5,  8,  1,  4,  7,  0,  3,  6,
+    53, 52, 51, 12, 13, 14, 15, 16, 17,
+     9, 10, 11, 21, 22, 23, 24, 25, 26,
+    18, 19, 20, 30, 31, 32, 33, 34, 35,
+    36, 37, 38, 39, 40, 41, 42, 43, 44,
+    45, 46, 47, 48, 49, 50, 29, 28, 27,
+  },
+  { // L2
+     8,  7,  6,  5,  4,  3,  2,  1,  0,
+    27, 28, 29, 12, 13, 14, 15, 16, 17,
+    53, 52, 51, 21, 22, 23, 24, 25, 26,
+     9, 10, 11, 30, 31, 32, 33, 34, 35,
+    36, 37, 38, 39, 40, 41, 42, 43, 44,
+    45, 46, 47, 48, 49, 50, 20, 19, 18,
+  },
+  { // L'
+     6,  3,  0,  7,  4,  1,  8,  5,  2,
+    18, 19, 20, 12, 13, 14, 15, 16, 17,
+    27, 28, 29, 21, 22, 23, 24, 25, 26,
+    53, 52, 51, 30, 31, 32, 33, 34, 35,
+    36, 37, 38, 39, 40, 41, 42, 43, 44,
+    45, 46, 47, 48, 49, 50, 11, 10,  9,
+  },
+  { // U
+    18,  1,  2, 21,  4,  5, 24,  7,  8,
+    11, 14, 17, 10, 13, 16,  9, 12, 15,
+    36, 19, 20, 39, 22, 23, 42, 25, 26,
+    27, 28, 29, 30, 31, 32, 33, 34, 35,
+    45, 37, 38, 48, 40, 41, 51, 43, 44,
+     0, 46, 47,  3, 49, 50,  6, 52, 53,
+  },
+  { // U2
+    36,  1,  2, 39,  4,  5, 42,  7,  8,
+    17, 16, 15, 14, 13, 12, 11, 10,  9,
+    45, 19, 20, 48, 22, 23, 51, 25, 26,
+    27, 28, 29, 30, 31, 32, 33, 34, 35,
+     0, 37, 38,  3, 40, 41,  6, 43, 44,
+    18, 46, 47, 21, 49, 50, 24, 52, 53,
+  },
+  { // U'
+    45,  1,  2, 48,  4,  5, 51,  7,  8,
+    15, 12,  9, 16, 13, 10, 17, 14, 11,
+     0, 19, 20,  3, 22, 23,  6, 25, 26,
+    27, 28, 29, 30, 31, 32, 33, 34, 35,
+    18, 37, 38, 21, 40, 41, 24, 43, 44,
+    36, 46, 47, 39, 49, 50, 42, 52, 53,
+  },
+  { // F
+     0,  1,  2,  3,  4,  5, 27, 30, 33,
+     9, 10,  8, 12, 13,  7, 15, 16,  6,
+    20, 23, 26, 19, 22, 25, 18, 21, 24,
+    38, 28, 29, 37, 31, 32, 36, 34, 35,
+    11, 14, 17, 39, 40, 41, 42, 43, 44,
+    45, 46, 47, 48, 49, 50, 51, 52, 53,
+  },
+  { // F2
+     0,  1,  2,  3,  4,  5, 38, 37, 36,
+     9, 10, 33, 12, 13, 30, 15, 16, 27,
+    26, 25, 24, 23, 22, 21, 20, 19, 18,
+    17, 28, 29, 14, 31, 32, 11, 34, 35,
+     8,  7,  6, 39, 40, 41, 42, 43, 44,
+    45, 46, 47, 48, 49, 50, 51, 52, 53,
+  },
+  { // F'
+     0,  1,  2,  3,  4,  5, 17, 14, 11,
+     9, 10, 36, 12, 13, 37, 15, 16, 38,
+    24, 21, 18, 25, 22, 19, 26, 23, 20,
+     6, 28, 29,  7, 31, 32,  8, 34, 35,
+    33, 30, 27, 39, 40, 41, 42, 43, 44,
+    45, 46, 47, 48, 49, 50, 51, 52, 53,
+  },
+  { // D
+     0,  1, 47,  3,  4, 50,  6,  7, 53,
+     9, 10, 11, 12, 13, 14, 15, 16, 17,
+    18, 19,  2, 21, 22,  5, 24, 25,  8,
+    29, 32, 35, 28, 31, 34, 27, 30, 33,
+    36, 37, 20, 39, 40, 23, 42, 43, 26,
+    45, 46, 38, 48, 49, 41, 51, 52, 44,
+  },
+  { // D2
+     0,  1, 38,  3,  4, 41,  6,  7, 44,
+     9, 10, 11, 12, 13, 14, 15, 16, 17,
+    18, 19, 47, 21, 22, 50, 24, 25, 53,
+    35, 34, 33, 32, 31, 30, 29, 28, 27,
+    36, 37,  2, 39, 40,  5, 42, 43,  8,
+    45, 46, 20, 48, 49, 23, 51, 52, 26,
+  },
+  { // D'
+     0,  1, 20,  3,  4, 23,  6,  7, 26,
+     9, 10, 11, 12, 13, 14, 15, 16, 17,
+    18, 19, 38, 21, 22, 41, 24, 25, 44,
+    33, 30, 27, 34, 31, 28, 35, 32, 29,
+    36, 37, 47, 39, 40, 50, 42, 43, 53,
+    45, 46,  2, 48, 49,  5, 51, 52,  8,
+  },
+  { // R
+     0,  1,  2,  3,  4,  5,  6,  7,  8,
+     9, 10, 11, 12, 13, 14, 24, 25, 26,
+    18, 19, 20, 21, 22, 23, 33, 34, 35,
+    27, 28, 29, 30, 31, 32, 47, 46, 45,
+    38, 41, 44, 37, 40, 43, 36, 39, 42,
+    17, 16, 15, 48, 49, 50, 51, 52, 53,
+  },
+  { // R2
+     0,  1,  2,  3,  4,  5,  6,  7,  8,
+     9, 10, 11, 12, 13, 14, 33, 34, 35,
+    18, 19, 20, 21, 22, 23, 47, 46, 45,
+    27, 28, 29, 30, 31, 32, 15, 16, 17,
+    44, 43, 42, 41, 40, 39, 38, 37, 36,
+    26, 25, 24, 48, 49, 50, 51, 52, 53,
+  },
+  { // R'
+     0,  1,  2,  3,  4,  5,  6,  7,  8,
+     9, 10, 11, 12, 13, 14, 47, 46, 45,
+    18, 19, 20, 21, 22, 23, 15, 16, 17,
+    27, 28, 29, 30, 31, 32, 24, 25, 26,
+    42, 39, 36, 43, 40, 37, 44, 41, 38,
+    35, 34, 33, 48, 49, 50, 51, 52, 53,
+  },
+  { // B
+    15, 12,  9,  3,  4,  5,  6,  7,  8,
+    42, 10, 11, 43, 13, 14, 44, 16, 17,
+    18, 19, 20, 21, 22, 23, 24, 25, 26,
+    27, 28,  0, 30, 31,  1, 33, 34,  2,
+    36, 37, 38, 39, 40, 41, 35, 32, 29,
+    47, 50, 53, 46, 49, 52, 45, 48, 51,
+  },
+  { // B2
+    44, 43, 42,  3,  4,  5,  6,  7,  8,
+    35, 10, 11, 32, 13, 14, 29, 16, 17,
+    18, 19, 20, 21, 22, 23, 24, 25, 26,
+    27, 28, 15, 30, 31, 12, 33, 34,  9,
+    36, 37, 38, 39, 40, 41,  2,  1,  0,
+    53, 52, 51, 50, 49, 48, 47, 46, 45,
+  },
+  { // B'
+    29, 32, 35,  3,  4,  5,  6,  7,  8,
+     2, 10, 11,  1, 13, 14,  0, 16, 17,
+    18, 19, 20, 21, 22, 23, 24, 25, 26,
+    27, 28, 44, 30, 31, 43, 33, 34, 42,
+    36, 37, 38, 39, 40, 41,  9, 12, 15,
+    51, 48, 45, 52, 49, 46, 53, 50, 47,
+  },
+  { // M
+     0,  1,  2,  3,  4,  5,  6,  7,  8,
+     9, 10, 11, 50, 49, 48, 15, 16, 17,
+    18, 19, 20, 12, 13, 14, 24, 25, 26,
+    27, 28, 29, 21, 22, 23, 33, 34, 35,
+    36, 37, 38, 39, 40, 41, 42, 43, 44,
+    45, 46, 47, 32, 31, 30, 51, 52, 53,
+  },
+  { // M2
+     0,  1,  2,  3,  4,  5,  6,  7,  8,
+     9, 10, 11, 30, 31, 32, 15, 16, 17,
+    18, 19, 20, 50, 49, 48, 24, 25, 26,
+    27, 28, 29, 12, 13, 14, 33, 34, 35,
+    36, 37, 38, 39, 40, 41, 42, 43, 44,
+    45, 46, 47, 23, 22, 21, 51, 52, 53,
+  },
+  { // M'
+     0,  1,  2,  3,  4,  5,  6,  7,  8,
+     9, 10, 11, 21, 22, 23, 15, 16, 17,
+    18, 19, 20, 30, 31, 32, 24, 25, 26,
+    27, 28, 29, 50, 49, 48, 33, 34, 35,
+    36, 37, 38, 39, 40, 41, 42, 43, 44,
+    45, 46, 47, 14, 13, 12, 51, 52, 53,
+  },
+  { // E
+     0, 46,  2,  3, 49,  5,  6, 52,  8,
+     9, 10, 11, 12, 13, 14, 15, 16, 17,
+    18,  1, 20, 21,  4, 23, 24,  7, 26,
+    27, 28, 29, 30, 31, 32, 33, 34, 35,
+    36, 19, 38, 39, 22, 41, 42, 25, 44,
+    45, 37, 47, 48, 40, 50, 51, 43, 53,
+  },
+  { // E2
+     0, 37,  2,  3, 40,  5,  6, 43,  8,
+     9, 10, 11, 12, 13, 14, 15, 16, 17,
+    18, 46, 20, 21, 49, 23, 24, 52, 26,
+    27, 28, 29, 30, 31, 32, 33, 34, 35,
+    36,  1, 38, 39,  4, 41, 42,  7, 44,
+    45, 19, 47, 48, 22, 50, 51, 25, 53,
+  },
+  { // E'
+     0, 19,  2,  3, 22,  5,  6, 25,  8,
+     9, 10, 11, 12, 13, 14, 15, 16, 17,
+    18, 37, 20, 21, 40, 23, 24, 43, 26,
+    27, 28, 29, 30, 31, 32, 33, 34, 35,
+    36, 46, 38, 39, 49, 41, 42, 52, 44,
+    45,  1, 47, 48,  4, 50, 51,  7, 53,
+  },
+  { // S
+     0,  1,  2, 28, 31, 34,  6,  7,  8,
+     9,  5, 11, 12,  4, 14, 15,  3, 17,
+    18, 19, 20, 21, 22, 23, 24, 25, 26,
+    27, 41, 29, 30, 40, 32, 33, 39, 35,
+    36, 37, 38, 10, 13, 16, 42, 43, 44,
+    45, 46, 47, 48, 49, 50, 51, 52, 53,
+  },
+  { // S2
+     0,  1,  2, 41, 40, 39,  6,  7,  8,
+     9, 34, 11, 12, 31, 14, 15, 28, 17,
+    18, 19, 20, 21, 22, 23, 24, 25, 26,
+    27, 16, 29, 30, 13, 32, 33, 10, 35,
+    36, 37, 38,  5,  4,  3, 42, 43, 44,
+    45, 46, 47, 48, 49, 50, 51, 52, 53,
+  },
+  { // S'
+     0,  1,  2, 16, 13, 10,  6,  7,  8,
+     9, 39, 11, 12, 40, 14, 15, 41, 17,
+    18, 19, 20, 21, 22, 23, 24, 25, 26,
+    27,  3, 29, 30,  4, 32, 33,  5, 35,
+    36, 37, 38, 34, 31, 28, 42, 43, 44,
+    45, 46, 47, 48, 49, 50, 51, 52, 53,
+  },
+  { // x
+     6,  3,  0,  7,  4,  1,  8,  5,  2,
+    18, 19, 20, 21, 22, 23, 24, 25, 26,
+    27, 28, 29, 30, 31, 32, 33, 34, 35,
+    53, 52, 51, 50, 49, 48, 47, 46, 45,
+    38, 41, 44, 37, 40, 43, 36, 39, 42,
+    17, 16, 15, 14, 13, 12, 11, 10,  9,
+  },
+  { // x2
+     8,  7,  6,  5,  4,  3,  2,  1,  0,
+    27, 28, 29, 30, 31, 32, 33, 34, 35,
+    53, 52, 51, 50, 49, 48, 47, 46, 45,
+     9, 10, 11, 12, 13, 14, 15, 16, 17,
+    44, 43, 42, 41, 40, 39, 38, 37, 36,
+    26, 25, 24, 23, 22, 21, 20, 19, 18,
+  },
+  { // x'
+     2,  5,  8,  1,  4,  7,  0,  3,  6,
+    53, 52, 51, 50, 49, 48, 47, 46, 45,
+     9, 10, 11, 12, 13, 14, 15, 16, 17,
+    18, 19, 20, 21, 22, 23, 24, 25, 26,
+    42, 39, 36, 43, 40, 37, 44, 41, 38,
+    35, 34, 33, 32, 31, 30, 29, 28, 27,
+  },
+  { // y
+    18, 19, 20, 21, 22, 23, 24, 25, 26,
+    11, 14, 17, 10, 13, 16,  9, 12, 15,
+    36, 37, 38, 39, 40, 41, 42, 43, 44,
+    33, 30, 27, 34, 31, 28, 35, 32, 29,
+    45, 46, 47, 48, 49, 50, 51, 52, 53,
+     0,  1,  2,  3,  4,  5,  6,  7,  8,
+  },
+  { // y2
+    36, 37, 38, 39, 40, 41, 42, 43, 44,
+    17, 16, 15, 14, 13, 12, 11, 10,  9,
+    45, 46, 47, 48, 49, 50, 51, 52, 53,
+    35, 34, 33, 32, 31, 30, 29, 28, 27,
+     0,  1,  2,  3,  4,  5,  6,  7,  8,
+    18, 19, 20, 21, 22, 23, 24, 25, 26,
+  },
+  { // y'
+    45, 46, 47, 48, 49, 50, 51, 52, 53,
+    15, 12,  9, 16, 13, 10, 17, 14, 11,
+     0,  1,  2,  3,  4,  5,  6,  7,  8,
+    29, 32, 35, 28, 31, 34, 27, 30, 33,
+    18, 19, 20, 21, 22, 23, 24, 25, 26,
+    36, 37, 38, 39, 40, 41, 42, 43, 44,
+  },
+  { // z
+    29, 32, 35, 28, 31, 34, 27, 30, 33,
+     2,  5,  8,  1,  4,  7,  0,  3,  6,
+    20, 23, 26, 19, 22, 25, 18, 21, 24,
+    38, 41, 44, 37, 40, 43, 36, 39, 42,
+    11, 14, 17, 10, 13, 16,  9, 12, 15,
+    51, 48, 45, 52, 49, 46, 53, 50, 47,
+  },
+  { // z2
+    44, 43, 42, 41, 40, 39, 38, 37, 36,
+    35, 34, 33, 32, 31, 30, 29, 28, 27,
+    26, 25, 24, 23, 22, 21, 20, 19, 18,
+    17, 16, 15, 14, 13, 12, 11, 10,  9,
+     8,  7,  6,  5,  4,  3,  2,  1,  0,
+    53, 52, 51, 50, 49, 48, 47, 46, 45,
+  },
+  { // z'
+    15, 12,  9, 16, 13, 10, 17, 14, 11,
+    42, 39, 36, 43, 40, 37, 44, 41, 38,
+    24, 21, 18, 25, 22, 19, 26, 23, 20,
+     6,  3,  0,  7,  4,  1,  8,  5,  2,
+    33, 30, 27, 34, 31, 28, 35, 32, 29,
+    47, 50, 53, 46, 49, 52, 45, 48, 51,
+  },
+};
+
+uint
+CRubikMove::
+sliceMove(uint side_num, char dir)
+{
+  enum { M = 3*BASE_M, Mi = M + 2, E = 3*BASE_E, Ei = E + 2, S = 3*BASE_S, Si = S + 2 };
+
+  static const uint8_t sliceMoves[6][4] = {
+    // L   R   U   D
+    { Ei,  E,  S, Si }, // L
+    { Si,  S, Mi,  M }, // U
+    { Ei,  E, Mi,  M }, // F
+    {  S, Si, Mi,  M }, // D
+    { Ei,  E, Si,  S }, // R
+    { Ei,  E,  M, Mi }, // B
+  };
+
+  uint idir = 0;
+
+  if      (dir == 'L') idir = 0;
+  else if (dir == 'R') idir = 1;
+  else if (dir == 'U') idir = 2;
+  else if (dir == 'D') idir = 3;
+
+  return sliceMoves[side_num][idir];
+}
+
+const CRubikCubie &
+CRubikMove::
+cubie(uint move)
+{
+  struct CubieMoves {
+    CRubikCubie cubies[NUM_MOVES];
+
+    CubieMoves() {
+      // facelet permutation applied to the solved state
+      for (uint i = 0; i < NUM_MOVES; ++i)
+        cubies[i].fromFacelets(perms_[i]);
+    }
+  };
+
+  static CubieMoves cubieMoves;
+
+  return cubieMoves.cubies[move];
+}
+
+void
+CRubikMove::
+orientMoves(const CRubikCubie &state, std::vector<uint> &moves)
+{
+  moves.clear();
+
+  CRubikCubie solved;
+
+  if (memcmp(state.centers, solved.centers, sizeof(solved.centers)) == 0)
+    return;
+
+  // any orientation is at most two rotations away
+  uint r1 = move(BASE_X, TURN_CW);
+  uint r2 = move(BASE_Z, TURN_CCW);
+
+  for (uint m1 = r1; m1 <= r2; ++m1) {
+    CRubikCubie state1 = state;
+
+    state1.multiply(cubie(m1));
+
+    if (memcmp(state1.centers, solved.centers, sizeof(solved.centers)) == 0) {
+      moves.push_back(m1);
+      return;
+    }
+  }
+
+  for (uint m1 = r1; m1 <= r2; ++m1) {
+    for (uint m2 = r1; m2 <= r2; ++m2) {
+      CRubikCubie state1 = state;
+
+      state1.multiply(cubie(m1));
+      state1.multiply(cubie(m2));
+
+      if (memcmp(state1.centers, solved.centers, sizeof(solved.centers)) == 0) {
+        moves.push_back(m1);
+        moves.push_back(m2);
+        return;
+      }
+    }
+  }
+}
+
+void
+CRubikMove::
+optimize(std::vector<uint> &moves)
+{
+  enum { NUM_ORIENTS   = 24 };
+  enum { NUM_ROTATIONS = 9  };
+
+  // whole cube orientations (rotations from solved) with the orientation after each
+  // rotation move and each move relabelled to be applied before the orientation
+  struct OrientMoves {
+    CRubikCubie       orients[NUM_ORIENTS];
+    uint              numOrients { 1 };
+    uint8_t           rotate[NUM_ORIENTS][NUM_ROTATIONS];
+    uint8_t           conj  [NUM_ORIENTS][NUM_MOVES];
+    std::vector<uint> rotations[NUM_ORIENTS];
+
+    OrientMoves() {
+      uint r1 = move(BASE_X, TURN_CW);
+
+      for (uint i = 0; i < numOrients; ++i) {
+        for (uint r = 0; r < NUM_ROTATIONS; ++r) {
+          CRubikCubie orient = orients[i];
+
+          orient.multiply(cubie(r1 + r));
+
+          uint j = 0;
+
+          while (j < numOrients && orients[j] != orient)
+            ++j;
+
+          if (j == numOrients)
+            orients[numOrients++] = orient;
+
+          rotate[i][r] = uint8_t(j);
+        }
+      }
+
+      for (uint i = 0; i < numOrients; ++i) {
+        // orient then m == m1 then orient
+        for (uint m = 0; m < NUM_MOVES; ++m) {
+          CRubikCubie lhs = orients[i];
+
+          lhs.multiply(cubie(m));
+
+          for (uint m1 = 0; m1 < NUM_MOVES; ++m1) {
+            CRubikCubie rhs = cubie(m1);
+
+            rhs.multiply(orients[i]);
+
+            if (rhs == lhs) {
+              conj[i][m] = uint8_t(m1);
+              break;
+            }
+          }
+        }
+
+        // rotations giving orientation (inverse of those undoing it)
+        std::vector<uint> undoMoves;
+
+        orientMoves(orients[i], undoMoves);
+
+        for (auto p = undoMoves.rbegin(); p != undoMoves.rend(); ++p)
+          rotations[i].push_back(inverse(*p));
+      }
+    }
+  };
+
+  static OrientMoves orients;
+
+  // axis of each base (L U F D R B M E S)
+  static const uint baseAxis[] = { 0, 1, 2, 1, 0, 2, 0, 1, 2 };
+
+  std::vector<uint> moves1;
+
+  uint orient = 0;
+
+  for (const auto &m : moves) {
+    if (base(m) >= BASE_X) {
+      orient = orients.rotate[orient][m - move(BASE_X, TURN_CW)];
+      continue;
+    }
+
+    uint m1 = orients.conj[orient][m];
+
+    // merge with last move of same base not separated by a move on another axis
+    bool merged = false;
+
+    for (int i = int(moves1.size()) - 1; i >= 0; --i) {
+      uint m2 = moves1[i];
+
+      if (baseAxis[base(m2)] != baseAxis[base(m1)])
+        break;
+
+      if (base(m2) != base(m1))
+        continue;
+
+      // quarter turns (cw 1, half 2, ccw 3)
+      uint turns = (turn(m1) + turn(m2) + 2) % 4;
+
+      if (turns == 0)
+        moves1.erase(moves1.begin() + i);
+      else
+        moves1[i] = move(base(m1), turns - 1);
+
+      merged = true;
+
+      break;
+    }
+
+    if (! merged)
+      moves1.push_back(m1);
+  }
+
+  for (const auto &m : orients.rotations[orient])
+    moves1.push_back(m);
+
+  moves.swap(moves1);
+}
+
+static const char *baseNames = "LUFDRBMESxyz";
+
+std::string
+CRubikMove::
+name(uint move)
+{
+  static const char *turns[] = { "", "2", "'" };
+
+  return std::string(1, baseNames[base(move)]) + turns[turn(move)];
+}
+
+std::string
+CRubikMove::
+names(const std::vector<uint> &moves)
+{
+  std::string str;
+
+  for (const auto &move : moves) {
+    if (! str.empty()) str += " ";
+
+    str += name(move);
+  }
+
+  return str;
+}
+
+bool
+CRubikMove::
+parse(const std::string &str, std::vector<uint> &moves)
+{
+  return CRubikProgram::parse(str, moves);
+}
@@ -0,0 +1,93 @@
+#ifndef CRUBIK_MOVE_H
+#define CRUBIK_MOVE_H
+
+#include <CRubikCubie.h>
+#include <string>
+#include <vector>
+
+// Table driven cube moves.
+//
+// Moves are numbered base*3 + turn where base is one of the six faces (in CQRubik side
+// order L U F D R B), the three slices M (as L), E (as D), S (as F) or the three whole
+// cube rotations x (as R), y (as U), z (as F) and turn is a quarter turn, a half turn or
+// an inverse quarter turn. Directions are standard (Singmaster) notation : a quarter turn
+// is clockwise as seen looking at the face (so R takes the F stickers to U).
+//
+// Each move is a facelet permutation (gather) : new[i] = old[perm[i]] using the same
+// facelet indices as CRubikCubie (side*9 + col*3 + row).
+class CRubikMove {
+ public:
+  enum Base {
+    BASE_L, BASE_U, BASE_F, BASE_D, BASE_R, BASE_B,
+    BASE_M, BASE_E, BASE_S,
+    BASE_X, BASE_Y, BASE_Z,
+    NUM_BASES
+  };
+
+  enum Turn {
+    TURN_CW,
+    TURN_2,
+    TURN_CCW
+  };
+
+  enum { NUM_FACE_MOVES = 18 };
+  enum { NUM_MOVES      = 36 };
+  enum { NUM_FACELETS   = CRubikCubie::NUM_FACELETS };
+
+ public:
+  static uint move(uint base, uint turn) { return base*3 + turn; }
+
+  static uint base(uint move) { return move/3; }
+  static uint turn(uint move) { return move % 3; }
+
+  static uint inverse(uint move) { return move - 2*turn(move) + 2; }
+
+  static bool isFaceMove(uint move) { return move < NUM_FACE_MOVES; }
+
+  // move for CQRubik::rotateSide (whose clockwise turn is counter clockwise as seen
+  // looking at the face)
+  static uint faceMove(uint side_num, bool clockwise) {
+    return move(side_num, clockwise ? TURN_CCW : TURN_CW);
+  }
+
+  // middle slice move for CQRubik::moveSideLeft/Right/Up/Down (dir L, R, U or D)
+  static uint sliceMove(uint side_num, char dir);
+
+  static const uint8_t *perm(uint move) { return perms_[move]; }
+
+  static const CRubikCubie &cubie(uint move);
+
+  static std::string name(uint move);
+
+  // space separated move names (e.g. "R U2 F'") as read by parse and CRubikModel::execute
+  static std::string names(const std::vector<uint> &moves);
+
+  // whole cube rotations which return the cubie centers to their sides
+  static void orientMoves(const CRubikCubie &state, std::vector<uint> &moves);
+
+  // shorten moves (same final state) : move whole cube rotations to the end (relabelling
+  // the moves they pass), merge turns of the same face or slice and cancel inverses
+  // (looking past moves on the same axis which commute)
+  static void optimize(std::vector<uint> &moves);
+
+  // parse move names (e.g. "R U2 F' M x", see CRubikProgram for full syntax) into moves
+  static bool parse(const std::string &str, std::vector<uint> &moves);
+
+  template<typename T>
+  static void apply(uint move, T *facelets) {
+    const uint8_t *p = perms_[move];
+
+    T t[NUM_FACELETS];
+
+    for (uint i = 0; i < NUM_FACELETS; ++i)
+      t[i] = facelets[p[i]];
+
+    for (uint i = 0; i < NUM_FACELETS; ++i)
+      facelets[i] = t[i];
+  }
+
+ private:
+  static const uint8_t perms_[NUM_MOVES][NUM_FACELETS];
+};
+
+#endif
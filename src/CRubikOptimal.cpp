@@ -0,0 +1,750 @@
+#include <CRubikOptimal.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+enum { NUM_CORNER_PERM  = 40320  }; // 8!
+enum { NUM_TWIST        = 2187   }; // 3^7
+enum { NUM_EDGE_PERM    = 665280 }; // 12!/6!
+enum { NUM_EDGE_FLIP    = 64     }; // 2^6
+enum { NUM_GROUP_EDGES  = 6      };
+
+const uint64_t NUM_CORNER_ENTRIES = uint64_t(NUM_CORNER_PERM)*NUM_TWIST;
+const uint64_t NUM_EDGE_ENTRIES   = uint64_t(NUM_EDGE_PERM)*NUM_EDGE_FLIP;
+
+const uint NUM_FACE_MOVES = CRubikMove::NUM_FACE_MOVES;
+
+const uint8_t UNSET = 0xF;
+
+// axis of each face (L U F D R B) for ordering moves on opposite faces
+const uint faceAxis[] = { 0, 1, 2, 1, 0, 2 };
+
+// skip move on same face as last or on opposite face in the wrong order
+inline bool
+skipMove(uint lastMove, uint move)
+{
+  uint face1 = CRubikMove::base(lastMove);
+  uint face2 = CRubikMove::base(move);
+
+  return (face1 == face2 || (faceAxis[face1] == faceAxis[face2] && face2 < face1));
+}
+
+//---
+
+// database file header
+struct Header {
+  char     magic[8];
+  uint32_t version;
+  uint32_t headerSize;
+  uint64_t cornerEntries;
+  uint64_t edgeEntries;
+};
+
+const char     *fileMagic   = "CRUBPDB";
+const uint32_t  fileVersion = 1;
+
+size_t
+dbSize(uint64_t n)
+{
+  return size_t((n + 1)/2);
+}
+
+size_t
+fileSize()
+{
+  return sizeof(Header) + dbSize(NUM_CORNER_ENTRIES) + 2*dbSize(NUM_EDGE_ENTRIES);
+}
+
+// 4 bit entries
+inline uint
+getEntry(const uint8_t *db, uint64_t i)
+{
+  return (db[i >> 1] >> ((i & 1) << 2)) & 0xF;
+}
+
+inline void
+setEntry(uint8_t *db, uint64_t i, uint d)
+{
+  uint8_t &b = db[i >> 1];
+
+  if (i & 1)
+    b = uint8_t((b & 0x0F) | (d << 4));
+  else
+    b = uint8_t((b & 0xF0) | d);
+}
+
+//---
+
+// cubie position moves : new position*3 + twist (corners) and position*2 + flip (edges)
+struct MoveTables {
+  uint8_t cornerMove[CRubikCubie::NUM_CORNERS*3][NUM_FACE_MOVES];
+  uint8_t edgeMove  [CRubikCubie::NUM_EDGES  *2][NUM_FACE_MOVES];
+
+  MoveTables() {
+    for (uint m = 0; m < NUM_FACE_MOVES; ++m) {
+      // cubie at position cornerPerm(i) moves to position i
+      const CRubikCubie &cubie = CRubikMove::cubie(m);
+
+      for (uint i = 0; i < CRubikCubie::NUM_CORNERS; ++i) {
+        uint j = cubie.cornerPerm(i);
+
+        for (uint o = 0; o < 3; ++o)
+          cornerMove[j*3 + o][m] = uint8_t(i*3 + (o + cubie.cornerOri(i)) % 3);
+      }
+
+      for (uint i = 0; i < CRubikCubie::NUM_EDGES; ++i) {
+        uint j = cubie.edgePerm(i);
+
+        for (uint o = 0; o < 2; ++o)
+          edgeMove[j*2 + o][m] = uint8_t(i*2 + (o ^ cubie.edgeOri(i)));
+      }
+    }
+  }
+};
+
+const MoveTables &
+moveTables()
+{
+  static MoveTables tables;
+
+  return tables;
+}
+
+//---
+
+// index of the a'th unused position
+inline uint
+unusedPos(uint used, uint a)
+{
+  for (uint p = 0; ; ++p) {
+    if (used & (1u << p)) continue;
+
+    if (a == 0) return p;
+
+    --a;
+  }
+}
+
+// corner positions (mixed radix rank of the permutation) and twists of cubies 0..6
+inline uint64_t
+cornerIndex(const uint8_t *corners)
+{
+  uint used = 0, perm = 0, twist = 0;
+
+  for (uint i = 0; i < CRubikCubie::NUM_CORNERS; ++i) {
+    uint p = corners[i] / 3;
+
+    perm = perm*(CRubikCubie::NUM_CORNERS - i) + (p - __builtin_popcount(used & ((1u << p) - 1)));
+
+    used |= 1u << p;
+
+    if (i < CRubikCubie::NUM_CORNERS - 1)
+      twist = twist*3 + corners[i] % 3;
+  }
+
+  return uint64_t(perm)*NUM_TWIST + twist;
+}
+
+void
+cornerState(uint64_t idx, uint8_t *corners)
+{
+  uint perm  = uint(idx / NUM_TWIST);
+  uint twist = uint(idx % NUM_TWIST);
+
+  uint a[CRubikCubie::NUM_CORNERS], o[CRubikCubie::NUM_CORNERS];
+
+  uint sum = 0;
+
+  for (int i = CRubikCubie::NUM_CORNERS - 1; i >= 0; --i) {
+    a[i] = perm % (CRubikCubie::NUM_CORNERS - i);
+
+    perm /= CRubikCubie::NUM_CORNERS - i;
+
+    if (i < CRubikCubie::NUM_CORNERS - 1) {
+      o[i] = twist % 3;
+
+      twist /= 3;
+
+      sum += o[i];
+    }
+  }
+
+  o[CRubikCubie::NUM_CORNERS - 1] = (3 - sum % 3) % 3;
+
+  uint used = 0;
+
+  for (uint i = 0; i < CRubikCubie::NUM_CORNERS; ++i) {
+    uint p = unusedPos(used, a[i]);
+
+    used |= 1u << p;
+
+    corners[i] = uint8_t(p*3 + o[i]);
+  }
+}
+
+// positions (partial permutation rank) and flips of six edges
+inline uint64_t
+edgeIndex(const uint8_t *edges)
+{
+  uint used = 0, perm = 0, flip = 0;
+
+  for (uint i = 0; i < NUM_GROUP_EDGES; ++i) {
+    uint p = edges[i] >> 1;
+
+    perm = perm*(CRubikCubie::NUM_EDGES - i) + (p - __builtin_popcount(used & ((1u << p) - 1)));
+
+    used |= 1u << p;
+
+    flip = 2*flip + (edges[i] & 1);
+  }
+
+  return uint64_t(perm)*NUM_EDGE_FLIP + flip;
+}
+
+void
+edgeState(uint64_t idx, uint8_t *edges)
+{
+  uint perm = uint(idx / NUM_EDGE_FLIP);
+  uint flip = uint(idx % NUM_EDGE_FLIP);
+
+  uint a[NUM_GROUP_EDGES];
+
+  for (int i = NUM_GROUP_EDGES - 1; i >= 0; --i) {
+    a[i] = perm % (CRubikCubie::NUM_EDGES - i);
+
+    perm /= CRubikCubie::NUM_EDGES - i;
+  }
+
+  uint used = 0;
+
+  for (uint i = 0; i < NUM_GROUP_EDGES; ++i) {
+    uint p = unusedPos(used, a[i]);
+
+    used |= 1u << p;
+
+    uint f = (flip >> (NUM_GROUP_EDGES - 1 - i)) & 1;
+
+    edges[i] = uint8_t(p*2 + f);
+  }
+}
+
+// Breadth first search from the solved state (n cubies, each moved by moveTable).
+// Each level scans the table for the previous level (forward) or, when fewer entries
+// are left than in the last level, for unset entries next to the last level (backward).
+// Returns false if cancelled (checked every 2^20 entries).
+template<uint N, typename INDEX, typename STATE>
+bool
+buildDb(uint8_t *db, uint64_t n, const uint8_t (*moveTable)[NUM_FACE_MOVES],
+        const uint8_t *solved, INDEX index, STATE state, const std::atomic<bool> &cancelled)
+{
+  memset(db, 0xFF, dbSize(n));
+
+  setEntry(db, index(solved), 0);
+
+  uint64_t numSet = 1, numLast = 1;
+
+  uint8_t s[N], s1[N];
+
+  for (uint d = 0; numSet < n && d < UNSET - 1; ++d) {
+    uint64_t numNew = 0;
+
+    bool forward = (numLast < n - numSet);
+
+    for (uint64_t i = 0; i < n; ++i) {
+      if ((i & 0xFFFFF) == 0 && cancelled)
+        return false;
+
+      uint e = getEntry(db, i);
+
+      if (forward) {
+        if (e != d) continue;
+
+        state(i, s);
+
+        for (uint m = 0; m < NUM_FACE_MOVES; ++m) {
+          for (uint k = 0; k < N; ++k)
+            s1[k] = moveTable[s[k]][m];
+
+          uint64_t j = index(s1);
+
+          if (getEntry(db, j) == UNSET) {
+            setEntry(db, j, d + 1);
+
+            ++numNew;
+          }
+        }
+      }
+      else {
+        if (e != UNSET) continue;
+
+        state(i, s);
+
+        for (uint m = 0; m < NUM_FACE_MOVES; ++m) {
+          for (uint k = 0; k < N; ++k)
+            s1[k] = moveTable[s[k]][m];
+
+          if (getEntry(db, index(s1)) == d) {
+            setEntry(db, i, d + 1);
+
+            ++numNew;
+
+            break;
+          }
+        }
+      }
+    }
+
+    numSet += numNew;
+    numLast = numNew;
+  }
+
+  return true;
+}
+
+}
+
+//---
+
+CRubikOptimal::
+CRubikOptimal()
+{
+  setNumThreads(std::thread::hardware_concurrency());
+}
+
+CRubikOptimal::
+~CRubikOptimal()
+{
+  unload();
+}
+
+bool
+CRubikOptimal::
+init()
+{
+  if (isInitialized())
+    return true;
+
+  (void) moveTables();
+
+  if (load())
+    return true;
+
+  return build();
+}
+
+bool
+CRubikOptimal::
+load()
+{
+  int fd = open(fileName_.c_str(), O_RDONLY);
+
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+
+  if (fstat(fd, &st) != 0 || size_t(st.st_size) != fileSize()) {
+    close(fd);
+    return false;
+  }
+
+  void *p = mmap(nullptr, fileSize(), PROT_READ, MAP_SHARED, fd, 0);
+
+  close(fd);
+
+  if (p == MAP_FAILED)
+    return false;
+
+  const Header *header = static_cast<const Header *>(p);
+
+  if (strncmp(header->magic, fileMagic, sizeof(header->magic)) != 0 ||
+      header->version       != fileVersion ||
+      header->headerSize    != sizeof(Header) ||
+      header->cornerEntries != NUM_CORNER_ENTRIES ||
+      header->edgeEntries   != NUM_EDGE_ENTRIES) {
+    munmap(p, fileSize());
+    return false;
+  }
+
+  data_     = static_cast<const uint8_t *>(p);
+  dataSize_ = fileSize();
+
+  cornerDb_ = data_    + sizeof(Header);
+  edgeDb1_  = cornerDb_ + dbSize(NUM_CORNER_ENTRIES);
+  edgeDb2_  = edgeDb1_  + dbSize(NUM_EDGE_ENTRIES);
+
+  return true;
+}
+
+bool
+CRubikOptimal::
+build()
+{
+  const MoveTables &t = moveTables();
+
+  std::vector<uint8_t> buffer(fileSize());
+
+  Header *header = reinterpret_cast<Header *>(&buffer[0]);
+
+  memset(header, 0, sizeof(Header));
+
+  strncpy(header->magic, fileMagic, sizeof(header->magic));
+
+  header->version       = fileVersion;
+  header->headerSize    = sizeof(Header);
+  header->cornerEntries = NUM_CORNER_ENTRIES;
+  header->edgeEntries   = NUM_EDGE_ENTRIES;
+
+  uint8_t *cornerDb = &buffer[sizeof(Header)];
+  uint8_t *edgeDb1  = cornerDb + dbSize(NUM_CORNER_ENTRIES);
+  uint8_t *edgeDb2  = edgeDb1  + dbSize(NUM_EDGE_ENTRIES);
+
+  State solved = stateFromCubie(CRubikCubie());
+
+  if (! buildDb<CRubikCubie::NUM_CORNERS>(cornerDb, NUM_CORNER_ENTRIES, t.cornerMove,
+          solved.corners, cornerIndex, cornerState, cancelled_))
+    return false;
+
+  if (! buildDb<NUM_GROUP_EDGES>(edgeDb1, NUM_EDGE_ENTRIES, t.edgeMove,
+          solved.edges, edgeIndex, edgeState, cancelled_))
+    return false;
+
+  if (! buildDb<NUM_GROUP_EDGES>(edgeDb2, NUM_EDGE_ENTRIES, t.edgeMove,
+          solved.edges + NUM_GROUP_EDGES, edgeIndex, edgeState, cancelled_))
+    return false;
+
+  // save (write to temporary and rename so a partial file is never loaded)
+  std::string tmpName = fileName_ + ".tmp";
+
+  FILE *fp = fopen(tmpName.c_str(), "wb");
+
+  bool saved = false;
+
+  if (fp) {
+    saved = (fwrite(&buffer[0], 1, buffer.size(), fp) == buffer.size());
+
+    saved = (fclose(fp) == 0 && saved);
+
+    if (saved)
+      saved = (rename(tmpName.c_str(), fileName_.c_str()) == 0);
+
+    if (! saved)
+      remove(tmpName.c_str());
+  }
+
+  if (saved && load())
+    return true;
+
+  // can't save so keep in memory
+  buffer_.swap(buffer);
+
+  data_     = &buffer_[0];
+  dataSize_ = buffer_.size();
+
+  cornerDb_ = data_    + sizeof(Header);
+  edgeDb1_  = cornerDb_ + dbSize(NUM_CORNER_ENTRIES);
+  edgeDb2_  = edgeDb1_  + dbSize(NUM_EDGE_ENTRIES);
+
+  return true;
+}
+
+void
+CRubikOptimal::
+unload()
+{
+  if (! data_) return;
+
+  if (buffer_.empty())
+    munmap(const_cast<uint8_t *>(data_), dataSize_);
+  else
+    std::vector<uint8_t>().swap(buffer_);
+
+  data_     = nullptr;
+  dataSize_ = 0;
+
+  cornerDb_ = nullptr;
+  edgeDb1_  = nullptr;
+  edgeDb2_  = nullptr;
+}
+
+//---
+
+CRubikOptimal::State
+CRubikOptimal::
+stateFromCubie(const CRubikCubie &cubie)
+{
+  State state;
+
+  for (uint i = 0; i < CRubikCubie::NUM_CORNERS; ++i)
+    state.corners[cubie.cornerPerm(i)] = uint8_t(i*3 + cubie.cornerOri(i));
+
+  for (uint i = 0; i < CRubikCubie::NUM_EDGES; ++i)
+    state.edges[cubie.edgePerm(i)] = uint8_t(i*2 + cubie.edgeOri(i));
+
+  return state;
+}
+
+uint
+CRubikOptimal::
+heuristic(const State &state) const
+{
+  uint d1 = getEntry(cornerDb_, cornerIndex(state.corners));
+  uint d2 = getEntry(edgeDb1_ , edgeIndex  (state.edges));
+  uint d3 = getEntry(edgeDb2_ , edgeIndex  (state.edges + NUM_GROUP_EDGES));
+
+  return std::max(d1, std::max(d2, d3));
+}
+
+uint
+CRubikOptimal::
+distance(const CRubikCubie &state)
+{
+  if (! init())
+    return 0;
+
+  return heuristic(stateFromCubie(state));
+}
+
+bool
+CRubikOptimal::
+solveOptimal(const CRubikCubie &state, uint maxDepth, std::vector<uint> &moves)
+{
+  numNodes_ = 0;
+
+  depthNodes_.clear();
+
+  for (uint i = 0; i < CRubikCubie::NUM_CENTERS; ++i)
+    if (state.centers[i] != i)
+      return false;
+
+  // search needs at least one move to record a solution
+  if (state.isSolved()) {
+    moves.clear();
+    return true;
+  }
+
+  if (! init())
+    return false;
+
+  maxDepth = std::min(maxDepth, uint(MAX_DEPTH));
+
+  State state1 = stateFromCubie(state);
+
+  for (uint bound = heuristic(state1); bound <= maxDepth; ++bound) {
+    if (progressProc_)
+      progressProc_(bound, numNodes_);
+
+    uint64_t numNodes = numNodes_;
+
+    bool found = searchBound(state1, bound);
+
+    depthNodes_.push_back(numNodes_ - numNodes);
+
+    if (cancelled_)
+      return false;
+
+    if (found) {
+      moves = solution_;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+//---
+
+// subtree below the first two moves
+struct CRubikOptimalTask {
+  uint8_t corners[CRubikCubie::NUM_CORNERS];
+  uint8_t edges  [CRubikCubie::NUM_EDGES];
+  uint    moves  [2];
+};
+
+struct CRubikOptimal::Worker {
+  std::mutex                    mutex;
+  std::deque<CRubikOptimalTask> tasks;
+  uint                          path[MAX_DEPTH + 1];
+  uint64_t                      numNodes { 0 };
+};
+
+void
+CRubikOptimal::
+moveState(const State &state, uint move, State &state1)
+{
+  const MoveTables &t = moveTables();
+
+  for (uint i = 0; i < CRubikCubie::NUM_CORNERS; ++i)
+    state1.corners[i] = t.cornerMove[state.corners[i]][move];
+
+  for (uint i = 0; i < CRubikCubie::NUM_EDGES; ++i)
+    state1.edges[i] = t.edgeMove[state.edges[i]][move];
+}
+
+// search all solutions of bound moves
+bool
+CRubikOptimal::
+searchBound(const State &state, uint bound)
+{
+  solution_.clear();
+
+  bound_ = bound;
+
+  uint numThreads = (bound >= 2 ? numThreads_ : 1);
+
+  std::vector<Worker> workers(numThreads);
+
+  if (numThreads == 1) {
+    search(workers[0], state, 0);
+
+    numNodes_ += workers[0].numNodes;
+
+    return ! solution_.empty();
+  }
+
+  // queue subtrees of first two moves round robin
+  uint numTasks = 1;
+
+  ++numNodes_;
+
+  State state1, state2;
+
+  for (uint m1 = 0; m1 < NUM_FACE_MOVES; ++m1) {
+    moveState(state, m1, state1);
+
+    ++numNodes_;
+
+    if (1 + heuristic(state1) > bound)
+      continue;
+
+    for (uint m2 = 0; m2 < NUM_FACE_MOVES; ++m2) {
+      if (skipMove(m1, m2))
+        continue;
+
+      moveState(state1, m2, state2);
+
+      CRubikOptimalTask task;
+
+      memcpy(task.corners, state2.corners, sizeof(task.corners));
+      memcpy(task.edges  , state2.edges  , sizeof(task.edges  ));
+
+      task.moves[0] = m1;
+      task.moves[1] = m2;
+
+      workers[numTasks++ % numThreads].tasks.push_back(task);
+    }
+  }
+
+  std::vector<std::thread> threads;
+
+  for (uint i = 1; i < numThreads; ++i)
+    threads.emplace_back(&CRubikOptimal::runWorker, this, std::ref(workers), i, bound);
+
+  runWorker(workers, 0, bound);
+
+  for (auto &thread : threads)
+    thread.join();
+
+  for (const auto &worker : workers)
+    numNodes_ += worker.numNodes;
+
+  return ! solution_.empty();
+}
+
+// run own tasks (from the front) then steal tasks from other workers (from the back)
+void
+CRubikOptimal::
+runWorker(std::vector<Worker> &workers, uint i, uint bound)
+{
+  Worker &worker = workers[i];
+
+  uint n = uint(workers.size());
+
+  CRubikOptimalTask task;
+
+  while (bound_.load(std::memory_order_relaxed) == bound) {
+    bool found = false;
+
+    for (uint j = 0; j < n && ! found; ++j) {
+      Worker &worker1 = workers[(i + j) % n];
+
+      std::lock_guard<std::mutex> lock(worker1.mutex);
+
+      if (worker1.tasks.empty())
+        continue;
+
+      if (j == 0) {
+        task = worker1.tasks.front(); worker1.tasks.pop_front();
+      }
+      else {
+        task = worker1.tasks.back(); worker1.tasks.pop_back();
+      }
+
+      found = true;
+    }
+
+    if (! found)
+      break;
+
+    State state;
+
+    memcpy(state.corners, task.corners, sizeof(state.corners));
+    memcpy(state.edges  , task.edges  , sizeof(state.edges  ));
+
+    worker.path[0] = task.moves[0];
+    worker.path[1] = task.moves[1];
+
+    search(worker, state, 2);
+  }
+}
+
+bool
+CRubikOptimal::
+search(Worker &worker, const State &state, uint depth)
+{
+  // check cancel every 4096 nodes (zero bound stops all threads)
+  if ((++worker.numNodes & 0xFFF) == 0 && cancelled_) {
+    bound_ = 0;
+    return false;
+  }
+
+  uint dist = heuristic(state);
+
+  if (dist == 0) {
+    // first solution found drops the shared bound to stop the other threads
+    uint bound = depth;
+
+    if (bound_.compare_exchange_strong(bound, 0))
+      solution_.assign(worker.path, worker.path + depth);
+
+    return true;
+  }
+
+  if (depth + dist > bound_.load(std::memory_order_relaxed))
+    return false;
+
+  State state1;
+
+  for (uint m = 0; m < NUM_FACE_MOVES; ++m) {
+    if (depth > 0 && skipMove(worker.path[depth - 1], m))
+      continue;
+
+    moveState(state, m, state1);
+
+    worker.path[depth] = m;
+
+    if (search(worker, state1, depth + 1))
+      return true;
+  }
+
+  return false;
+}
@@ -0,0 +1,119 @@
+#ifndef CRUBIK_OPTIMAL_H
+#define CRUBIK_OPTIMAL_H
+
+#include <CRubikMove.h>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Optimal solver (half turn metric) using IDA* with pattern databases.
+//
+// The heuristic is the maximum of three pattern databases holding the exact number
+// of moves to solve
+//  . the 8 corners (positions and twists, 8!*3^7 entries)
+//  . the edges UR UF UL UB DR DF (positions and flips, 12!/6!*2^6 entries)
+//  . the edges DL DB FR FL BL BR (positions and flips, 12!/6!*2^6 entries)
+// stored as 4 bit values (about 85Mb in total).
+//
+// The databases are built by breadth first search and written to a file the first
+// time init is called, later runs memory map the file.
+//
+// Each IDA* iteration is split into the subtrees of the first two moves which are
+// shared out to worker threads (idle threads steal subtrees queued for the others).
+// The first thread to find a solution lowers the shared bound so all other threads
+// stop. Cancelling (from another thread) stops the search the same way.
+//
+// The cubie centers must be solved (use whole cube rotations first). Solutions are
+// face moves (CRubikMove ids < NUM_FACE_MOVES).
+class CRubikOptimal {
+ public:
+  enum { MAX_DEPTH = 20 };
+
+  // called at the start of each IDA* iteration
+  using ProgressProc = std::function<void (uint depth, uint64_t numNodes)>;
+
+ public:
+  CRubikOptimal();
+ ~CRubikOptimal();
+
+  CRubikOptimal(const CRubikOptimal &) = delete;
+  CRubikOptimal &operator=(const CRubikOptimal &) = delete;
+
+  const std::string &fileName() const { return fileName_; }
+  void setFileName(const std::string &fileName) { fileName_ = fileName; }
+
+  bool isInitialized() const { return data_ != nullptr; }
+
+  // number of search threads (defaults to number of cores)
+  uint numThreads() const { return numThreads_; }
+  void setNumThreads(uint n) { numThreads_ = std::max(n, 1u); }
+
+  void setProgressProc(const ProgressProc &proc) { progressProc_ = proc; }
+
+  // stop running solve or database build (thread safe), stays cancelled until cleared
+  void cancel() { cancelled_ = true; }
+
+  void clearCancel() { cancelled_ = false; }
+
+  bool isCancelled() const { return cancelled_; }
+
+  // load (or build and save) pattern databases (fails if cancelled during build)
+  bool init();
+
+  // search up to maxDepth moves for an optimal solution
+  bool solveOptimal(const CRubikCubie &state, uint maxDepth, std::vector<uint> &moves);
+
+  // nodes expanded by last solve (total and per IDA* iteration)
+  uint64_t numNodes() const { return numNodes_; }
+
+  const std::vector<uint64_t> &depthNodes() const { return depthNodes_; }
+
+  // lower bound on moves to solve state
+  uint distance(const CRubikCubie &state);
+
+ private:
+  // cubie positions indexed by cubie : position*3 + twist for corners and
+  // position*2 + flip for edges
+  struct State {
+    uint8_t corners[CRubikCubie::NUM_CORNERS];
+    uint8_t edges  [CRubikCubie::NUM_EDGES];
+  };
+
+  struct Worker;
+
+  static State stateFromCubie(const CRubikCubie &cubie);
+
+  static void moveState(const State &state, uint move, State &state1);
+
+  uint heuristic(const State &state) const;
+
+  bool searchBound(const State &state, uint bound);
+
+  void runWorker(std::vector<Worker> &workers, uint i, uint bound);
+
+  bool search(Worker &worker, const State &state, uint depth);
+
+  bool load();
+  bool build();
+  void unload();
+
+ private:
+  std::string           fileName_ { "CRubikOptimal.pdb" };
+  const uint8_t*        data_     { nullptr };
+  size_t                dataSize_ { 0 };
+  std::vector<uint8_t>  buffer_;
+  const uint8_t*        cornerDb_ { nullptr };
+  const uint8_t*        edgeDb1_  { nullptr };
+  const uint8_t*        edgeDb2_  { nullptr };
+  uint                  numThreads_ { 1 };
+  std::atomic<uint>     bound_      { 0 };
+  std::atomic<bool>     cancelled_  { false };
+  ProgressProc          progressProc_;
+  std::vector<uint>     solution_;
+  uint64_t              numNodes_   { 0 };
+  std::vector<uint64_t> depthNodes_;
+};
+
+#endif
@@ -0,0 +1,166 @@
+#include <CRubikPerm.h>
+#include <cstring>
+#include <numeric>
+
+void
+CRubikPerm::
+reset()
+{
+  for (uint i = 0; i < SIZE; ++i)
+    p[i] = uint8_t(i);
+}
+
+void
+CRubikPerm::
+setMove(uint move)
+{
+  memcpy(p, CRubikMove::perm(move), CRubikMove::NUM_FACELETS);
+
+  for (uint i = CRubikMove::NUM_FACELETS; i < SIZE; ++i)
+    p[i] = uint8_t(i);
+}
+
+bool
+CRubikPerm::
+isIdentity() const
+{
+  return (*this == CRubikPerm());
+}
+
+bool
+CRubikPerm::
+operator==(const CRubikPerm &perm) const
+{
+  return (memcmp(p, perm.p, SIZE) == 0);
+}
+
+void
+CRubikPerm::
+multiply(const CRubikPerm &perm)
+{
+  uint8_t p1[SIZE];
+
+  for (uint i = 0; i < SIZE; ++i)
+    p1[i] = p[perm.p[i]];
+
+  memcpy(p, p1, SIZE);
+}
+
+void
+CRubikPerm::
+addMove(uint move)
+{
+  const uint8_t *mp = CRubikMove::perm(move);
+
+  uint8_t p1[CRubikMove::NUM_FACELETS];
+
+  for (uint i = 0; i < CRubikMove::NUM_FACELETS; ++i)
+    p1[i] = p[mp[i]];
+
+  memcpy(p, p1, CRubikMove::NUM_FACELETS);
+}
+
+void
+CRubikPerm::
+addMoves(const std::vector<uint> &moves)
+{
+  for (const auto &move : moves)
+    addMove(move);
+}
+
+CRubikPerm
+CRubikPerm::
+product(const CRubikPerm &perm, const CRubikPerm &perm1)
+{
+  CRubikPerm perm2 = perm;
+
+  perm2.multiply(perm1);
+
+  return perm2;
+}
+
+CRubikPerm
+CRubikPerm::
+inverse() const
+{
+  CRubikPerm perm;
+
+  for (uint i = 0; i < SIZE; ++i)
+    perm.p[p[i]] = uint8_t(i);
+
+  return perm;
+}
+
+CRubikPerm
+CRubikPerm::
+power(int n) const
+{
+  // square and multiply
+  CRubikPerm perm;
+  CRubikPerm square = (n < 0 ? inverse() : *this);
+
+  for (uint m = (n < 0 ? 0u - uint(n) : uint(n)); m; m >>= 1) {
+    if (m & 1)
+      perm.multiply(square);
+
+    square.multiply(square);
+  }
+
+  return perm;
+}
+
+uint
+CRubikPerm::
+order() const
+{
+  // mark cycle lengths then take lcm of the distinct lengths
+  uint64_t visited = 0, lengths = 0;
+
+  for (uint i = 0; i < CRubikMove::NUM_FACELETS; ++i) {
+    if (visited & (uint64_t(1) << i))
+      continue;
+
+    uint len = 0;
+
+    for (uint j = i; ! (visited & (uint64_t(1) << j)); j = p[j], ++len)
+      visited |= uint64_t(1) << j;
+
+    lengths |= uint64_t(1) << len;
+  }
+
+  uint order = 1;
+
+  for (lengths &= ~uint64_t(3); lengths; lengths &= lengths - 1) {
+    uint len = uint(__builtin_ctzll(lengths));
+
+    order = order/std::gcd(order, len)*len;
+  }
+
+  return order;
+}
+
+std::vector<std::vector<uint8_t>>
+CRubikPerm::
+cycles() const
+{
+  std::vector<std::vector<uint8_t>> cycles;
+
+  uint64_t visited = 0;
+
+  for (uint i = 0; i < CRubikMove::NUM_FACELETS; ++i) {
+    if (visited & (uint64_t(1) << i) || p[i] == i)
+      continue;
+
+    std::vector<uint8_t> cycle;
+
+    for (uint j = i; ! (visited & (uint64_t(1) << j)); j = p[j]) {
+      visited |= uint64_t(1) << j;
+
+      cycle.push_back(uint8_t(j));
+    }
+
+    cycles.push_back(cycle);
+  }
+
+  return cycles;
+}
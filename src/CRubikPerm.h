@@ -0,0 +1,53 @@
+#ifndef CRUBIK_PERM_H
+#define CRUBIK_PERM_H
+
+#include <CRubikMove.h>
+#include <vector>
+
+// Facelet permutation padded to a 64 byte vector so it can be applied with a single
+// byte shuffle. Entries 54..63 are fixed (identity) padding.
+//
+// Like CRubikMove the permutation is a gather : new[i] = old[p[i]].
+struct alignas(64) CRubikPerm {
+  enum { SIZE = 64 };
+
+  uint8_t p[SIZE];
+
+  CRubikPerm() { reset(); }
+
+  explicit CRubikPerm(uint move) { setMove(move); }
+
+  // net permutation of move sequence
+  explicit CRubikPerm(const std::vector<uint> &moves) { reset(); addMoves(moves); }
+
+  void reset();
+
+  void setMove(uint move);
+
+  bool isIdentity() const;
+
+  bool operator==(const CRubikPerm &perm) const;
+  bool operator!=(const CRubikPerm &perm) const { return ! (*this == perm); }
+
+  // apply perm after this one
+  void multiply(const CRubikPerm &perm);
+
+  void addMove (uint move);
+  void addMoves(const std::vector<uint> &moves);
+
+  // perm followed by perm1
+  static CRubikPerm product(const CRubikPerm &perm, const CRubikPerm &perm1);
+
+  CRubikPerm inverse() const;
+
+  // perm applied n times (inverse for n < 0)
+  CRubikPerm power(int n) const;
+
+  // number of applications which return to identity (lcm of cycle lengths)
+  uint order() const;
+
+  // cycles of length > 1 (each as the facelet indices i, p[i], p[p[i]], ...)
+  std::vector<std::vector<uint8_t>> cycles() const;
+};
+
+#endif
@@ -0,0 +1,301 @@
+#include <CRubikProgram.h>
+#include <cctype>
+#include <cstring>
+
+namespace {
+
+// recursive descent parser for CRubikProgram syntax
+class CRubikProgramParser {
+ public:
+  CRubikProgramParser(const std::string &str) :
+   str_(str) {
+  }
+
+  const std::string &errorMsg() const { return errorMsg_; }
+  uint               errorPos() const { return errorPos_; }
+
+  bool parse(std::vector<uint> &moves) {
+    if (! parseSeq(moves, ""))
+      return false;
+
+    if (pos_ < str_.size())
+      return error("Unexpected '" + std::string(1, str_[pos_]) + "'");
+
+    return true;
+  }
+
+ private:
+  // sequence up to end of string or one of the end chars
+  bool parseSeq(std::vector<uint> &moves, const char *endChars) {
+    for (;;) {
+      skipSpace();
+
+      if (pos_ >= str_.size() || strchr(endChars, str_[pos_]))
+        return true;
+
+      if (! parseItem(moves))
+        return false;
+    }
+  }
+
+  bool parseItem(std::vector<uint> &moves) {
+    char c = str_[pos_];
+
+    std::vector<uint> moves1;
+
+    if      (c == '(') {
+      ++pos_;
+
+      if (! parseSeq(moves1, ")") || ! parseChar(')'))
+        return false;
+    }
+    else if (c == '[') {
+      ++pos_;
+
+      std::vector<uint> a;
+
+      if (! parseSeq(a, ",:]"))
+        return false;
+
+      if      (isChar(',') || isChar(':')) {
+        bool commutator = isChar(',');
+
+        ++pos_;
+
+        std::vector<uint> b;
+
+        if (! parseSeq(b, "]"))
+          return false;
+
+        // A B A' (B')
+        moves1 = a;
+
+        moves1.insert(moves1.end(), b.begin(), b.end());
+
+        addInverse(a, moves1);
+
+        if (commutator)
+          addInverse(b, moves1);
+      }
+      else
+        moves1 = a;
+
+      if (! parseChar(']'))
+        return false;
+    }
+    else {
+      if (! parseMove(moves1))
+        return false;
+    }
+
+    // count and inverse
+    uint count   = 1;
+    bool inverse = false;
+
+    if (isChar('\'')) { inverse = true; ++pos_; }
+
+    if (pos_ < str_.size() && isdigit(str_[pos_])) {
+      count = 0;
+
+      while (pos_ < str_.size() && isdigit(str_[pos_])) {
+        count = count*10 + uint(str_[pos_++] - '0');
+
+        if (count > CRubikProgram::MAX_MOVES)
+          return error("Count too large");
+      }
+    }
+
+    if (isChar('\'')) { inverse = ! inverse; ++pos_; }
+
+    if (inverse) {
+      std::vector<uint> moves2;
+
+      addInverse(moves1, moves2);
+
+      moves1.swap(moves2);
+    }
+
+    // single moves combine turns (R3 is R')
+    if (moves1.size() == 1 || (moves1.size() == 2 && isWide_)) {
+      for (const auto &move : moves1) {
+        uint turns = (count*(CRubikMove::turn(move) + 1)) % 4;
+
+        if (turns != 0)
+          moves.push_back(CRubikMove::move(CRubikMove::base(move), turns - 1));
+      }
+    }
+    else {
+      if (moves.size() + size_t(count)*moves1.size() > CRubikProgram::MAX_MOVES)
+        return error("Too many moves");
+
+      for (uint i = 0; i < count; ++i)
+        moves.insert(moves.end(), moves1.begin(), moves1.end());
+    }
+
+    isWide_ = false;
+
+    return true;
+  }
+
+  bool parseMove(std::vector<uint> &moves) {
+    static const char *faceNames  = "LUFDRB";
+    static const char *wideNames  = "lufdrb";
+    static const char *otherNames = "MESxyz";
+
+    // slice turned with each face for wide moves (M as L, E as D, S as F)
+    static const uint wideSlices[] = {
+      CRubikMove::move(CRubikMove::BASE_M, CRubikMove::TURN_CW ),
+      CRubikMove::move(CRubikMove::BASE_E, CRubikMove::TURN_CCW),
+      CRubikMove::move(CRubikMove::BASE_S, CRubikMove::TURN_CW ),
+      CRubikMove::move(CRubikMove::BASE_E, CRubikMove::TURN_CW ),
+      CRubikMove::move(CRubikMove::BASE_M, CRubikMove::TURN_CCW),
+      CRubikMove::move(CRubikMove::BASE_S, CRubikMove::TURN_CCW),
+    };
+
+    char c = str_[pos_];
+
+    const char *p;
+
+    if      ((p = strchr(faceNames, c)) != nullptr) {
+      uint face = uint(p - faceNames);
+
+      ++pos_;
+
+      moves.push_back(CRubikMove::move(face, CRubikMove::TURN_CW));
+
+      if (isChar('w')) {
+        ++pos_;
+
+        moves.push_back(wideSlices[face]);
+
+        isWide_ = true;
+      }
+    }
+    else if ((p = strchr(wideNames, c)) != nullptr) {
+      uint face = uint(p - wideNames);
+
+      ++pos_;
+
+      moves.push_back(CRubikMove::move(face, CRubikMove::TURN_CW));
+      moves.push_back(wideSlices[face]);
+
+      isWide_ = true;
+    }
+    else if ((p = strchr(otherNames, c)) != nullptr) {
+      ++pos_;
+
+      moves.push_back(CRubikMove::move(CRubikMove::BASE_M + uint(p - otherNames),
+                                       CRubikMove::TURN_CW));
+    }
+    else
+      return error("Unexpected '" + std::string(1, c) + "'");
+
+    return true;
+  }
+
+  // append inverse of moves
+  static void addInverse(const std::vector<uint> &moves, std::vector<uint> &moves1) {
+    for (auto p = moves.rbegin(); p != moves.rend(); ++p)
+      moves1.push_back(CRubikMove::inverse(*p));
+  }
+
+  void skipSpace() {
+    while (pos_ < str_.size()) {
+      char c = str_[pos_];
+
+      if      (isspace(c))
+        ++pos_;
+      else if (c == '#' || (c == '/' && pos_ + 1 < str_.size() && str_[pos_ + 1] == '/')) {
+        while (pos_ < str_.size() && str_[pos_] != '\n')
+          ++pos_;
+      }
+      else
+        break;
+    }
+  }
+
+  bool isChar(char c) const { return (pos_ < str_.size() && str_[pos_] == c); }
+
+  bool parseChar(char c) {
+    skipSpace();
+
+    if (! isChar(c))
+      return error("Missing '" + std::string(1, c) + "'");
+
+    ++pos_;
+
+    return true;
+  }
+
+  bool error(const std::string &msg) {
+    errorMsg_ = msg;
+    errorPos_ = uint(pos_);
+
+    return false;
+  }
+
+ private:
+  const std::string &str_;
+  size_t             pos_    { 0 };
+  bool               isWide_ { false };
+  std::string        errorMsg_;
+  uint               errorPos_ { 0 };
+};
+
+}
+
+//---
+
+bool
+CRubikProgram::
+compile(const std::string &str)
+{
+  code_.clear();
+
+  perm_ .reset();
+  cubie_.reset();
+
+  errorMsg_.clear();
+  errorPos_ = 0;
+
+  std::vector<uint> moves;
+
+  if (! parse(str, moves, &errorMsg_, &errorPos_))
+    return false;
+
+  code_.assign(moves.begin(), moves.end());
+
+  for (const auto &move : moves) {
+    perm_ .addMove(move);
+    cubie_.multiply(CRubikMove::cubie(move));
+  }
+
+  return true;
+}
+
+std::string
+CRubikProgram::
+toString() const
+{
+  return CRubikMove::names(moves());
+}
+
+bool
+CRubikProgram::
+parse(const std::string &str, std::vector<uint> &moves, std::string *errorMsg, uint *errorPos)
+{
+  CRubikProgramParser parser(str);
+
+  std::vector<uint> moves1;
+
+  if (! parser.parse(moves1)) {
+    if (errorMsg) *errorMsg = parser.errorMsg();
+    if (errorPos) *errorPos = parser.errorPos();
+
+    return false;
+  }
+
+  moves.insert(moves.end(), moves1.begin(), moves1.end());
+
+  return true;
+}
@@ -0,0 +1,82 @@
+#ifndef CRUBIK_PROGRAM_H
+#define CRUBIK_PROGRAM_H
+
+#include <CRubikPerm.h>
+#include <string>
+#include <vector>
+
+// Algorithm compiled from move notation.
+//
+// The string is parsed once into a flat list of move ids (one byte each) and the net
+// effect of the whole list is kept as a facelet permutation and a cubie state, so the
+// program can be applied many times without parsing again (a single gather or cubie
+// multiply, or CRubikShuffle::apply(perm()) for batches of cubes).
+//
+// Syntax :
+//  . faces L U F D R B, slices M E S, whole cube rotations x y z
+//  . wide (two layer) moves l u f d r b or Lw Uw Fw Dw Rw Bw
+//  . each move (or group) may be followed by a count and/or ' (inverse) e.g. R2 U' F3
+//  . groups (...) and [...] may be followed by a count and/or ' e.g. (R U R' U')3
+//  . [A, B] is the commutator A B A' B' and [A: B] the conjugate A B A'
+//  . // or # starts a comment to the end of the line
+//
+// Face directions are standard (e.g. R is clockwise looking at the R face, see CRubikMove).
+class CRubikProgram {
+ public:
+  enum { MAX_MOVES = 1 << 20 };
+
+ public:
+  CRubikProgram() { }
+
+  explicit CRubikProgram(const std::string &str) { compile(str); }
+
+  // compile string (on error the program is empty and error is set)
+  bool compile(const std::string &str);
+
+  bool isValid() const { return errorMsg_.empty(); }
+
+  const std::string &errorMsg() const { return errorMsg_; }
+  uint               errorPos() const { return errorPos_; }
+
+  uint size() const { return uint(code_.size()); }
+
+  uint move(uint i) const { return code_[i]; }
+
+  const std::vector<uint8_t> &code() const { return code_; }
+
+  std::vector<uint> moves() const { return std::vector<uint>(code_.begin(), code_.end()); }
+
+  // net effect
+  const CRubikPerm  &perm () const { return perm_ ; }
+  const CRubikCubie &cubie() const { return cubie_; }
+
+  // apply net effect to cubie state or facelet array
+  void apply(CRubikCubie &cubie) const { cubie.multiply(cubie_); }
+
+  template<typename T>
+  void apply(T *facelets) const {
+    T t[CRubikMove::NUM_FACELETS];
+
+    for (uint i = 0; i < CRubikMove::NUM_FACELETS; ++i)
+      t[i] = facelets[perm_.p[i]];
+
+    for (uint i = 0; i < CRubikMove::NUM_FACELETS; ++i)
+      facelets[i] = t[i];
+  }
+
+  // move names (as read by compile)
+  std::string toString() const;
+
+  // parse string into moves (appended)
+  static bool parse(const std::string &str, std::vector<uint> &moves,
+                    std::string *errorMsg=nullptr, uint *errorPos=nullptr);
+
+ private:
+  std::vector<uint8_t> code_;
+  CRubikPerm           perm_;
+  CRubikCubie          cubie_;
+  std::string          errorMsg_;
+  uint                 errorPos_ { 0 };
+};
+
+#endif
@@ -0,0 +1,145 @@
+#include <CRubikRandom.h>
+#include <utility>
+
+namespace {
+
+enum : uint64_t {
+  CORNER_PERMS  = 40320,     // 8!
+  CORNER_TWISTS = 2187,      // 3^7
+  EDGE_PERMS    = 479001600, // 12!
+  EDGE_FLIPS    = 2048       // 2^11
+};
+
+// decode permutation from index (each mixed radix digit is a Fisher-Yates swap)
+// returning its parity (size is a template parameter so the divisions are by constants)
+template<uint n>
+uint decodePerm(uint32_t ind, uint8_t *perm)
+{
+  for (uint i = 0; i < n; ++i)
+    perm[i] = uint8_t(i);
+
+  uint parity = 0;
+
+  for (uint i = n - 1; i > 0; --i) {
+    uint j = ind % (i + 1);
+
+    ind /= i + 1;
+
+    std::swap(perm[i], perm[j]);
+
+    parity ^= (i != j);
+  }
+
+  return parity;
+}
+
+}
+
+//---
+
+CRubikRandom::
+CRubikRandom(uint64_t seed, uint64_t stream)
+{
+  setSeed(seed, stream);
+}
+
+void
+CRubikRandom::
+setSeed(uint64_t seed, uint64_t stream)
+{
+  seed_   = seed;
+  stream_ = stream;
+
+  std::seed_seq seq { uint32_t(seed), uint32_t(seed >> 32), uint32_t(stream), uint32_t(stream >> 32) };
+
+  gen_.seed(seq);
+}
+
+void
+CRubikRandom::
+randomState(CRubikCubie &cubie)
+{
+  uint8_t cp[CRubikCubie::NUM_CORNERS], ep[CRubikCubie::NUM_EDGES];
+
+  uint64_t c = randBelow(CORNER_PERMS*CORNER_TWISTS);
+  uint64_t e = randBelow(EDGE_PERMS*EDGE_FLIPS);
+
+  uint cornerParity = decodePerm<CRubikCubie::NUM_CORNERS>(uint32_t(c % CORNER_PERMS), cp);
+  uint edgeParity   = decodePerm<CRubikCubie::NUM_EDGES  >(uint32_t(e % EDGE_PERMS  ), ep);
+
+  if (cornerParity != edgeParity)
+    std::swap(ep[CRubikCubie::NUM_EDGES - 2], ep[CRubikCubie::NUM_EDGES - 1]);
+
+  // twists (flips) of all but the last cubie, last one makes the total zero
+  uint twists = uint(c / CORNER_PERMS), twist = 0;
+
+  for (uint i = 0; i < CRubikCubie::NUM_CORNERS - 1; ++i) {
+    uint ori = twists % 3;
+
+    twists /= 3;
+
+    cubie.setCorner(i, cp[i], ori);
+
+    twist += ori;
+  }
+
+  cubie.setCorner(CRubikCubie::NUM_CORNERS - 1, cp[CRubikCubie::NUM_CORNERS - 1],
+                  (3 - twist % 3) % 3);
+
+  uint flips = uint(e / EDGE_PERMS), flip = 0;
+
+  for (uint i = 0; i < CRubikCubie::NUM_EDGES - 1; ++i) {
+    uint ori = (flips >> i) & 1;
+
+    cubie.setEdge(i, ep[i], ori);
+
+    flip ^= ori;
+  }
+
+  cubie.setEdge(CRubikCubie::NUM_EDGES - 1, ep[CRubikCubie::NUM_EDGES - 1], flip);
+
+  for (uint i = 0; i < CRubikCubie::NUM_CENTERS; ++i)
+    cubie.centers[i] = uint8_t(i);
+}
+
+void
+CRubikRandom::
+randomStates(CRubikCubie *cubies, size_t num)
+{
+  for (size_t i = 0; i < num; ++i)
+    randomState(cubies[i]);
+}
+
+void
+CRubikRandom::
+randomBytes(uint8_t *bytes, size_t num)
+{
+  CRubikCubie cubie;
+
+  for (size_t i = 0; i < num; ++i) {
+    randomState(cubie);
+
+    cubie.toBytes(&bytes[i*CRubikCubie::NUM_BYTES]);
+  }
+}
+
+uint64_t
+CRubikRandom::
+randBelow(uint64_t n)
+{
+  // multiply and shift, rejecting the low products which would bias the result
+  unsigned __int128 m = (unsigned __int128) gen_()*n;
+
+  uint64_t l = uint64_t(m);
+
+  if (l < n) {
+    uint64_t t = -n % n;
+
+    while (l < t) {
+      m = (unsigned __int128) gen_()*n;
+      l = uint64_t(m);
+    }
+  }
+
+  return uint64_t(m >> 64);
+}
@@ -0,0 +1,47 @@
+#ifndef CRUBIK_RANDOM_H
+#define CRUBIK_RANDOM_H
+
+#include <CRubikCubie.h>
+#include <cstddef>
+#include <random>
+
+// Uniform random cube states.
+//
+// Each state is picked with equal probability from the 8!*3^7*12!*2^11/2 (about 4.3e19)
+// states reachable from solved (centers solved). The corner permutation and twists are
+// decoded from one random number and the edge permutation and flips from another, an
+// edge permutation with the wrong parity has its last two edges swapped (which maps
+// exactly two permutations onto each valid one).
+//
+// The random stream is std::mt19937_64 so a seed (and stream number) always gives the
+// same states. Use separate streams for separate threads.
+class CRubikRandom {
+ public:
+  explicit CRubikRandom(uint64_t seed=std::random_device()(), uint64_t stream=0);
+
+  void setSeed(uint64_t seed, uint64_t stream=0);
+
+  uint64_t seed  () const { return seed_  ; }
+  uint64_t stream() const { return stream_; }
+
+  void randomState(CRubikCubie &cubie);
+
+  CRubikCubie randomState() { CRubikCubie cubie; randomState(cubie); return cubie; }
+
+  // fill num states
+  void randomStates(CRubikCubie *cubies, size_t num);
+
+  // fill num states as CRubikCubie::NUM_BYTES encodings (num*NUM_BYTES bytes)
+  void randomBytes(uint8_t *bytes, size_t num);
+
+ private:
+  // unbiased random number in [0, n)
+  uint64_t randBelow(uint64_t n);
+
+ private:
+  uint64_t        seed_   { 0 };
+  uint64_t        stream_ { 0 };
+  std::mt19937_64 gen_;
+};
+
+#endif
@@ -0,0 +1,101 @@
+#include <CRubikScramble.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+CRubikScramble::
+CRubikScramble(uint64_t seed, uint64_t stream) :
+ random_(seed, stream)
+{
+  // no time limit (scramble must not depend on machine speed)
+  kociemba_.setTimeout(0);
+}
+
+bool
+CRubikScramble::
+scramble(std::vector<uint> &moves)
+{
+  for (;;) {
+    if (! scrambleState(random_.randomState(), moves))
+      return false;
+
+    if (moves.size() >= MIN_MOVES)
+      return true;
+  }
+}
+
+bool
+CRubikScramble::
+scramble(std::string &str)
+{
+  std::vector<uint> moves;
+
+  if (! scramble(moves))
+    return false;
+
+  str = CRubikMove::names(moves);
+
+  return true;
+}
+
+bool
+CRubikScramble::
+scrambleState(const CRubikCubie &state, std::vector<uint> &moves)
+{
+  std::vector<uint> solution;
+
+  if (! kociemba_.solve(state, solution))
+    return false;
+
+  // inverse of solution
+  moves.resize(solution.size());
+
+  std::transform(solution.rbegin(), solution.rend(), moves.begin(),
+                 [](uint move) { return CRubikMove::inverse(move); });
+
+  return true;
+}
+
+bool
+CRubikScramble::
+generate(uint64_t seed, size_t num, uint numThreads, uint maxLength,
+         std::vector<std::string> &scrambles)
+{
+  CRubikKociemba::init();
+
+  scrambles.clear();
+  scrambles.resize(num);
+
+  std::atomic<size_t> next   { 0 };
+  std::atomic<bool>   failed { false };
+
+  auto runWorker = [&]() {
+    CRubikScramble scramble(seed);
+
+    scramble.getKociemba().setMaxLength(maxLength);
+
+    for (;;) {
+      size_t i = next++;
+
+      if (i >= num || failed)
+        break;
+
+      scramble.getRandom().setSeed(seed, i);
+
+      if (! scramble.scramble(scrambles[i]))
+        failed = true;
+    }
+  };
+
+  std::vector<std::thread> workers;
+
+  for (uint i = 1; i < std::max(numThreads, 1u); ++i)
+    workers.emplace_back(runWorker);
+
+  runWorker();
+
+  for (auto &worker : workers)
+    worker.join();
+
+  return ! failed;
+}
@@ -0,0 +1,46 @@
+#ifndef CRUBIK_SCRAMBLE_H
+#define CRUBIK_SCRAMBLE_H
+
+#include <CRubikKociemba.h>
+#include <CRubikRandom.h>
+#include <string>
+#include <vector>
+
+// Random state scrambles (as used for competitions).
+//
+// A uniform random state (see CRubikRandom) is solved with the two phase solver and
+// the scramble is the inverse of the solution, so applying it to a solved cube gives
+// the random state. States which can be solved in fewer than MIN_MOVES moves are
+// skipped. Scrambles are face moves and their names are the CRubikModel::execute
+// notation.
+//
+// generate produces many scrambles on a pool of threads, scramble i always uses random
+// stream i of the seed so the results do not depend on the number of threads.
+class CRubikScramble {
+ public:
+  enum { MIN_MOVES = 2 };
+
+ public:
+  explicit CRubikScramble(uint64_t seed=std::random_device()(), uint64_t stream=0);
+
+  CRubikRandom &getRandom() { return random_; }
+
+  CRubikKociemba &getKociemba() { return kociemba_; }
+
+  // scramble for next random state
+  bool scramble(std::vector<uint> &moves);
+  bool scramble(std::string &str);
+
+  // scramble for given state
+  bool scrambleState(const CRubikCubie &state, std::vector<uint> &moves);
+
+  // num scrambles on numThreads threads (maxLength is solver max length)
+  static bool generate(uint64_t seed, size_t num, uint numThreads, uint maxLength,
+                       std::vector<std::string> &scrambles);
+
+ private:
+  CRubikRandom   random_;
+  CRubikKociemba kociemba_;
+};
+
+#endif
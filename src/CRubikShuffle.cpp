@@ -0,0 +1,231 @@
+#include <CRubikShuffle.h>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CRUBIK_SHUFFLE_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+CRubikShuffle::Kernel s_kernel = CRubikShuffle::Kernel::AUTO;
+
+void
+applyScalar(const CRubikPerm &perm, uint8_t *cubes, size_t num)
+{
+  uint8_t t[CRubikPerm::SIZE];
+
+  for (size_t n = 0; n < num; ++n, cubes += CRubikPerm::SIZE) {
+    for (uint i = 0; i < CRubikPerm::SIZE; ++i)
+      t[i] = cubes[perm.p[i]];
+
+    memcpy(cubes, t, CRubikPerm::SIZE);
+  }
+}
+
+#ifdef CRUBIK_SHUFFLE_X86
+// pshufb only shuffles within 16 bytes so split the permutation into one mask per
+// (destination, source) 16 byte chunk, with 0x80 (zero) for bytes from other chunks
+struct ChunkMasks {
+  alignas(16) uint8_t masks[4][4][16];
+
+  ChunkMasks(const CRubikPerm &perm) {
+    for (uint k = 0; k < 4; ++k) {
+      for (uint j = 0; j < 4; ++j) {
+        for (uint i = 0; i < 16; ++i) {
+          uint p = perm.p[k*16 + i];
+
+          masks[k][j][i] = uint8_t(p/16 == j ? p % 16 : 0x80);
+        }
+      }
+    }
+  }
+};
+
+__attribute__((target("ssse3")))
+void
+applySSSE3(const CRubikPerm &perm, uint8_t *cubes, size_t num)
+{
+  ChunkMasks chunkMasks(perm);
+
+  __m128i m[4][4];
+
+  for (uint k = 0; k < 4; ++k)
+    for (uint j = 0; j < 4; ++j)
+      m[k][j] = _mm_load_si128(reinterpret_cast<const __m128i *>(chunkMasks.masks[k][j]));
+
+  for (size_t n = 0; n < num; ++n, cubes += CRubikPerm::SIZE) {
+    __m128i *c = reinterpret_cast<__m128i *>(cubes);
+
+    __m128i s[4];
+
+    for (uint j = 0; j < 4; ++j)
+      s[j] = _mm_loadu_si128(c + j);
+
+    for (uint k = 0; k < 4; ++k) {
+      __m128i d = _mm_or_si128(_mm_shuffle_epi8(s[0], m[k][0]),
+                               _mm_shuffle_epi8(s[1], m[k][1]));
+      __m128i e = _mm_or_si128(_mm_shuffle_epi8(s[2], m[k][2]),
+                               _mm_shuffle_epi8(s[3], m[k][3]));
+
+      _mm_storeu_si128(c + k, _mm_or_si128(d, e));
+    }
+  }
+}
+
+__attribute__((target("avx2")))
+void
+applyAVX2(const CRubikPerm &perm, uint8_t *cubes, size_t num)
+{
+  ChunkMasks chunkMasks(perm);
+
+  // destination halves (k = 0, 1) use masks for chunks 2k and 2k + 1
+  __m256i m[2][4];
+
+  for (uint k = 0; k < 2; ++k)
+    for (uint j = 0; j < 4; ++j)
+      m[k][j] = _mm256_loadu2_m128i(
+        reinterpret_cast<const __m128i *>(chunkMasks.masks[2*k + 1][j]),
+        reinterpret_cast<const __m128i *>(chunkMasks.masks[2*k    ][j]));
+
+  for (size_t n = 0; n < num; ++n, cubes += CRubikPerm::SIZE) {
+    const __m128i *c = reinterpret_cast<const __m128i *>(cubes);
+
+    // each source chunk in both lanes
+    __m256i s[4];
+
+    for (uint j = 0; j < 4; ++j)
+      s[j] = _mm256_broadcastsi128_si256(_mm_loadu_si128(c + j));
+
+    for (uint k = 0; k < 2; ++k) {
+      __m256i d = _mm256_or_si256(_mm256_shuffle_epi8(s[0], m[k][0]),
+                                  _mm256_shuffle_epi8(s[1], m[k][1]));
+      __m256i e = _mm256_or_si256(_mm256_shuffle_epi8(s[2], m[k][2]),
+                                  _mm256_shuffle_epi8(s[3], m[k][3]));
+
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(cubes) + k, _mm256_or_si256(d, e));
+    }
+  }
+}
+
+__attribute__((target("avx512f,avx512bw,avx512vbmi")))
+void
+applyAVX512(const CRubikPerm &perm, uint8_t *cubes, size_t num)
+{
+  __m512i m = _mm512_load_si512(perm.p);
+
+  for (size_t n = 0; n < num; ++n, cubes += CRubikPerm::SIZE) {
+    __m512i c = _mm512_loadu_si512(cubes);
+
+    _mm512_storeu_si512(cubes, _mm512_permutexvar_epi8(m, c));
+  }
+}
+#endif
+
+}
+
+//---
+
+CRubikShuffle::Kernel
+CRubikShuffle::
+kernel()
+{
+  if (s_kernel == Kernel::AUTO) {
+    if      (isKernelSupported(Kernel::AVX512)) s_kernel = Kernel::AVX512;
+    else if (isKernelSupported(Kernel::AVX2  )) s_kernel = Kernel::AVX2;
+    else if (isKernelSupported(Kernel::SSSE3 )) s_kernel = Kernel::SSSE3;
+    else                                        s_kernel = Kernel::SCALAR;
+  }
+
+  return s_kernel;
+}
+
+void
+CRubikShuffle::
+setKernel(Kernel kernel)
+{
+  if (kernel != Kernel::AUTO && ! isKernelSupported(kernel))
+    kernel = Kernel::AUTO;
+
+  s_kernel = kernel;
+}
+
+bool
+CRubikShuffle::
+isKernelSupported(Kernel kernel)
+{
+  switch (kernel) {
+    case Kernel::AUTO  :
+    case Kernel::SCALAR: return true;
+#ifdef CRUBIK_SHUFFLE_X86
+    case Kernel::SSSE3 : return __builtin_cpu_supports("ssse3");
+    case Kernel::AVX2  : return __builtin_cpu_supports("avx2");
+    case Kernel::AVX512: return __builtin_cpu_supports("avx512bw") &&
+                                __builtin_cpu_supports("avx512vbmi");
+#endif
+    default: return false;
+  }
+}
+
+const char *
+CRubikShuffle::
+kernelName(Kernel kernel)
+{
+  switch (kernel) {
+    case Kernel::AUTO  : return "auto";
+    case Kernel::SCALAR: return "scalar";
+    case Kernel::SSSE3 : return "ssse3";
+    case Kernel::AVX2  : return "avx2";
+    case Kernel::AVX512: return "avx512";
+    default            : return "";
+  }
+}
+
+void
+CRubikShuffle::
+apply(const CRubikPerm &perm, uint8_t *cubes, size_t num)
+{
+  switch (kernel()) {
+#ifdef CRUBIK_SHUFFLE_X86
+    case Kernel::AVX512: applyAVX512(perm, cubes, num); break;
+    case Kernel::AVX2  : applyAVX2  (perm, cubes, num); break;
+    case Kernel::SSSE3 : applySSSE3 (perm, cubes, num); break;
+#endif
+    default            : applyScalar(perm, cubes, num); break;
+  }
+}
+
+void
+CRubikShuffle::
+apply(const std::vector<uint> &moves, uint8_t *cubes, size_t num)
+{
+  CRubikPerm perm;
+
+  perm.addMoves(moves);
+
+  apply(perm, cubes, num);
+}
+
+bool
+CRubikShuffle::
+apply(const std::string &moveStr, uint8_t *cubes, size_t num)
+{
+  std::vector<uint> moves;
+
+  if (! CRubikMove::parse(moveStr, moves))
+    return false;
+
+  apply(moves, cubes, num);
+
+  return true;
+}
+
+void
+CRubikShuffle::
+reset(uint8_t *cubes, size_t num)
+{
+  CRubikPerm perm;
+
+  for (size_t n = 0; n < num; ++n, cubes += CRubikPerm::SIZE)
+    memcpy(cubes, perm.p, CRubikPerm::SIZE);
+}
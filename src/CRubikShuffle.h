@@ -0,0 +1,48 @@
+#ifndef CRUBIK_SHUFFLE_H
+#define CRUBIK_SHUFFLE_H
+
+#include <CRubikPerm.h>
+#include <cstddef>
+#include <string>
+
+// Batch application of facelet permutations using byte shuffles.
+//
+// Cubes are stored as consecutive 64 byte facelet vectors (CRubikPerm::SIZE), the
+// first 54 bytes hold the facelets (side*9 + col*3 + row). A move sequence is first
+// composed into a single permutation and then applied to every cube with one shuffle
+// (vpermb for AVX-512 VBMI, pshufb for AVX2/SSSE3, or a scalar gather).
+//
+// The kernel is picked at run time from the CPU features but can be overridden.
+class CRubikShuffle {
+ public:
+  enum class Kernel {
+    AUTO,
+    SCALAR,
+    SSSE3,
+    AVX2,
+    AVX512
+  };
+
+ public:
+  static Kernel kernel();
+
+  static void setKernel(Kernel kernel);
+
+  static bool isKernelSupported(Kernel kernel);
+
+  static const char *kernelName(Kernel kernel);
+
+  // apply permutation to num cubes
+  static void apply(const CRubikPerm &perm, uint8_t *cubes, size_t num);
+
+  // apply moves to num cubes
+  static void apply(const std::vector<uint> &moves, uint8_t *cubes, size_t num);
+
+  // apply move string (see CRubikMove::parse) to num cubes
+  static bool apply(const std::string &moveStr, uint8_t *cubes, size_t num);
+
+  // set num cubes to the solved state
+  static void reset(uint8_t *cubes, size_t num);
+};
+
+#endif
@@ -0,0 +1,455 @@
+#include <CRubikModel.h>
+#include <CRubikScramble.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+
+// Batch solver.
+//
+// Reads one cube per line, as a 54 character facelet string (see
+// CRubikModel::setFaceletString) or a scramble (move string), from stdin or files,
+// solves them on a pool of threads (each with its own model) and writes one line per
+// input, in input order, as soon as it and all earlier lines are done :
+//
+//   <solution moves> TAB <number of moves> TAB <solve time (ms)>
+//
+// or "error" TAB <message>. Each solution is checked by applying it to the start state.
+//
+// With -scramble <n> it instead writes n random state scrambles (see CRubikScramble),
+// one per line, which can be read back as input.
+//
+// With -check it checks the facelet strings of some single turns against their standard
+// (Singmaster notation) strings and that the R state string is solved by R' (any
+// solution for -layer).
+class CRubikSolve {
+ public:
+  CRubikSolve() { }
+
+  void setMethod(CRubikModel::SolveMethod method) { method_ = method; }
+
+  void setNumThreads(uint n) { numThreads_ = std::max(n, 1u); }
+
+  void setOptimalDepth(uint depth) { optimalDepth_ = depth; }
+
+  void setTimeout(uint timeout) { timeout_ = timeout; }
+
+  void setTablesFile(const std::string &file) { tablesFile_ = file; }
+
+  bool isFailed() const { return numFailed_ > 0; }
+
+  void run(std::istream &is);
+
+  bool check();
+
+ private:
+  struct Job {
+    uint64_t    ind { 0 };
+    std::string line;
+  };
+
+  void runWorker();
+
+  void runWriter();
+
+  std::string solveLine(CRubikModel &model, const std::string &line);
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  CRubikModel::SolveMethod method_       { CRubikModel::SolveMethod::TWO_PHASE };
+  uint                     numThreads_   { std::max(std::thread::hardware_concurrency(), 1u) };
+  uint                     optimalDepth_ { CRubikOptimal::MAX_DEPTH };
+  uint                     timeout_      { 1000 };
+  std::string              tablesFile_;
+
+  std::mutex                      mutex_;
+  std::condition_variable         jobCond_;
+  std::condition_variable         resultCond_;
+  std::deque<Job>                 jobs_;
+  std::map<uint64_t, std::string> results_;
+  uint64_t                        numRead_    { 0 };
+  uint64_t                        numWritten_ { 0 };
+  bool                            eof_        { false };
+  uint64_t                        numFailed_  { 0 };
+};
+
+void
+CRubikSolve::
+run(std::istream &is)
+{
+  {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  eof_ = false;
+  }
+
+  // build optimal solver tables once (workers then map the saved file)
+  if (method_ == CRubikModel::SolveMethod::OPTIMAL) {
+    CRubikOptimal optimal;
+
+    if (! tablesFile_.empty())
+      optimal.setFileName(tablesFile_);
+
+    if (! optimal.init()) {
+      std::cerr << "Failed to load optimal solver tables" << std::endl;
+      exit(1);
+    }
+  }
+
+  // build shared two phase tables once (so solve times don't include them)
+  if (method_ == CRubikModel::SolveMethod::TWO_PHASE)
+    CRubikKociemba::init();
+
+  std::vector<std::thread> workers;
+
+  for (uint i = 0; i < numThreads_; ++i)
+    workers.emplace_back(&CRubikSolve::runWorker, this);
+
+  std::thread writer(&CRubikSolve::runWriter, this);
+
+  // limit lines read ahead of the output
+  uint64_t maxPending = 64*uint64_t(numThreads_);
+
+  std::string line;
+
+  while (std::getline(is, line)) {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    resultCond_.wait(lock, [&]() { return numRead_ - numWritten_ < maxPending; });
+
+    Job job;
+
+    job.ind  = numRead_++;
+    job.line = line;
+
+    jobs_.push_back(job);
+
+    jobCond_.notify_one();
+  }
+
+  {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  eof_ = true;
+  }
+
+  jobCond_   .notify_all();
+  resultCond_.notify_all();
+
+  for (auto &worker : workers)
+    worker.join();
+
+  writer.join();
+}
+
+void
+CRubikSolve::
+runWorker()
+{
+  CRubikModel model;
+
+  model.setSolveMethod(method_);
+  model.setOptimalDepth(optimalDepth_);
+
+  model.getKociemba().setTimeout(timeout_);
+
+  // pool supplies the parallelism
+  model.getOptimal().setNumThreads(1);
+
+  if (! tablesFile_.empty())
+    model.getOptimal().setFileName(tablesFile_);
+
+  for (;;) {
+    Job job;
+
+    {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    jobCond_.wait(lock, [&]() { return ! jobs_.empty() || eof_; });
+
+    if (jobs_.empty())
+      return;
+
+    job = jobs_.front();
+
+    jobs_.pop_front();
+    }
+
+    std::string result = solveLine(model, job.line);
+
+    {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    results_[job.ind] = result;
+    }
+
+    resultCond_.notify_all();
+  }
+}
+
+void
+CRubikSolve::
+runWriter()
+{
+  for (;;) {
+    std::string result;
+
+    {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    resultCond_.wait(lock, [&]() {
+      return results_.find(numWritten_) != results_.end() || (eof_ && numWritten_ == numRead_);
+    });
+
+    auto p = results_.find(numWritten_);
+
+    if (p == results_.end())
+      return;
+
+    result = (*p).second;
+
+    results_.erase(p);
+    }
+
+    std::cout << result << "\n";
+
+    // flush when caught up so results stream
+    {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    ++numWritten_;
+
+    if (results_.find(numWritten_) == results_.end())
+      std::cout.flush();
+    }
+
+    resultCond_.notify_all();
+  }
+}
+
+std::string
+CRubikSolve::
+solveLine(CRubikModel &model, const std::string &line)
+{
+  CRubikCubie start;
+
+  if (line.size() == CRubikCubie::NUM_FACELETS &&
+      line.find_first_not_of("URFDLB") == std::string::npos) {
+    if (! model.setFaceletString(line) || ! model.getCubie(start)) {
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      ++numFailed_;
+
+      return "error\tinvalid state";
+    }
+  }
+  else {
+    std::vector<uint> scramble;
+
+    if (! CRubikMove::parse(line, scramble)) {
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      ++numFailed_;
+
+      return "error\tinvalid moves";
+    }
+
+    model.reset();
+
+    for (const auto &move : scramble) {
+      model.applyMove(move);
+
+      start.multiply(CRubikMove::cubie(move));
+    }
+  }
+
+  auto t1 = Clock::now();
+
+  std::vector<uint> moves;
+
+  bool rc = model.solve(moves);
+
+  auto t2 = Clock::now();
+
+  // check solution
+  CRubikCubie cubie = start;
+
+  for (const auto &move : moves)
+    cubie.multiply(CRubikMove::cubie(move));
+
+  if (! rc || ! cubie.isSolved()) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    ++numFailed_;
+
+    return (rc ? "error\tinvalid solution" : "error\tno solution");
+  }
+
+  double ms = std::chrono::duration<double, std::milli>(t2 - t1).count();
+
+  char buffer[32];
+
+  snprintf(buffer, sizeof(buffer), "%.3f", ms);
+
+  return CRubikMove::names(moves) + "\t" + std::to_string(moves.size()) + "\t" + buffer;
+}
+
+bool
+CRubikSolve::
+check()
+{
+  // standard facelet strings of single turns from solved
+  static const char *turnStrings[][2] = {
+    { "R" , "UUFUUFUUFRRRRRRRRRFFDFFDFFDDDBDDBDDBLLLLLLLLLUBBUBBUBB" },
+    { "R'", "UUBUUBUUBRRRRRRRRRFFUFFUFFUDDFDDFDDFLLLLLLLLLDBBDBBDBB" },
+    { "U" , "UUUUUUUUUBBBRRRRRRRRRFFFFFFDDDDDDDDDFFFLLLLLLLLLBBBBBB" },
+    { "F" , "UUUUUULLLURRURRURRFFFFFFFFFRRRDDDDDDLLDLLDLLDBBBBBBBBB" },
+  };
+
+  bool rc = true;
+
+  CRubikModel model;
+
+  for (const auto &turnString : turnStrings) {
+    model.reset();
+
+    model.execute(turnString[0]);
+
+    std::string str = model.getFaceletString();
+
+    if (str != turnString[1]) {
+      std::cerr << turnString[0] << " : got " << str << std::endl;
+      rc = false;
+    }
+
+    // read back
+    if (! model.setFaceletString(turnString[1]) ||
+        model.getFaceletString() != turnString[1]) {
+      std::cerr << turnString[0] << " : read failed" << std::endl;
+      rc = false;
+    }
+  }
+
+  // solve R state
+  model.setSolveMethod(method_);
+  model.setOptimalDepth(optimalDepth_);
+
+  if (! tablesFile_.empty())
+    model.getOptimal().setFileName(tablesFile_);
+
+  std::string result = solveLine(model, turnStrings[0][1]);
+
+  bool solved = (result.compare(0, 6, "error\t") != 0);
+
+  if (! solved || (method_ != CRubikModel::SolveMethod::LAYER &&
+                   result.compare(0, 3, "R'\t") != 0)) {
+    std::cerr << "solve R : got " << result << std::endl;
+    rc = false;
+  }
+
+  return rc;
+}
+
+//---
+
+static void
+usage()
+{
+  std::cerr << "Usage: cqrubik-solve [-layer|-two_phase|-optimal] [-threads <n>] "
+               "[-depth <n>] [-timeout <ms>] [-tables <file>] [files]" << std::endl;
+  std::cerr << "       cqrubik-solve -scramble <n> [-seed <n>] [-length <n>] "
+               "[-threads <n>]" << std::endl;
+  std::cerr << "       cqrubik-solve -check" << std::endl;
+}
+
+int
+main(int argc, char **argv)
+{
+  CRubikSolve solve;
+
+  std::vector<std::string> files;
+
+  bool     check          = false;
+  size_t   numScrambles   = 0;
+  uint64_t scrambleSeed   = std::random_device()();
+  uint     scrambleLength = 22;
+  uint     numThreads     = std::max(std::thread::hardware_concurrency(), 1u);
+
+  for (int i = 1; i < argc; ++i) {
+    if (argv[i][0] == '-' && argv[i][1] != '\0') {
+      std::string arg(&argv[i][1]);
+
+      if      (arg == "layer")
+        solve.setMethod(CRubikModel::SolveMethod::LAYER);
+      else if (arg == "two_phase")
+        solve.setMethod(CRubikModel::SolveMethod::TWO_PHASE);
+      else if (arg == "optimal")
+        solve.setMethod(CRubikModel::SolveMethod::OPTIMAL);
+      else if (arg == "threads" && i < argc - 1) {
+        numThreads = uint(atoi(argv[++i]));
+
+        solve.setNumThreads(numThreads);
+      }
+      else if (arg == "depth" && i < argc - 1)
+        solve.setOptimalDepth(uint(atoi(argv[++i])));
+      else if (arg == "timeout" && i < argc - 1)
+        solve.setTimeout(uint(atoi(argv[++i])));
+      else if (arg == "tables" && i < argc - 1)
+        solve.setTablesFile(argv[++i]);
+      else if (arg == "scramble" && i < argc - 1)
+        numScrambles = size_t(atoll(argv[++i]));
+      else if (arg == "seed" && i < argc - 1)
+        scrambleSeed = uint64_t(strtoull(argv[++i], nullptr, 10));
+      else if (arg == "length" && i < argc - 1)
+        scrambleLength = uint(atoi(argv[++i]));
+      else if (arg == "check")
+        check = true;
+      else {
+        usage();
+        exit(1);
+      }
+    }
+    else
+      files.push_back(argv[i]);
+  }
+
+  if (check)
+    return (solve.check() ? 0 : 1);
+
+  if (numScrambles > 0) {
+    std::vector<std::string> scrambles;
+
+    if (! CRubikScramble::generate(scrambleSeed, numScrambles, numThreads,
+                                   scrambleLength, scrambles)) {
+      std::cerr << "Failed to generate scrambles" << std::endl;
+      exit(1);
+    }
+
+    for (const auto &scramble : scrambles)
+      std::cout << scramble << "\n";
+
+    return 0;
+  }
+
+  if (files.empty())
+    solve.run(std::cin);
+
+  for (const auto &file : files) {
+    std::ifstream is(file);
+
+    if (! is) {
+      std::cerr << "Failed to open " << file << std::endl;
+      exit(1);
+    }
+
+    solve.run(is);
+  }
+
+  return (solve.isFailed() ? 1 : 0);
+}
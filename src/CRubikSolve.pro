@@ -0,0 +1,29 @@
+TEMPLATE = app
+
+TARGET = cqrubik-solve
+
+CONFIG += console thread
+CONFIG -= qt
+
+QMAKE_CXXFLAGS += -std=c++17
+
+#CONFIG += debug
+
+# Input
+SOURCES += \
+CRubikSolve.cpp \
+
+DESTDIR     = ../bin
+OBJECTS_DIR = ../obj
+LIB_DIR     = ../lib
+
+INCLUDEPATH += \
+../include \
+.
+
+PRE_TARGETDEPS = \
+$$LIB_DIR/libCRubikModel.a
+
+unix:LIBS += \
+-L$$LIB_DIR \
+-lCRubikModel -lpthread
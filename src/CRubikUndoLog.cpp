@@ -0,0 +1,267 @@
+#include <CRubikUndoLog.h>
+#include <algorithm>
+
+CRubikUndoLog::
+CRubikUndoLog(size_t maxMoves)
+{
+  // solved cube
+  uint8_t facelets[NUM_FACELETS];
+
+  for (uint i = 0; i < NUM_FACELETS; ++i)
+    facelets[i] = uint8_t(i);
+
+  clear(facelets);
+
+  setMaxMoves(maxMoves);
+}
+
+void
+CRubikUndoLog::
+setMaxMoves(size_t n)
+{
+  maxMoves_ = std::max(n, size_t(1));
+
+  if (size_ > maxMoves_) {
+    // can't keep moves which could be redone
+    truncate();
+
+    while (size_ > maxMoves_)
+      dropGroup();
+  }
+
+  if (buffer_.size() > maxMoves_)
+    resize(maxMoves_);
+}
+
+void
+CRubikUndoLog::
+clear(const uint8_t *facelets)
+{
+  std::vector<uint8_t>().swap(buffer_);
+
+  start_  = 0;
+  size_   = 0;
+  pos_    = 0;
+  offset_ = 0;
+
+  newGroup_ = inGroup();
+
+  memcpy(startState_, facelets, NUM_FACELETS);
+  memcpy(state_     , facelets, NUM_FACELETS);
+
+  checkpoints_.clear();
+
+  firstCheckpoint_ = 0;
+}
+
+void
+CRubikUndoLog::
+addMove(uint move)
+{
+  truncate();
+
+  while (size_ >= maxMoves_)
+    dropGroup();
+
+  if (size_ == buffer_.size())
+    resize(std::min(std::max(2*size_, size_t(64)), maxMoves_));
+
+  uint8_t c = uint8_t(move & MOVE_MASK);
+
+  if (! inGroup() || newGroup_)
+    c |= GROUP_START;
+
+  newGroup_ = false;
+
+  at(size_) = c;
+
+  pos_ = ++size_;
+
+  CRubikMove::apply(move, state_);
+
+  if ((offset_ + size_) % CHECKPOINT_MOVES == 0) {
+    if (checkpoints_.empty())
+      firstCheckpoint_ = (offset_ + size_)/CHECKPOINT_MOVES;
+
+    checkpoints_.emplace_back(state_);
+  }
+}
+
+void
+CRubikUndoLog::
+startGroup()
+{
+  if (groupDepth_++ == 0)
+    newGroup_ = true;
+}
+
+void
+CRubikUndoLog::
+endGroup()
+{
+  if (groupDepth_ > 0 && --groupDepth_ == 0)
+    newGroup_ = false;
+}
+
+bool
+CRubikUndoLog::
+undo(std::vector<uint> &moves)
+{
+  moves.clear();
+
+  if (! canUndo())
+    return false;
+
+  size_t i = pos_;
+
+  do {
+    --i;
+
+    moves.push_back(CRubikMove::inverse(move(i)));
+  } while (i > 0 && ! (at(i) & GROUP_START));
+
+  pos_ = i;
+
+  for (const auto &move : moves)
+    CRubikMove::apply(move, state_);
+
+  return true;
+}
+
+bool
+CRubikUndoLog::
+redo(std::vector<uint> &moves)
+{
+  moves.clear();
+
+  if (! canRedo())
+    return false;
+
+  size_t i = pos_;
+
+  do {
+    moves.push_back(move(i));
+
+    ++i;
+  } while (i < size_ && ! (at(i) & GROUP_START));
+
+  pos_ = i;
+
+  for (const auto &move : moves)
+    CRubikMove::apply(move, state_);
+
+  return true;
+}
+
+bool
+CRubikUndoLog::
+getState(size_t i, uint8_t *facelets) const
+{
+  if (i > size_)
+    return false;
+
+  if (i == pos_) {
+    memcpy(facelets, state_, NUM_FACELETS);
+    return true;
+  }
+
+  // start from last checkpoint at or before i (or start state)
+  const uint8_t *facelets1 = startState_;
+
+  size_t j = 0;
+
+  if (! checkpoints_.empty() && offset_ + i >= checkpointIndex(0)) {
+    size_t c = std::min((offset_ + i - checkpointIndex(0))/CHECKPOINT_MOVES,
+                        checkpoints_.size() - 1);
+
+    facelets1 = checkpoints_[c].facelets;
+
+    j = checkpointIndex(c) - offset_;
+  }
+
+  memcpy(facelets, facelets1, NUM_FACELETS);
+
+  for ( ; j < i; ++j)
+    CRubikMove::apply(move(j), facelets);
+
+  return true;
+}
+
+bool
+CRubikUndoLog::
+seek(size_t i)
+{
+  if (i > size_)
+    return false;
+
+  if (i != pos_) {
+    uint8_t facelets[NUM_FACELETS];
+
+    getState(i, facelets);
+
+    memcpy(state_, facelets, NUM_FACELETS);
+
+    pos_ = i;
+  }
+
+  return true;
+}
+
+// discard moves (and checkpoints) after current position
+void
+CRubikUndoLog::
+truncate()
+{
+  size_ = pos_;
+
+  while (! checkpoints_.empty() &&
+         checkpointIndex(checkpoints_.size() - 1) > offset_ + size_)
+    checkpoints_.pop_back();
+}
+
+// reallocate buffer of n bytes with moves starting at index 0
+void
+CRubikUndoLog::
+resize(size_t n)
+{
+  std::vector<uint8_t> buffer(n);
+
+  for (size_t i = 0; i < size_; ++i)
+    buffer[i] = at(i);
+
+  buffer_.swap(buffer);
+
+  start_ = 0;
+}
+
+// drop oldest group
+void
+CRubikUndoLog::
+dropGroup()
+{
+  if (size_ == 0)
+    return;
+
+  size_t n = 1;
+
+  while (n < size_ && ! (at(n) & GROUP_START))
+    ++n;
+
+  for (size_t i = 0; i < n; ++i)
+    CRubikMove::apply(move(i), startState_);
+
+  start_ += n;
+
+  if (start_ >= buffer_.size())
+    start_ -= buffer_.size();
+
+  size_   -= n;
+  pos_    -= std::min(pos_, n);
+  offset_ += n;
+
+  while (! checkpoints_.empty() && checkpointIndex(0) < offset_) {
+    checkpoints_.pop_front();
+
+    ++firstCheckpoint_;
+  }
+}
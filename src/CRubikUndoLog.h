@@ -0,0 +1,120 @@
+#ifndef CRUBIK_UNDO_LOG_H
+#define CRUBIK_UNDO_LOG_H
+
+#include <CRubikMove.h>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+// Undo journal of cube moves.
+//
+// Each move is stored as one byte (its CRubikMove id) in a ring buffer which doubles in
+// size as needed up to maxMoves, after that the oldest groups are dropped. The top bit
+// of a byte marks the first move of a group so each group is the index range from its
+// first move to the next marked move. Undo and redo return the move ids (inverses in
+// reverse order for undo) of a whole group to be applied in one go.
+//
+// Moves after the current position can be redone until a new move is added.
+//
+// The facelets (CRubikModel::getFacelets) of the start state are kept along with a
+// checkpoint copy every CHECKPOINT_MOVES moves so the state at any index is rebuilt
+// from the nearest earlier checkpoint plus fewer than CHECKPOINT_MOVES moves.
+class CRubikUndoLog {
+ public:
+  enum { DEFAULT_MAX_MOVES = 1 << 20 };
+  enum { CHECKPOINT_MOVES  = 64 };
+  enum { NUM_FACELETS      = CRubikMove::NUM_FACELETS };
+
+ public:
+  explicit CRubikUndoLog(size_t maxMoves=DEFAULT_MAX_MOVES);
+
+  size_t maxMoves() const { return maxMoves_; }
+  void setMaxMoves(size_t n);
+
+  // number of moves stored and number of those applied (current position)
+  size_t size() const { return size_; }
+  size_t pos () const { return pos_ ; }
+
+  bool canUndo() const { return pos_ > 0; }
+  bool canRedo() const { return pos_ < size_; }
+
+  // move at index (< size)
+  uint move(size_t i) const { return at(i) & MOVE_MASK; }
+
+  // remove all moves, facelets is the current state
+  void clear(const uint8_t *facelets);
+
+  // add move at current position (discarding moves which could be redone)
+  void addMove(uint move);
+
+  // moves added between start and end are one group (groups can be nested)
+  void startGroup();
+  void endGroup();
+
+  bool inGroup() const { return groupDepth_ > 0; }
+
+  // set moves to apply to undo last (or redo next) group and update position
+  bool undo(std::vector<uint> &moves);
+  bool redo(std::vector<uint> &moves);
+
+  // get facelets of state after first i moves (i <= size)
+  bool getState(size_t i, uint8_t *facelets) const;
+
+  // facelets of state at current position
+  const uint8_t *state() const { return state_; }
+
+  // set current position (i <= size)
+  bool seek(size_t i);
+
+  size_t numCheckpoints() const { return checkpoints_.size(); }
+
+  // bytes allocated
+  size_t memUsage() const {
+    return buffer_.capacity() + checkpoints_.size()*sizeof(Checkpoint);
+  }
+
+ private:
+  enum { GROUP_START = 0x80, MOVE_MASK = 0x7F };
+
+  struct Checkpoint {
+    uint8_t facelets[NUM_FACELETS];
+
+    Checkpoint(const uint8_t *f) { memcpy(facelets, f, NUM_FACELETS); }
+  };
+
+  uint8_t at(size_t i) const {
+    size_t j = start_ + i; if (j >= buffer_.size()) j -= buffer_.size(); return buffer_[j];
+  }
+
+  uint8_t &at(size_t i) {
+    size_t j = start_ + i; if (j >= buffer_.size()) j -= buffer_.size(); return buffer_[j];
+  }
+
+  void resize(size_t n);
+
+  void truncate();
+
+  void dropGroup();
+
+  // number of moves since clear of checkpoint i
+  size_t checkpointIndex(size_t i) const {
+    return (firstCheckpoint_ + i)*CHECKPOINT_MOVES;
+  }
+
+ private:
+  std::vector<uint8_t>   buffer_;
+  size_t                 maxMoves_        { DEFAULT_MAX_MOVES };
+  size_t                 start_           { 0 };
+  size_t                 size_            { 0 };
+  size_t                 pos_             { 0 };
+  uint                   groupDepth_      { 0 };
+  bool                   newGroup_        { false };
+  size_t                 offset_          { 0 };
+  uint8_t                startState_[NUM_FACELETS];
+  uint8_t                state_     [NUM_FACELETS];
+  std::deque<Checkpoint> checkpoints_;
+  size_t                 firstCheckpoint_ { 0 };
+};
+
+#endif